@@ -0,0 +1,399 @@
+//! Criterion benchmarks for the evaluation engine, one group per subsystem.
+//!
+//! Every group runs on the schemas in `tests/fixtures`:
+//! - `minimal_form.json` (with the sample payloads from `tests/common`) for
+//!   parsing, evaluation, dependents, validation, layout and getters
+//! - `rate_table_form.json` for `$table` rows and the `array_lookup` operators
+//! - `rider_subform_form.json` for subform items
+//!
+//! Run with `cargo bench --bench engine`; save a baseline with
+//! `-- --save-baseline <name>` and compare against it with `-- --baseline <name>`.
+
+#[path = "../tests/common/mod.rs"]
+mod common;
+
+use criterion::{criterion_group, criterion_main, BatchSize, Criterion, Throughput};
+use indexmap::IndexMap;
+use json_eval_rs::jsoneval::json_parser;
+use json_eval_rs::jsoneval::output_cache::OutputKind;
+use json_eval_rs::topo_sort::topological_sort_parsed;
+use json_eval_rs::{
+    JSONEval, ParsedSchema, RLogic, ReturnFormat, JSON_EVAL_POOL, PARSED_SCHEMA_CACHE,
+};
+use serde_json::{json, Value};
+use std::fs;
+use std::hint::black_box;
+use std::sync::Arc;
+
+/// Riders in the subform payload
+const RIDERS: usize = 32;
+
+fn fixture(name: &str) -> String {
+    let path = format!("{}/tests/fixtures/{}", env!("CARGO_MANIFEST_DIR"), name);
+    fs::read_to_string(&path).unwrap_or_else(|e| panic!("failed to read {}: {}", path, e))
+}
+
+/// The `minimal_form.json` sample payloads, as JSON text
+fn form_payloads() -> Vec<String> {
+    vec![
+        common::get_minimal_form_data().to_string(),
+        common::get_premium_coverage_data().to_string(),
+        common::get_custom_coverage_data().to_string(),
+    ]
+}
+
+fn rate_payload(age: u64) -> String {
+    json!({ "age": age, "gender": "F", "sum_assured": 100000 }).to_string()
+}
+
+fn rider_payload(offset: i64) -> String {
+    let riders: Vec<Value> = (0..RIDERS as i64)
+        .map(|i| json!({ "sa": i * 10 + offset }))
+        .collect();
+    json!({ "riders": riders }).to_string()
+}
+
+fn parsed_form() -> Arc<ParsedSchema> {
+    Arc::new(ParsedSchema::parse(&common::load_minimal_form_schema()).unwrap())
+}
+
+/// An instance of the minimal form evaluated with its first sample payload
+fn evaluated_form() -> JSONEval {
+    let payload = common::get_minimal_form_data().to_string();
+    let mut eval = JSONEval::with_parsed_schema(parsed_form(), None, Some(&payload)).unwrap();
+    eval.evaluate(&payload, None, None, None).unwrap();
+    eval
+}
+
+fn bench_json_parser(c: &mut Criterion) {
+    let schema = common::load_minimal_form_schema();
+    let payload = common::get_minimal_form_data().to_string();
+
+    let mut group = c.benchmark_group("json_parser");
+    for (name, text) in [("schema", &schema), ("payload", &payload)] {
+        group.throughput(Throughput::Bytes(text.len() as u64));
+        group.bench_function(format!("parse_json_str/{}", name), |b| {
+            b.iter(|| json_parser::parse_json_str(black_box(text)).unwrap())
+        });
+        group.bench_function(format!("serde_json/{}", name), |b| {
+            b.iter(|| serde_json::from_str::<Value>(black_box(text)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_schema_parse(c: &mut Criterion) {
+    let schema = common::load_minimal_form_schema();
+    let schema_msgpack =
+        rmp_serde::to_vec(&serde_json::from_str::<Value>(&schema).unwrap()).unwrap();
+    let parsed = parsed_form();
+
+    let mut group = c.benchmark_group("schema_parse");
+    group.bench_function("ParsedSchema::parse", |b| {
+        b.iter(|| ParsedSchema::parse(black_box(&schema)).unwrap())
+    });
+    group.bench_function("ParsedSchema::parse_msgpack", |b| {
+        b.iter(|| ParsedSchema::parse_msgpack(black_box(&schema_msgpack)).unwrap())
+    });
+    group.bench_function("JSONEval::new", |b| {
+        b.iter(|| JSONEval::new(black_box(&schema), None, None).unwrap())
+    });
+    group.bench_function("JSONEval::with_parsed_schema", |b| {
+        b.iter(|| JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap())
+    });
+
+    let key = "bench-minimal-form";
+    PARSED_SCHEMA_CACHE.insert(key.to_string(), Arc::clone(&parsed));
+    group.bench_function("JSON_EVAL_POOL::acquire_release", |b| {
+        b.iter(|| {
+            let eval = JSON_EVAL_POOL.acquire(key, None, None).unwrap();
+            JSON_EVAL_POOL.release(key, eval);
+        })
+    });
+    group.finish();
+}
+
+fn bench_topo_sort(c: &mut Criterion) {
+    let parsed = parsed_form();
+
+    let mut group = c.benchmark_group("topo_sort");
+    group.bench_function("minimal_form", |b| {
+        b.iter(|| topological_sort_parsed(black_box(&parsed)).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_evaluate(c: &mut Criterion) {
+    let parsed = parsed_form();
+    let payloads = form_payloads();
+
+    let mut group = c.benchmark_group("evaluate");
+    group.bench_function("fresh_instance", |b| {
+        b.iter_batched(
+            || JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap(),
+            |mut eval| eval.evaluate(&payloads[0], None, None, None).unwrap(),
+            BatchSize::SmallInput,
+        )
+    });
+    group.bench_function("changed_payload", |b| {
+        let mut eval = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap();
+        let mut next = payloads.iter().cycle();
+        b.iter(|| {
+            eval.evaluate(next.next().unwrap(), None, None, None)
+                .unwrap()
+        })
+    });
+    group.bench_function("unchanged_payload", |b| {
+        let mut eval = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap();
+        b.iter(|| eval.evaluate(&payloads[0], None, None, None).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_evaluate_dependents(c: &mut Criterion) {
+    let edits: Vec<(String, Vec<String>)> = [
+        ("insured/properties/is_smoker", json!(true), json!(false)),
+        (
+            "insured/properties/occupation",
+            json!("MANUAL"),
+            json!("OFFICE"),
+        ),
+        (
+            "policy_container/properties/has_additional_coverage",
+            json!(true),
+            json!(false),
+        ),
+    ]
+    .into_iter()
+    .map(|(field, on, off)| {
+        let data_path = format!("/illustration/{}", field.replace("/properties", ""));
+        let payloads = [on, off]
+            .into_iter()
+            .map(|value| {
+                let mut data = common::get_minimal_form_data();
+                *data.pointer_mut(&data_path).unwrap() = value;
+                data.to_string()
+            })
+            .collect();
+        (format!("#/illustration/properties/{}", field), payloads)
+    })
+    .collect();
+
+    let mut group = c.benchmark_group("evaluate_dependents");
+    for (changed_path, payloads) in &edits {
+        let name = changed_path.rsplit('/').next().unwrap();
+        group.bench_function(name, |b| {
+            let mut eval = evaluated_form();
+            let changed = [changed_path.clone()];
+            let mut next = payloads.iter().cycle();
+            b.iter(|| {
+                eval.evaluate_dependents(
+                    &changed,
+                    Some(next.next().unwrap()),
+                    None,
+                    true,
+                    None,
+                    None,
+                    false,
+                )
+                .unwrap()
+            })
+        });
+    }
+    group.finish();
+}
+
+fn bench_tables(c: &mut Criterion) {
+    let parsed = Arc::new(ParsedSchema::parse(&fixture("rate_table_form.json")).unwrap());
+    let payloads: Vec<String> = [25, 41, 67].into_iter().map(rate_payload).collect();
+
+    let mut group = c.benchmark_group("tables");
+    group.bench_function("fresh_instance", |b| {
+        b.iter_batched(
+            || JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap(),
+            |mut eval| eval.evaluate(&payloads[0], None, None, None).unwrap(),
+            BatchSize::SmallInput,
+        )
+    });
+    group.bench_function("changed_inputs", |b| {
+        let mut eval = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap();
+        let mut next = payloads.iter().cycle();
+        b.iter(|| {
+            eval.evaluate(next.next().unwrap(), None, None, None)
+                .unwrap()
+        })
+    });
+    group.finish();
+}
+
+fn bench_array_lookup(c: &mut Criterion) {
+    let schema: Value = serde_json::from_str(&fixture("rate_table_form.json")).unwrap();
+    let rates = schema.pointer("/$params/rates").unwrap().clone();
+
+    // The same rows as a static array (columnar lookups) and as plain data (row scan)
+    let mut columnar = RLogic::new();
+    let mut arrays = IndexMap::new();
+    arrays.insert("/$params/rates".to_string(), Arc::new(rates.clone()));
+    columnar.set_static_arrays(Arc::new(arrays));
+    let mut row_scan = RLogic::new();
+    let plain_data = json!({ "$params": { "rates": rates } });
+    let static_data = json!({});
+
+    let cases = [
+        (
+            "MATCH",
+            json!({"MATCH": [{"var": "$params.rates"}, "F", "GENDER", 30, "MIN_AGE"]}),
+        ),
+        (
+            "MATCHRANGE",
+            json!({"MATCHRANGE": [{"var": "$params.rates"}, "MIN_AGE", "MAX_AGE", 41]}),
+        ),
+        (
+            "INDEXAT",
+            json!({"INDEXAT": ["44", {"var": "$params.rates"}, "MIN_AGE"]}),
+        ),
+        (
+            "CHOOSE",
+            json!({"CHOOSE": [{"var": "$params.rates"}, "Z", "GENDER", "105", "CODE"]}),
+        ),
+        (
+            "VALUEAT",
+            json!({"VALUEAT": [
+                {"var": "$params.rates"},
+                {"MATCHRANGE": [{"var": "$params.rates"}, "MIN_AGE", "MAX_AGE", 41]},
+                "RATE"
+            ]}),
+        ),
+    ];
+
+    let mut group = c.benchmark_group("array_lookup");
+    for (name, logic) in &cases {
+        let columnar_id = columnar.compile(logic).unwrap();
+        let row_scan_id = row_scan.compile(logic).unwrap();
+        group.bench_function(format!("{}/columnar", name), |b| {
+            b.iter(|| columnar.run(&columnar_id, black_box(&static_data)).unwrap())
+        });
+        group.bench_function(format!("{}/row_scan", name), |b| {
+            b.iter(|| row_scan.run(&row_scan_id, black_box(&plain_data)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn bench_validation(c: &mut Criterion) {
+    let payloads = form_payloads();
+
+    let mut group = c.benchmark_group("validation");
+    group.bench_function("changed_payload", |b| {
+        let mut eval = evaluated_form();
+        let mut next = payloads.iter().cycle();
+        b.iter(|| {
+            eval.validate(next.next().unwrap(), None, None, None)
+                .unwrap()
+        })
+    });
+    group.bench_function("unchanged_payload", |b| {
+        let mut eval = evaluated_form();
+        b.iter(|| eval.validate(&payloads[0], None, None, None).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_layout(c: &mut Criterion) {
+    let evaluated = evaluated_form();
+
+    let mut group = c.benchmark_group("layout");
+    group.bench_function("resolve_full", |b| {
+        b.iter_batched(
+            || evaluated.clone(),
+            |mut eval| eval.resolve_layout(false).unwrap(),
+            BatchSize::SmallInput,
+        )
+    });
+    group.bench_function("resolve_unchanged", |b| {
+        let mut eval = evaluated.clone();
+        b.iter(|| eval.resolve_layout(false).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_getters(c: &mut Criterion) {
+    let mut eval = evaluated_form();
+    let paths = vec![
+        "illustration.insured.age".to_string(),
+        "illustration.policy_container.coverage_details".to_string(),
+    ];
+
+    let mut group = c.benchmark_group("getters");
+    group.bench_function("get_evaluated_schema", |b| {
+        b.iter(|| eval.get_evaluated_schema())
+    });
+    group.bench_function("get_evaluated_schema_json", |b| {
+        b.iter(|| eval.get_evaluated_schema_json(false).unwrap())
+    });
+    group.bench_function("get_evaluated_schema_msgpack", |b| {
+        b.iter(|| eval.get_evaluated_schema_msgpack().unwrap())
+    });
+    group.bench_function("get_evaluated_schema_resolved", |b| {
+        b.iter(|| eval.get_evaluated_schema_resolved())
+    });
+    group.bench_function("get_schema_value", |b| b.iter(|| eval.get_schema_value()));
+    group.bench_function("get_evaluated_schema_by_paths", |b| {
+        b.iter(|| eval.get_evaluated_schema_by_paths(&paths, Some(ReturnFormat::Flat)))
+    });
+    group.bench_function("get_output_bytes/cached", |b| {
+        b.iter(|| eval.get_output_bytes(OutputKind::EvaluatedSchema).unwrap())
+    });
+    group.finish();
+}
+
+fn bench_subforms(c: &mut Criterion) {
+    let schema = fixture("rider_subform_form.json");
+    let payload = rider_payload(1);
+    let mut base = JSONEval::new(&schema, None, None).unwrap();
+    base.evaluate(&payload, None, None, None).unwrap();
+
+    let mut group = c.benchmark_group("subforms");
+    group.throughput(Throughput::Elements(RIDERS as u64));
+    group.bench_function("evaluate_subform_per_item", |b| {
+        b.iter_batched(
+            || base.clone(),
+            |mut eval| {
+                for idx in 0..RIDERS {
+                    eval.evaluate_subform(&format!("riders.{}", idx), &payload, None, None, None)
+                        .unwrap();
+                }
+                eval
+            },
+            BatchSize::SmallInput,
+        )
+    });
+    group.bench_function("evaluate_subform_items", |b| {
+        b.iter_batched(
+            || base.clone(),
+            |mut eval| {
+                eval.evaluate_subform_items("riders", &payload, None, None)
+                    .unwrap();
+                eval
+            },
+            BatchSize::SmallInput,
+        )
+    });
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_json_parser,
+    bench_schema_parse,
+    bench_topo_sort,
+    bench_evaluate,
+    bench_evaluate_dependents,
+    bench_tables,
+    bench_array_lookup,
+    bench_validation,
+    bench_layout,
+    bench_getters,
+    bench_subforms
+);
+criterion_main!(benches);
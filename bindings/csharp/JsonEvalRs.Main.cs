@@ -489,6 +489,20 @@ namespace JsonEvalRs
             return ProcessResultAsBytes(result);
         }
 
+        /// <summary>
+        /// Output generation of this instance. It changes whenever an operation may have
+        /// changed what the getters return; getters called at the same generation are
+        /// served from one cached result.
+        /// </summary>
+        public ulong OutputGeneration
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return Native.json_eval_output_generation(_handle);
+            }
+        }
+
         /// <summary>
         /// Gets all schema values (evaluations ending with .value)
         /// </summary>
@@ -77,6 +77,9 @@ namespace JsonEvalRs
             IntPtr handle
         );
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern ulong json_eval_output_generation(IntPtr handle);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         internal static extern FFIResult json_eval_get_subform_paths(IntPtr handle);
 
@@ -45,6 +45,13 @@ namespace JsonEvalRs
             IntPtr handle,
             [MarshalAs(UnmanagedType.LPUTF8Str)] string key
         );
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        internal static extern int parsed_cache_pin(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+            int pinned
+        );
 #else
         // .NET Standard 2.0 - use byte arrays
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
@@ -71,6 +78,13 @@ namespace JsonEvalRs
             IntPtr handle,
             byte[] key
         );
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int parsed_cache_pin(
+            IntPtr handle,
+            byte[] key,
+            int pinned
+        );
 #endif
 
         // MessagePack support
@@ -95,6 +109,13 @@ namespace JsonEvalRs
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         internal static extern FFIResult parsed_cache_stats(IntPtr handle);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void parsed_cache_set_capacity(
+            IntPtr handle,
+            UIntPtr maxEntries,
+            UIntPtr maxBytes
+        );
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         internal static extern FFIResult parsed_cache_keys(IntPtr handle);
     }
@@ -185,6 +185,37 @@ namespace JsonEvalRs
 #endif
         }
 
+        /// <summary>
+        /// Bound the cache; least recently used unpinned entries are evicted to stay within the limits
+        /// </summary>
+        /// <param name="maxEntries">Maximum number of entries (0 = unbounded)</param>
+        /// <param name="maxBytes">Maximum total estimated size in bytes (0 = unbounded)</param>
+        public void SetCapacity(ulong maxEntries, ulong maxBytes)
+        {
+            ThrowIfDisposed();
+            Native.parsed_cache_set_capacity(_handle, new UIntPtr(maxEntries), new UIntPtr(maxBytes));
+        }
+
+        /// <summary>
+        /// Pin or unpin a cached schema; pinned entries are never evicted
+        /// </summary>
+        /// <param name="key">Cache key</param>
+        /// <param name="pinned">True to pin, false to unpin</param>
+        /// <returns>True if the key exists</returns>
+        public bool SetPinned(string key, bool pinned)
+        {
+            ThrowIfDisposed();
+
+            if (string.IsNullOrEmpty(key))
+                return false;
+
+#if NETCOREAPP || NET5_0_OR_GREATER
+            return Native.parsed_cache_pin(_handle, key, pinned ? 1 : 0) != 0;
+#else
+            return Native.parsed_cache_pin(_handle, Native.ToUTF8Bytes(key)!, pinned ? 1 : 0) != 0;
+#endif
+        }
+
         /// <summary>
         /// Clear all entries from the cache
         /// </summary>
@@ -247,7 +278,14 @@ namespace JsonEvalRs
                 return new ParsedCacheStats
                 {
                     EntryCount = jobj["entry_count"]?.Value<int>() ?? 0,
-                    Keys = jobj["keys"]?.ToObject<List<string>>() ?? new List<string>()
+                    Keys = jobj["keys"]?.ToObject<List<string>>() ?? new List<string>(),
+                    TotalBytes = jobj["total_bytes"]?.Value<long>() ?? 0,
+                    PinnedCount = jobj["pinned_count"]?.Value<int>() ?? 0,
+                    MaxEntries = jobj["max_entries"]?.Value<long?>(),
+                    MaxBytes = jobj["max_bytes"]?.Value<long?>(),
+                    Hits = jobj["hits"]?.Value<long>() ?? 0,
+                    Misses = jobj["misses"]?.Value<long>() ?? 0,
+                    Evictions = jobj["evictions"]?.Value<long>() ?? 0
                 };
             }
             finally
@@ -337,9 +375,44 @@ namespace JsonEvalRs
         /// </summary>
         public List<string> Keys { get; set; } = new List<string>();
 
+        /// <summary>
+        /// Sum of the entries' estimated sizes in bytes
+        /// </summary>
+        public long TotalBytes { get; set; }
+
+        /// <summary>
+        /// Number of pinned entries
+        /// </summary>
+        public int PinnedCount { get; set; }
+
+        /// <summary>
+        /// Entry limit, or null if unbounded
+        /// </summary>
+        public long? MaxEntries { get; set; }
+
+        /// <summary>
+        /// Byte limit, or null if unbounded
+        /// </summary>
+        public long? MaxBytes { get; set; }
+
+        /// <summary>
+        /// Lookups that found their key
+        /// </summary>
+        public long Hits { get; set; }
+
+        /// <summary>
+        /// Lookups that did not find their key
+        /// </summary>
+        public long Misses { get; set; }
+
+        /// <summary>
+        /// Entries dropped to stay within capacity
+        /// </summary>
+        public long Evictions { get; set; }
+
         public override string ToString()
         {
-            return $"ParsedSchemaCache: {EntryCount} entries" +
+            return $"ParsedSchemaCache: {EntryCount} entries, {TotalBytes} bytes ({Hits} hits, {Misses} misses, {Evictions} evictions)" +
                    (Keys.Count > 0 ? $" (keys: {string.Join(", ", Keys)})" : "");
         }
     }
@@ -278,6 +278,22 @@ Java_com_jsonevalrs_JsonEvalRsModule_nativeEvaluateOnlyAsync(
     });
 }
 
+JNIEXPORT void JNICALL
+Java_com_jsonevalrs_JsonEvalRsModule_nativeSetValuesAsync(
+    JNIEnv* env,
+    jobject /* this */,
+    jstring handle,
+    jstring patchesJson,
+    jobject promise
+) {
+    std::string handleStr = jstringToString(env, handle);
+    std::string patchesJsonStr = jstringToString(env, patchesJson);
+
+    runAsyncWithPromise(env, promise, "SET_VALUES_ERROR", [handleStr, patchesJsonStr](auto callback) {
+        JsonEvalBridge::setValuesAsync(handleStr, patchesJsonStr, callback);
+    });
+}
+
 JNIEXPORT jdouble JNICALL
 Java_com_jsonevalrs_JsonEvalRsModule_nativeCompileLogic(
     JNIEnv* env,
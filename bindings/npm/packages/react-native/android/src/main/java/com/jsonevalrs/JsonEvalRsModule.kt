@@ -64,6 +64,15 @@ class JsonEvalRsModule(
         nativeEvaluateOnlyAsync(handle, data, context ?: "", pathsJson ?: "", promise)
     }
 
+    @ReactMethod
+    fun setValues(
+        handle: String,
+        patchesJson: String,
+        promise: Promise,
+    ) {
+        nativeSetValuesAsync(handle, patchesJson, promise)
+    }
+
     @ReactMethod
     fun validate(
         handle: String,
@@ -608,6 +617,12 @@ class JsonEvalRsModule(
         promise: Promise,
     )
 
+    private external fun nativeSetValuesAsync(
+        handle: String,
+        patchesJson: String,
+        promise: Promise,
+    )
+
     private external fun nativeValidateAsync(
         handle: String,
         data: String,
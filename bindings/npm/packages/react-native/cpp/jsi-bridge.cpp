@@ -7,7 +7,9 @@ extern "C" {
     JSONEvalHandle* json_eval_new(const char* schema, const char* context, const char* data);
     JSONEvalHandle* json_eval_new_from_msgpack(const uint8_t* schema_msgpack, size_t schema_len, const char* context, const char* data);
     JSONEvalHandle* json_eval_new_from_cache(const char* cache_key, const char* context, const char* data);
+    JSONEvalHandle* json_eval_new_from_snapshot(const uint8_t* snapshot, size_t snapshot_len, const char* context, const char* data);
     FFIResult json_eval_evaluate(JSONEvalHandle* handle, const char* data, const char* context, const char* paths_json);
+    FFIResult json_eval_set_values(JSONEvalHandle* handle, const char* patches_json);
     FFIResult json_eval_get_evaluated_schema(JSONEvalHandle* handle);
     FFIResult json_eval_get_evaluated_schema_msgpack(JSONEvalHandle* handle);
     FFIResult json_eval_get_evaluated_schema_resolved_msgpack(JSONEvalHandle* handle);
@@ -31,12 +33,15 @@ extern "C" {
     FFIResult json_eval_reload_schema_from_cache(JSONEvalHandle* handle, const char* cache_key, const char* context, const char* data);
     void json_eval_set_timezone_offset(JSONEvalHandle* handle, int32_t offset_minutes);
     void json_eval_free(JSONEvalHandle* handle);
+    JSONEvalHandle* json_eval_pool_acquire(const char* cache_key, const char* context, const char* data);
+    void json_eval_pool_release(JSONEvalHandle* handle);
     void json_eval_free_result(FFIResult result);
     const char* json_eval_version();
     void json_eval_free_string(char* ptr);
 
     // Subform FFI methods
     FFIResult json_eval_evaluate_subform(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context, const char* paths_json);
+    FFIResult json_eval_evaluate_subform_items(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context);
     FFIResult json_eval_validate_subform(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context);
     FFIResult json_eval_evaluate_dependents_subform(JSONEvalHandle* handle, const char* subform_path, const char* changed_path, const char* data, const char* context, int re_evaluate, int include_subforms);
     FFIResult json_eval_resolve_layout_subform(JSONEvalHandle* handle, const char* subform_path, bool evaluate);
@@ -52,6 +57,7 @@ extern "C" {
     FFIResult json_eval_get_subform_paths(JSONEvalHandle* handle);
     FFIResult json_eval_has_subform(JSONEvalHandle* handle, const char* subform_path);
     FFIResult json_eval_evaluate_logic_pure(const char* logic_str, const char* data, const char* context);
+    FFIResult json_eval_evaluate_batch(const char* cache_key, const char* records_json, const char* output_paths_json);
     FFIResult json_eval_get_field_options(JSONEvalHandle* handle, const char* field_path);
     FFIResult json_eval_get_resolved_layout(JSONEvalHandle* handle);
     FFIResult json_eval_get_resolved_layout_subform(JSONEvalHandle* handle, const char* subform_path);
@@ -269,7 +275,7 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
                 auto cacheKey = stringFromValue(rt, args[0]);
                 auto ctx = count > 1 ? stringFromValue(rt, args[1]) : "";
                 auto data = count > 2 ? stringFromValue(rt, args[2]) : "";
-                JSONEvalHandle* handle = json_eval_new_from_cache(
+                JSONEvalHandle* handle = json_eval_pool_acquire(
                     cacheKey.c_str(),
                     ctx.empty() ? nullptr : ctx.c_str(),
                     data.empty() ? nullptr : data.c_str()
@@ -282,6 +288,31 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
         );
     }
 
+    // ---- createFromSnapshot ----
+    if (prop == "createFromSnapshot") {
+        return createJsiFn(runtime, "createFromSnapshot",
+            [](jsi::Runtime& rt, const jsi::Value* args, size_t count) -> jsi::Value {
+                checkArgCount(rt, count, 1);
+                // First arg: ArrayBuffer holding the snapshot, read in place
+                if (!args[0].isObject() || !args[0].asObject(rt).isArrayBuffer(rt)) {
+                    throw jsi::JSError(rt, "createFromSnapshot expects an ArrayBuffer");
+                }
+                auto buf = args[0].asObject(rt).getArrayBuffer(rt);
+                auto ctx = count > 1 ? stringFromValue(rt, args[1]) : "";
+                auto data = count > 2 ? stringFromValue(rt, args[2]) : "";
+                JSONEvalHandle* handle = json_eval_new_from_snapshot(
+                    buf.data(rt), buf.length(rt),
+                    ctx.empty() ? nullptr : ctx.c_str(),
+                    data.empty() ? nullptr : data.c_str()
+                );
+                if (!handle) throw jsi::JSError(rt, "Failed to create JSONEval from snapshot");
+                auto id = createHandleId();
+                storeHandle(id, handle);
+                return jsi::String::createFromUtf8(rt, id);
+            }
+        );
+    }
+
     // ---- evaluateOnly (void return, no serialization) ----
     if (prop == "evaluateOnly") {
         return createJsiFn(runtime, "evaluateOnly",
@@ -307,6 +338,23 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
         );
     }
 
+    // ---- setValues (in-place field patches, void return) ----
+    if (prop == "setValues") {
+        return createJsiFn(runtime, "setValues",
+            [](jsi::Runtime& rt, const jsi::Value* args, size_t count) -> jsi::Value {
+                checkArgCount(rt, count, 2);
+                auto handleId = stringFromValue(rt, args[0]);
+                auto patches = stringFromValue(rt, args[1]);
+
+                auto [handle, lock] = lockHandleById(handleId);
+                FFIResult result = json_eval_set_values(handle, patches.c_str());
+                checkResult(rt, result);
+                json_eval_free_result(result);
+                return jsi::Value::undefined();
+            }
+        );
+    }
+
     // ---- evaluate (returns evaluated schema JSON string) ----
     if (prop == "evaluate") {
         return createJsiFn(runtime, "evaluate",
@@ -820,7 +868,7 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
                     }
                 }
                 if (nativeHandle) {
-                    json_eval_free(nativeHandle);
+                    json_eval_pool_release(nativeHandle);
                 }
                 return jsi::Value::undefined();
             }
@@ -845,6 +893,24 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
         );
     }
 
+    // ---- evaluateBatch (static, no handle) ----
+    if (prop == "evaluateBatch") {
+        return createJsiFn(runtime, "evaluateBatch",
+            [](jsi::Runtime& rt, const jsi::Value* args, size_t count) -> jsi::Value {
+                checkArgCount(rt, count, 2);
+                auto cacheKey = stringFromValue(rt, args[0]);
+                auto records = stringFromValue(rt, args[1]);
+                auto paths = count > 2 ? stringFromValue(rt, args[2]) : "";
+                FFIResult result = json_eval_evaluate_batch(
+                    cacheKey.c_str(),
+                    records.c_str(),
+                    paths.empty() ? nullptr : paths.c_str()
+                );
+                return ffiResultToJsiObject(rt, result);
+            }
+        );
+    }
+
     // ---- decodeArrayBuffer: convert ArrayBuffer → UTF-8 string (zero-extra-copy)
     // Replaces Hermes TextDecoder with direct JSI-level decode
     if (prop == "decodeArrayBuffer") {
@@ -904,6 +970,30 @@ jsi::Value JsonEvalJSI::get(jsi::Runtime& runtime, const jsi::PropNameID& name)
         );
     }
 
+    // ---- evaluateSubformItems ----
+    if (prop == "evaluateSubformItems") {
+        return createJsiFn(runtime, "evaluateSubformItems",
+            [](jsi::Runtime& rt, const jsi::Value* args, size_t count) -> jsi::Value {
+                checkArgCount(rt, count, 3);
+                auto handleId = stringFromValue(rt, args[0]);
+                auto subformPath = stringFromValue(rt, args[1]);
+                auto data = stringFromValue(rt, args[2]);
+                auto ctx = count > 3 ? stringFromValue(rt, args[3]) : "";
+
+                auto [handle, lock] = lockHandleById(handleId);
+                FFIResult result = json_eval_evaluate_subform_items(
+                    handle,
+                    subformPath.c_str(),
+                    data.c_str(),
+                    ctx.empty() ? nullptr : ctx.c_str()
+                );
+                checkResult(rt, result);
+                json_eval_free_result(result);
+                return jsi::Value::undefined();
+            }
+        );
+    }
+
     // ---- validateSubform ----
     if (prop == "validateSubform") {
         return createJsiFn(runtime, "validateSubform",
@@ -1185,8 +1275,8 @@ void JsonEvalJSI::set(jsi::Runtime& runtime, const jsi::PropNameID& name, const
 
 std::vector<jsi::PropNameID> JsonEvalJSI::getPropertyNames(jsi::Runtime& runtime) {
     std::vector<const char*> names = {
-        "create", "createFromMsgpack", "createFromCache",
-        "evaluateOnly", "evaluate",
+        "create", "createFromMsgpack", "createFromCache", "createFromSnapshot",
+        "evaluateOnly", "evaluate", "setValues",
         "validate", "validatePaths",
         "evaluateDependents",
         "getEvaluatedSchema", "getEvaluatedSchemaMsgpack", "getEvaluatedSchemaResolvedMsgpack", "getEvaluatedSchemaResolved", "getSchemaValue", "getSchemaValueArray", "getSchemaValueObject",
@@ -1197,9 +1287,9 @@ std::vector<jsi::PropNameID> JsonEvalJSI::getPropertyNames(jsi::Runtime& runtime
         "compileAndRunLogic", "compileLogic", "runLogic",
         "reloadSchema", "reloadSchemaMsgpack", "reloadSchemaFromCache",
         "setTimezoneOffset",
-        "dispose", "cancel", "evaluateLogic", "version", "decodeArrayBuffer",
+        "dispose", "cancel", "evaluateLogic", "evaluateBatch", "version", "decodeArrayBuffer",
         // Subform
-        "evaluateSubform", "validateSubform", "evaluateDependentsSubform",
+        "evaluateSubform", "evaluateSubformItems", "validateSubform", "evaluateDependentsSubform",
         "resolveLayoutSubform",
         "getResolvedLayoutSubform",
         "getEvaluatedSchemaSubform", "getEvaluatedSchemaResolvedSubform",
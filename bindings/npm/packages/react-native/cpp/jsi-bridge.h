@@ -41,6 +41,7 @@ namespace jsi = facebook::jsi;
  * Usage from JS:
  *   global.jsonEval.create(schema, context, data) -> handle
  *   global.jsonEval.evaluateOnly(handle, data, context, paths) -> void
+ *   global.jsonEval.setValues(handle, patches) -> void
  *   global.jsonEval.evaluate(handle, data, context, paths) -> JSON string
  *   global.jsonEval.getSchemaValueObject(handle) -> JSON string
  *   global.jsonEval.dispose(handle) -> void
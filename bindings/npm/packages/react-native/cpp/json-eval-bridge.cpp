@@ -78,6 +78,7 @@ extern "C" {
     JSONEvalHandle* json_eval_new(const char* schema, const char* context, const char* data);
     JSONEvalHandle* json_eval_new_from_msgpack(const uint8_t* schema_msgpack, size_t schema_len, const char* context, const char* data);
     FFIResult json_eval_evaluate(JSONEvalHandle* handle, const char* data, const char* context, const char* paths_json);
+    FFIResult json_eval_set_values(JSONEvalHandle* handle, const char* patches_json);
     FFIResult json_eval_get_evaluated_schema_msgpack(JSONEvalHandle* handle);
     FFIResult json_eval_get_evaluated_schema_resolved_msgpack(JSONEvalHandle* handle);
     FFIResult json_eval_validate(JSONEvalHandle* handle, const char* data, const char* context);
@@ -102,11 +103,14 @@ extern "C" {
     FFIResult json_eval_reload_schema_msgpack(JSONEvalHandle* handle, const uint8_t* schema_msgpack, size_t schema_len, const char* context, const char* data);
     FFIResult json_eval_reload_schema_from_cache(JSONEvalHandle* handle, const char* cache_key, const char* context, const char* data);
     JSONEvalHandle* json_eval_new_from_cache(const char* cache_key, const char* context, const char* data);
+    JSONEvalHandle* json_eval_new_from_snapshot(const uint8_t* snapshot, size_t snapshot_len, const char* context, const char* data);
     FFIResult json_eval_validate_paths(JSONEvalHandle* handle, const char* data, const char* context, const char* paths_json);
     FFIResult json_eval_evaluate_logic_pure(const char* logic_str, const char* data, const char* context);
+    FFIResult json_eval_evaluate_batch(const char* cache_key, const char* records_json, const char* output_paths_json);
     
     // Subform FFI methods
     FFIResult json_eval_evaluate_subform(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context, const char* paths_json);
+    FFIResult json_eval_evaluate_subform_items(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context);
     FFIResult json_eval_validate_subform(JSONEvalHandle* handle, const char* subform_path, const char* data, const char* context);
     FFIResult json_eval_evaluate_dependents_subform(JSONEvalHandle* handle, const char* subform_path, const char* changed_path, const char* data, const char* context, int re_evaluate, int include_subforms);
     FFIResult json_eval_resolve_layout_subform(JSONEvalHandle* handle, const char* subform_path, bool evaluate);
@@ -127,6 +131,8 @@ extern "C" {
     void json_eval_set_timezone_offset(JSONEvalHandle* handle, int32_t offset_minutes);
     
     void json_eval_free(JSONEvalHandle* handle);
+    JSONEvalHandle* json_eval_pool_acquire(const char* cache_key, const char* context, const char* data);
+    void json_eval_pool_release(JSONEvalHandle* handle);
     void json_eval_cancel(JSONEvalHandle* handle);
     void json_eval_free_result(FFIResult result);
     const char* json_eval_version();
@@ -217,7 +223,7 @@ std::string JsonEvalBridge::createFromCache(
     const char* ctx = context.empty() ? nullptr : context.c_str();
     const char* dt = data.empty() ? nullptr : data.c_str();
     
-    JSONEvalHandle* handle = json_eval_new_from_cache(
+    JSONEvalHandle* handle = json_eval_pool_acquire(
         cacheKey.c_str(),
         ctx,
         dt
@@ -235,6 +241,34 @@ std::string JsonEvalBridge::createFromCache(
     return handleId;
 }
 
+std::string JsonEvalBridge::createFromSnapshot(
+    const uint8_t* snapshot,
+    size_t snapshotLen,
+    const std::string& context,
+    const std::string& data
+) {
+    const char* ctx = context.empty() ? nullptr : context.c_str();
+    const char* dt = data.empty() ? nullptr : data.c_str();
+    
+    JSONEvalHandle* handle = json_eval_new_from_snapshot(
+        snapshot,
+        snapshotLen,
+        ctx,
+        dt
+    );
+    
+    if (handle == nullptr) {
+        throw std::runtime_error("Failed to create JSONEval instance from snapshot");
+    }
+    
+    std::lock_guard<std::mutex> lock(handlesMapMutex);
+    std::string handleId = "handle_" + std::to_string(handleCounter++);
+    handles[handleId] = handle;
+    handleMutexes.try_emplace(handleId);
+    
+    return handleId;
+}
+
 template<typename Func>
 void JsonEvalBridge::runAsync(Func&& func, std::function<void(const std::string&, const std::string&)> callback) {
     gThreadPool.enqueue([func = std::forward<Func>(func), callback]() {
@@ -331,6 +365,23 @@ void JsonEvalBridge::evaluateOnlyAsync(
     }, callback);
 }
 
+void JsonEvalBridge::setValuesAsync(
+    const std::string& handleId,
+    const std::string& patchesJson,
+    std::function<void(const std::string&, const std::string&)> callback
+) {
+    runWithHandle(handleId, [patchesJson](JSONEvalHandle* nativeHandle) -> std::string {
+        FFIResult result = json_eval_set_values(nativeHandle, patchesJson.c_str());
+        if (!result.success) {
+            std::string error = result.error ? result.error : "Unknown error";
+            json_eval_free_result(result);
+            throw std::runtime_error(error);
+        }
+        json_eval_free_result(result);
+        return "";
+    }, callback);
+}
+
 uint64_t JsonEvalBridge::compileLogic(
     const std::string& handleId,
     const std::string& logicStr
@@ -428,6 +479,35 @@ void JsonEvalBridge::evaluateLogicAsync(
     });
 }
 
+void JsonEvalBridge::evaluateBatchAsync(
+    const std::string& cacheKey,
+    const std::string& recordsJson,
+    const std::string& outputPathsJson,
+    std::function<void(const std::string&, const std::string&)> callback
+) {
+    gThreadPool.enqueue([cacheKey, recordsJson, outputPathsJson, callback]() {
+        try {
+            const char* paths = outputPathsJson.empty() ? nullptr : outputPathsJson.c_str();
+            FFIResult result = json_eval_evaluate_batch(cacheKey.c_str(), recordsJson.c_str(), paths);
+            if (!result.success) {
+                std::string error = result.error ? result.error : "Unknown error";
+                json_eval_free_result(result);
+                throw std::runtime_error(error);
+            }
+            std::string resultStr;
+            if (result.data_ptr && result.data_len > 0) {
+                resultStr.assign(reinterpret_cast<const char*>(result.data_ptr), result.data_len);
+            } else {
+                resultStr = "[]";
+            }
+            json_eval_free_result(result);
+            callback(resultStr, "");
+        } catch (const std::exception& e) {
+            callback("", e.what());
+        }
+    });
+}
+
 void JsonEvalBridge::evaluateDependentsAsync(
     const std::string& handleId,
     const std::string& changedPathsJson,
@@ -954,6 +1034,26 @@ void JsonEvalBridge::evaluateSubformAsync(
     }, callback);
 }
 
+void JsonEvalBridge::evaluateSubformItemsAsync(
+    const std::string& handleId,
+    const std::string& subformPath,
+    const std::string& data,
+    const std::string& context,
+    std::function<void(const std::string&, const std::string&)> callback
+) {
+    runWithHandle(handleId, [subformPath, data, context](JSONEvalHandle* nativeHandle) -> std::string {
+        const char* ctx = context.empty() ? nullptr : context.c_str();
+        FFIResult result = json_eval_evaluate_subform_items(nativeHandle, subformPath.c_str(), data.c_str(), ctx);
+        if (!result.success) {
+            std::string error = result.error ? result.error : "Unknown error";
+            json_eval_free_result(result);
+            throw std::runtime_error(error);
+        }
+        json_eval_free_result(result);
+        return "{}";
+    }, callback);
+}
+
 void JsonEvalBridge::validateSubformAsync(
     const std::string& handleId,
     const std::string& subformPath,
@@ -1353,7 +1453,7 @@ void JsonEvalBridge::dispose(const std::string& handleId) {
         }
     }
     if (nativeHandle) {
-        json_eval_free(nativeHandle);
+        json_eval_pool_release(nativeHandle);
     }
 }
 
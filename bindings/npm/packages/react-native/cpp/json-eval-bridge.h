@@ -41,6 +41,7 @@ public:
 
     /**
      * Create instance from ParsedSchemaCache
+     * Instances come from a pool per cache key; dispose returns them to it
      * @param cacheKey Cache key to lookup in ParsedSchemaCache
      * @param context Optional context data
      * @param data Optional initial data
@@ -52,6 +53,21 @@ public:
         const std::string& data
     );
 
+    /**
+     * Create instance from a ParsedSchema snapshot (no schema parsing)
+     * @param snapshot Snapshot bytes, e.g. a memory-mapped file; only read during the call
+     * @param snapshotLen Snapshot length in bytes
+     * @param context Optional context data
+     * @param data Optional initial data
+     * @return Handle string or error
+     */
+    static std::string createFromSnapshot(
+        const uint8_t* snapshot,
+        size_t snapshotLen,
+        const std::string& context,
+        const std::string& data
+    );
+
     /**
      * Evaluate schema with data (async)
      * @param handle Instance handle
@@ -85,6 +101,19 @@ public:
         std::function<void(const std::string&, const std::string&)> callback
     );
 
+    /**
+     * Patch individual data fields in place and re-evaluate (async)
+     * Only the patched paths are diffed, avoiding a full data round-trip
+     * @param handle Instance handle
+     * @param patchesJson JSON object of path -> value, or array of [path, value] pairs
+     * @param callback Result callback (empty string on success)
+     */
+    static void setValuesAsync(
+        const std::string& handle,
+        const std::string& patchesJson,
+        std::function<void(const std::string&, const std::string&)> callback
+    );
+
     /**
      * Validate data (async)
      * @param handle Instance handle
@@ -419,6 +448,20 @@ public:
         std::function<void(const std::string&, const std::string&)> callback
     );
 
+    /**
+     * Evaluate many data records against a cached schema (async)
+     * @param cacheKey Key of the schema in the global parsed schema cache
+     * @param recordsJson JSON array of data records
+     * @param outputPathsJson JSON array of schema paths to return (empty for the whole schema)
+     * @param callback Result callback, JSON array of {"value": ...} or {"error": ...} per record
+     */
+    static void evaluateBatchAsync(
+        const std::string& cacheKey,
+        const std::string& recordsJson,
+        const std::string& outputPathsJson,
+        std::function<void(const std::string&, const std::string&)> callback
+    );
+
     // ========================================================================
     // Subform Methods
     // ========================================================================
@@ -440,6 +483,22 @@ public:
         std::function<void(const std::string&, const std::string&)> callback
     );
 
+    /**
+     * Evaluate every item of a subform array, on worker threads (async)
+     * @param handleId Instance handle
+     * @param subformPath Path to the subform array (e.g., "#/riders")
+     * @param data Full parent JSON data holding the array
+     * @param context Optional context data
+     * @param callback Result callback
+     */
+    static void evaluateSubformItemsAsync(
+        const std::string& handleId,
+        const std::string& subformPath,
+        const std::string& data,
+        const std::string& context,
+        std::function<void(const std::string&, const std::string&)> callback
+    );
+
     /**
      * Validate subform data against its schema rules (async)
      * @param handleId Instance handle
@@ -690,7 +749,7 @@ public:
     );
 
     /**
-     * Dispose instance
+     * Dispose instance (returned to the pool if it came from createFromCache)
      * @param handle Instance handle
      */
     static void dispose(const std::string& handle);
@@ -159,6 +159,25 @@ RCT_EXPORT_METHOD(evaluateOnly:(NSString *)handle
     );
 }
 
+RCT_EXPORT_METHOD(setValues:(NSString *)handle
+                  patchesJson:(NSString *)patchesJson
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject)
+{
+    std::string handleStr = [self stdStringFromNSString:handle];
+    std::string patchesJsonStr = [self stdStringFromNSString:patchesJson];
+
+    JsonEvalBridge::setValuesAsync(handleStr, patchesJsonStr,
+        [resolve, reject](const std::string& result, const std::string& error) {
+            if (error.empty()) {
+                resolve(nil);
+            } else {
+                reject(@"SET_VALUES_ERROR", [NSString stringWithUTF8String:error.c_str()], nil);
+            }
+        }
+    );
+}
+
 RCT_EXPORT_METHOD(compileLogic:(NSString *)handle
                   logicStr:(NSString *)logicStr
                   resolver:(RCTPromiseResolveBlock)resolve
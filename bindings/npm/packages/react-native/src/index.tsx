@@ -396,6 +396,27 @@ export class JSONEval {
     }
   }
 
+  /**
+   * Patch individual data fields in place and re-evaluate.
+   * Cheaper than `evaluateOnly` for small edits: only the patched paths are
+   * diffed, and the full data object is not re-sent.
+   * @param patches - Object of path -> value, or array of [path, value] pairs.
+   * Paths accept dotted notation or JSON pointers.
+   * @returns Promise that resolves when evaluation is complete
+   * @throws {Error} If a path cannot be patched or evaluation fails
+   */
+  async setValues(
+    patches: Record<string, any> | Array<[string, any]>
+  ): Promise<void> {
+    this.throwIfDisposed();
+
+    try {
+      await this._callNative('setValues', JSON.stringify(patches));
+    } catch (error) {
+      throw new Error(`Set values failed: ${extractErrorMessage(error)}`);
+    }
+  }
+
   /**
    * Validate data against schema rules
    * @param options - Validation options
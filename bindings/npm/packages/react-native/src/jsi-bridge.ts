@@ -22,6 +22,11 @@ export interface JsonEvalJSIGlobal {
     context: string | null,
     data: string | null
   ): string;
+  createFromSnapshot(
+    snapshot: ArrayBuffer,
+    context: string | null,
+    data: string | null
+  ): string;
   dispose(handle: string): void;
 
   // Evaluation
@@ -37,6 +42,7 @@ export interface JsonEvalJSIGlobal {
     context: string | null,
     paths: string | null
   ): string;
+  setValues(handle: string, patches: string): void;
   validate(handle: string, data: string, context: string | null): string;
   validatePaths(
     handle: string,
@@ -122,6 +128,12 @@ export interface JsonEvalJSIGlobal {
     context: string | null,
     paths: string | null
   ): void;
+  evaluateSubformItems(
+    handle: string,
+    subformPath: string,
+    data: string,
+    context: string | null
+  ): void;
   validateSubform(
     handle: string,
     subformPath: string,
@@ -195,6 +207,13 @@ export interface JsonEvalJSIGlobal {
     context: string | null
   ): string;
 
+  /** Evaluate a JSON array of records against a cached schema */
+  evaluateBatch(
+    cacheKey: string,
+    recordsJson: string,
+    outputPathsJson: string | null
+  ): string;
+
   version(): string;
 }
 
@@ -1,6 +1,6 @@
 mod common;
 
-use json_eval_rs::{JSONEval, ParsedSchema};
+use json_eval_rs::{JSONEval, ParsedSchema, ParsedSchemaCache};
 use serde_json::{Map, Value};
 use std::fs;
 use std::path::Path;
@@ -17,6 +17,7 @@ fn print_help(program_name: &str) {
     println!("    --parsed                     Use ParsedSchema for caching (parse once, reuse)");
     println!("    --cache                      Reuse JSONEval instance across iterations");
     println!("    --concurrent <COUNT>         Test concurrent evaluations with N threads");
+    println!("                                 (with --parsed, also measures schema-cache lookup scaling)");
     println!("    --compare                    Enable comparison with expected results");
     println!("    --timing                     Show detailed internal timing breakdown");
     println!("    --cpu-info                   Show CPU feature information\n");
@@ -41,6 +42,52 @@ fn print_help(program_name: &str) {
     );
 }
 
+/// Lookups per thread in the schema-cache contention measurement
+const CACHE_LOOKUPS_PER_THREAD: usize = 1_000_000;
+
+/// Measure `ParsedSchemaCache::get` throughput on one hot key with 1..=`thread_count`
+/// threads. Lookups should scale with threads rather than contend on the cache.
+fn bench_cache_lookups(parsed_schema: &Arc<ParsedSchema>, thread_count: usize) {
+    let cache = ParsedSchemaCache::new();
+    cache.insert("bench".to_string(), parsed_schema.clone());
+
+    println!(
+        "  Schema cache lookups ({} per thread):",
+        CACHE_LOOKUPS_PER_THREAD
+    );
+    let mut single_thread_rate = 0.0;
+    let mut threads = 1;
+    loop {
+        let start = Instant::now();
+        std::thread::scope(|scope| {
+            for _ in 0..threads {
+                scope.spawn(|| {
+                    for _ in 0..CACHE_LOOKUPS_PER_THREAD {
+                        std::hint::black_box(cache.get("bench"));
+                    }
+                });
+            }
+        });
+        let elapsed = start.elapsed();
+        let rate = (threads * CACHE_LOOKUPS_PER_THREAD) as f64 / elapsed.as_secs_f64();
+        if threads == 1 {
+            single_thread_rate = rate;
+        }
+        println!(
+            "    {:>3} thread(s): {:>12.0} lookups/s ({:.2}x)",
+            threads,
+            rate,
+            rate / single_thread_rate
+        );
+
+        if threads == thread_count {
+            break;
+        }
+        threads = (threads * 2).min(thread_count);
+    }
+    println!();
+}
+
 fn main() {
     let args: Vec<String> = std::env::args().collect();
     let program_name = args.get(0).map(|s| s.as_str()).unwrap_or("benchmark");
@@ -239,6 +286,8 @@ fn main() {
             if let Some(thread_count) = concurrent_count {
                 use std::thread;
 
+                bench_cache_lookups(&parsed_schema, thread_count);
+
                 let eval_start = Instant::now();
                 let mut handles = vec![];
 
@@ -0,0 +1,190 @@
+// Only the scenario loader is used here
+#[allow(dead_code)]
+mod common;
+
+use json_eval_rs::jsoneval::eval_cache::EvalCache;
+use serde_json::Value;
+use std::fs;
+use std::path::Path;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+fn print_help(program_name: &str) {
+    println!("\n🚀 JSON Evaluation - Version Diff Benchmark\n");
+    println!("USAGE:");
+    println!("    {} [OPTIONS] [FILTER]\n", program_name);
+    println!("OPTIONS:");
+    println!("    -h, --help                   Show this help message");
+    println!("    -i, --iterations <COUNT>     Number of diff iterations (default: 100)\n");
+    println!("ARGUMENTS:");
+    println!("    [FILTER]                     Optional filter to match scenario names\n");
+    println!("Diffs each scenario's data payload against:");
+    println!("    shared     the same snapshot (Arc clone)");
+    println!("    unchanged  an equal deep copy");
+    println!("    one-leaf   a copy with a single scalar changed");
+}
+
+/// Change the first scalar leaf in document order; returns its JSON pointer
+fn mutate_first_leaf(value: &mut Value, pointer: &mut String) -> bool {
+    match value {
+        Value::Object(map) => {
+            for (key, child) in map.iter_mut() {
+                if key == "$params" {
+                    continue;
+                }
+                let len = pointer.len();
+                pointer.push('/');
+                pointer.push_str(key);
+                if mutate_first_leaf(child, pointer) {
+                    return true;
+                }
+                pointer.truncate(len);
+            }
+            false
+        }
+        Value::Array(items) => {
+            for (i, child) in items.iter_mut().enumerate() {
+                let len = pointer.len();
+                pointer.push_str(&format!("/{}", i));
+                if mutate_first_leaf(child, pointer) {
+                    return true;
+                }
+                pointer.truncate(len);
+            }
+            false
+        }
+        Value::Number(n) => {
+            *value = Value::from(n.as_f64().unwrap_or(0.0) + 1.0);
+            true
+        }
+        Value::String(s) => {
+            s.push('x');
+            true
+        }
+        Value::Bool(b) => {
+            *b = !*b;
+            true
+        }
+        Value::Null => {
+            *value = Value::Bool(true);
+            true
+        }
+    }
+}
+
+fn time_diff(old: &Value, new: &Value, iterations: usize) -> Duration {
+    let start = Instant::now();
+    for _ in 0..iterations {
+        let mut cache = EvalCache::new();
+        cache.store_snapshot_and_diff_versions(old, new);
+    }
+    start.elapsed()
+}
+
+fn main() {
+    let args: Vec<String> = std::env::args().collect();
+    let program_name = args.get(0).map(|s| s.as_str()).unwrap_or("diff_benchmark");
+
+    let mut iterations = 100usize;
+    let mut scenario_filter: Option<String> = None;
+    let mut i = 1;
+
+    while i < args.len() {
+        let arg = &args[i];
+
+        if arg == "-h" || arg == "--help" {
+            print_help(program_name);
+            return;
+        } else if arg == "-i" || arg == "--iterations" {
+            if i + 1 >= args.len() {
+                eprintln!("Error: {} requires a value", arg);
+                print_help(program_name);
+                return;
+            }
+            i += 1;
+            match args[i].parse::<usize>() {
+                Ok(n) if n > 0 => iterations = n,
+                _ => {
+                    eprintln!(
+                        "Error: iterations must be a positive integer, got '{}'",
+                        args[i]
+                    );
+                    return;
+                }
+            }
+        } else if !arg.starts_with('-') {
+            scenario_filter = Some(arg.clone());
+        } else {
+            eprintln!("Error: unknown option '{}'", arg);
+            print_help(program_name);
+            return;
+        }
+
+        i += 1;
+    }
+
+    let samples_dir = Path::new("samples");
+    let mut scenarios = common::discover_scenarios(samples_dir);
+    // Diffing only looks at the data payload; one run per data file is enough
+    scenarios.retain(|s| !s.is_msgpack || !s.name.ends_with("-msgpack"));
+    if let Some(ref filter) = scenario_filter {
+        scenarios.retain(|s| s.name.contains(filter));
+    }
+
+    if scenarios.is_empty() {
+        println!(
+            "ℹ️  No scenarios discovered in `{}`. Add files like `name.json` and `name-data.json`.",
+            samples_dir.display()
+        );
+        return;
+    }
+
+    println!("\n🚀 JSON Evaluation - Version Diff Benchmark\n");
+    println!("🔄 Iterations per case: {}\n", iterations);
+
+    for scenario in &scenarios {
+        let data_str = match fs::read_to_string(&scenario.data_path) {
+            Ok(s) => s,
+            Err(e) => {
+                eprintln!("❌ {}: failed to read data: {}", scenario.name, e);
+                continue;
+            }
+        };
+        let data: Value = match serde_json::from_str(&data_str) {
+            Ok(v) => v,
+            Err(e) => {
+                eprintln!("❌ {}: invalid data JSON: {}", scenario.name, e);
+                continue;
+            }
+        };
+
+        let shared = Arc::new(data);
+        let unchanged = (*shared).clone();
+        let mut one_leaf = (*shared).clone();
+        let mut leaf_pointer = String::new();
+        let has_leaf = mutate_first_leaf(&mut one_leaf, &mut leaf_pointer);
+
+        println!("==============================");
+        println!("Scenario: {} ({} KB)", scenario.name, data_str.len() / 1024);
+
+        let cases: [(&str, &Value, bool); 3] = [
+            ("shared", &shared, true),
+            ("unchanged", &unchanged, true),
+            ("one-leaf", &one_leaf, has_leaf),
+        ];
+        for (label, new, enabled) in cases {
+            if !enabled {
+                continue;
+            }
+            let elapsed = time_diff(&shared, new, iterations);
+            println!(
+                "  {:<10} {:>10.3} µs/diff",
+                label,
+                elapsed.as_secs_f64() * 1e6 / iterations as f64
+            );
+        }
+        if has_leaf {
+            println!("  (one-leaf changed {})", leaf_pointer);
+        }
+    }
+}
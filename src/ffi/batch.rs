@@ -0,0 +1,78 @@
+//! FFI functions for batch evaluation against a cached schema
+
+use super::types::FFIResult;
+use serde_json::Value;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+
+/// Evaluate many data records against a schema in the global ParsedSchemaCache
+///
+/// `records_json` is a JSON array of data objects. `output_paths_json` is an
+/// optional JSON array of schema paths to return; when null or empty the whole
+/// evaluated schema is returned for each record.
+///
+/// The result is a JSON array in record order, each entry either
+/// `{"value": {path: value, ...}}` or `{"error": "message"}`.
+///
+/// # Safety
+///
+/// - cache_key must be a valid null-terminated UTF-8 string
+/// - records_json must be a valid null-terminated UTF-8 string
+/// - output_paths_json may be null, or a valid null-terminated UTF-8 string
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_evaluate_batch(
+    cache_key: *const c_char,
+    records_json: *const c_char,
+    output_paths_json: *const c_char,
+) -> FFIResult {
+    if cache_key.is_null() || records_json.is_null() {
+        return FFIResult::error("Invalid pointer".to_string());
+    }
+
+    let key_str = match CStr::from_ptr(cache_key).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in cache key".to_string()),
+    };
+
+    let records_str = match CStr::from_ptr(records_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in records".to_string()),
+    };
+
+    let output_paths: Vec<String> = if !output_paths_json.is_null() {
+        let paths_str = match CStr::from_ptr(output_paths_json).to_str() {
+            Ok(s) => s,
+            Err(_) => return FFIResult::error("Invalid UTF-8 in output paths".to_string()),
+        };
+        match serde_json::from_str(paths_str) {
+            Ok(paths) => paths,
+            Err(e) => return FFIResult::error(format!("Invalid output paths: {}", e)),
+        }
+    } else {
+        Vec::new()
+    };
+
+    let records: Vec<Value> = match crate::jsoneval::json_parser::parse_json_str(records_str) {
+        Ok(Value::Array(records)) => records,
+        Ok(_) => return FFIResult::error("Records must be a JSON array".to_string()),
+        Err(e) => return FFIResult::error(format!("Failed to parse records: {}", e)),
+    };
+
+    let parsed = match crate::PARSED_SCHEMA_CACHE.get(key_str) {
+        Some(p) => p,
+        None => return FFIResult::error(format!("Schema '{}' not found in cache", key_str)),
+    };
+
+    let results: Vec<Value> = crate::evaluate_batch(parsed, records, &output_paths)
+        .into_iter()
+        .map(|result| match result {
+            Ok(value) => serde_json::json!({ "value": value }),
+            Err(e) => serde_json::json!({ "error": e }),
+        })
+        .collect();
+
+    match serde_json::to_vec(&results) {
+        Ok(bytes) => FFIResult::success(bytes),
+        Err(e) => FFIResult::error(format!("Failed to serialize batch results: {}", e)),
+    }
+}
@@ -74,6 +74,7 @@ pub unsafe extern "C" fn json_eval_new_from_msgpack(
             let handle = Box::new(JSONEvalHandle {
                 inner: Box::new(eval),
                 current_token: None,
+                pool_key: None,
             });
             Box::into_raw(handle)
         }
@@ -85,6 +86,79 @@ pub unsafe extern "C" fn json_eval_new_from_msgpack(
     }
 }
 
+/// Create a new JSONEval instance from a ParsedSchema snapshot
+///
+/// # Safety
+///
+/// - snapshot must be a valid pointer to snapshot bytes (may be memory-mapped)
+/// - snapshot_len must be the exact length of the snapshot
+/// - context can be NULL for no context
+/// - data can be NULL for no initial data
+/// - Caller must call json_eval_free when done
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_new_from_snapshot(
+    snapshot: *const u8,
+    snapshot_len: usize,
+    context: *const c_char,
+    data: *const c_char,
+) -> *mut JSONEvalHandle {
+    if snapshot.is_null() || snapshot_len == 0 {
+        eprintln!("[FFI ERROR] json_eval_new_from_snapshot: invalid snapshot pointer or length");
+        return ptr::null_mut();
+    }
+
+    let snapshot_bytes = std::slice::from_raw_parts(snapshot, snapshot_len);
+
+    let context_str = if !context.is_null() {
+        match CStr::from_ptr(context).to_str() {
+            Ok(s) => Some(s),
+            Err(e) => {
+                eprintln!(
+                    "[FFI ERROR] json_eval_new_from_snapshot: invalid UTF-8 in context: {}",
+                    e
+                );
+                return ptr::null_mut();
+            }
+        }
+    } else {
+        None
+    };
+
+    let data_str = if !data.is_null() {
+        match CStr::from_ptr(data).to_str() {
+            Ok(s) => Some(s),
+            Err(e) => {
+                eprintln!(
+                    "[FFI ERROR] json_eval_new_from_snapshot: invalid UTF-8 in data: {}",
+                    e
+                );
+                return ptr::null_mut();
+            }
+        }
+    } else {
+        None
+    };
+
+    let created = crate::ParsedSchema::from_snapshot(snapshot_bytes).and_then(|parsed| {
+        JSONEval::with_parsed_schema(std::sync::Arc::new(parsed), context_str, data_str)
+    });
+    match created {
+        Ok(eval) => {
+            let handle = Box::new(JSONEvalHandle {
+                inner: Box::new(eval),
+                current_token: None,
+                pool_key: None,
+            });
+            Box::into_raw(handle)
+        }
+        Err(e) => {
+            let error_msg = format!("Failed to create JSONEval instance from snapshot: {}", e);
+            eprintln!("[FFI ERROR] json_eval_new_from_snapshot: {}", error_msg);
+            ptr::null_mut()
+        }
+    }
+}
+
 /// Create a new JSONEval instance
 ///
 /// # Safety
@@ -141,6 +215,7 @@ pub unsafe extern "C" fn json_eval_new(
             let handle = Box::new(JSONEvalHandle {
                 inner: Box::new(eval),
                 current_token: None,
+                pool_key: None,
             });
             Box::into_raw(handle)
         }
@@ -229,6 +304,7 @@ pub unsafe extern "C" fn json_eval_new_with_error(
             let handle = Box::new(JSONEvalHandle {
                 inner: Box::new(eval),
                 current_token: None,
+                pool_key: None,
             });
             Box::into_raw(handle)
         }
@@ -460,6 +536,7 @@ pub unsafe extern "C" fn json_eval_new_from_cache(
             let handle = Box::new(JSONEvalHandle {
                 inner: Box::new(eval),
                 current_token: None,
+                pool_key: None,
             });
             Box::into_raw(handle)
         }
@@ -565,6 +642,7 @@ pub unsafe extern "C" fn json_eval_new_from_cache_with_error(
             let handle = Box::new(JSONEvalHandle {
                 inner: Box::new(eval),
                 current_token: None,
+                pool_key: None,
             });
             Box::into_raw(handle)
         }
@@ -64,6 +64,68 @@ pub unsafe extern "C" fn json_eval_evaluate(
     }
 }
 
+/// Patch individual data fields in place and re-evaluate
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from json_eval_new
+/// - patches_json must be a valid null-terminated UTF-8 string containing either an
+///   object of path -> value or an array of [path, value] pairs
+/// - Caller must call json_eval_free_result when done with the result
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_set_values(
+    handle: *mut JSONEvalHandle,
+    patches_json: *const c_char,
+) -> FFIResult {
+    if handle.is_null() || patches_json.is_null() {
+        return FFIResult::error("Invalid handle or patches pointer".to_string());
+    }
+
+    let handle_ref = &mut *handle;
+    let token = handle_ref.reset_token();
+    let eval = &mut handle_ref.inner;
+
+    let patches_str = match CStr::from_ptr(patches_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in patches".to_string()),
+    };
+
+    match eval.set_values_json(patches_str, token.as_ref()) {
+        Ok(_) => FFIResult::success(Vec::new()),
+        Err(e) => FFIResult::error(e),
+    }
+}
+
+/// Patch individual data fields in place from MessagePack-encoded patches and re-evaluate
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from json_eval_new
+/// - patches must point to `patches_len` bytes of MessagePack encoding either a map of
+///   path -> value or an array of [path, value] pairs
+/// - Caller must call json_eval_free_result when done with the result
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_set_values_msgpack(
+    handle: *mut JSONEvalHandle,
+    patches: *const u8,
+    patches_len: usize,
+) -> FFIResult {
+    if handle.is_null() || patches.is_null() {
+        return FFIResult::error("Invalid handle or patches pointer".to_string());
+    }
+
+    let handle_ref = &mut *handle;
+    let token = handle_ref.reset_token();
+    let eval = &mut handle_ref.inner;
+
+    let patches_bytes = std::slice::from_raw_parts(patches, patches_len);
+
+    match eval.set_values_msgpack(patches_bytes, token.as_ref()) {
+        Ok(_) => FFIResult::success(Vec::new()),
+        Err(e) => FFIResult::error(e),
+    }
+}
+
 /// Validate data against schema rules
 ///
 /// # Safety
@@ -87,6 +87,91 @@ pub unsafe extern "C" fn json_eval_validate_paths(
     }
 }
 
+/// Validate like `json_eval_validate_paths`, returning only the changes since the
+/// previous validation: `{ "hasError", "changed": { path: error }, "cleared": [path] }`
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from json_eval_new
+/// - data must be a valid null-terminated UTF-8 string
+/// - paths_json can be NULL for no filtering, or a JSON array string
+/// - Caller must call json_eval_free_result when done
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_validate_delta(
+    handle: *mut JSONEvalHandle,
+    data: *const c_char,
+    context: *const c_char,
+    paths_json: *const c_char,
+) -> FFIResult {
+    if handle.is_null() || data.is_null() {
+        return FFIResult::error("Invalid handle or data pointer".to_string());
+    }
+
+    let handle_ref = &mut *handle;
+    let token = handle_ref.reset_token();
+    let eval = &mut handle_ref.inner;
+
+    let data_str = match CStr::from_ptr(data).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in data".to_string()),
+    };
+
+    let context_str = if !context.is_null() {
+        match CStr::from_ptr(context).to_str() {
+            Ok(s) => Some(s),
+            Err(_) => return FFIResult::error("Invalid UTF-8 in context".to_string()),
+        }
+    } else {
+        None
+    };
+
+    let paths: Option<Vec<String>> = if !paths_json.is_null() {
+        let paths_str = match CStr::from_ptr(paths_json).to_str() {
+            Ok(s) => s,
+            Err(_) => return FFIResult::error("Invalid UTF-8 in paths".to_string()),
+        };
+
+        match serde_json::from_str(paths_str) {
+            Ok(p) => Some(p),
+            Err(_) => return FFIResult::error("Invalid JSON array for paths".to_string()),
+        }
+    } else {
+        None
+    };
+
+    let paths_ref = paths.as_ref().map(|v| v.as_slice());
+
+    match eval.validate_delta(data_str, context_str, paths_ref, token.as_ref()) {
+        Ok(delta) => {
+            let mut changed_map = serde_json::Map::new();
+            for (path, err) in &delta.changed {
+                changed_map.insert(
+                    path.clone(),
+                    serde_json::json!({
+                    "path": path,
+                    "type": err.rule_type,
+                    "message": err.message,
+                    "code": err.code,
+                    "pattern": err.pattern,
+                    "fieldValue": err.field_value,
+                    "data": err.data,
+                    }),
+                );
+            }
+
+            let result_json = serde_json::json!({
+                "hasError": delta.has_error,
+                "changed": changed_map,
+                "cleared": delta.cleared,
+            });
+
+            let result_bytes = serde_json::to_vec(&result_json).unwrap_or_default();
+            FFIResult::success(result_bytes)
+        }
+        Err(e) => FFIResult::error(e),
+    }
+}
+
 /// Resolve layout and return overlay entries
 ///
 /// Returns JSON array of LayoutOverlayEntry objects
@@ -2,11 +2,13 @@
 //!
 //! This module provides a C-compatible API for the JSON evaluation library.
 
+pub mod batch;
 pub mod compiled_logic;
 pub mod core;
 pub mod evaluation;
 pub mod layout;
 pub mod parsed_cache;
+pub mod pool;
 pub mod schema;
 pub mod subforms;
 pub mod types;
@@ -16,10 +18,12 @@ pub use parsed_cache::ParsedSchemaCacheHandle;
 pub use types::{FFIResult, JSONEvalHandle};
 
 // Re-export all functions for backward compatibility
+pub use batch::*;
 pub use compiled_logic::*;
 pub use core::*;
 pub use evaluation::*;
 pub use layout::*;
 pub use parsed_cache::*;
+pub use pool::*;
 pub use schema::*;
 pub use subforms::*;
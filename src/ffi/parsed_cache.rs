@@ -1,7 +1,7 @@
 //! FFI functions for ParsedSchemaCache management
 
 use super::types::FFIResult;
-use crate::{ParsedSchema, ParsedSchemaCache};
+use crate::{ParsedSchema, ParsedSchemaCache, ParsedSchemaCacheCapacity};
 use std::ffi::CStr;
 use std::os::raw::c_char;
 use std::ptr;
@@ -118,6 +118,79 @@ pub unsafe extern "C" fn parsed_cache_insert_msgpack(
     }
 }
 
+/// Insert a schema restored from a ParsedSchema snapshot into the cache
+///
+/// The snapshot must have been written by the same library version
+/// (see parsed_cache_snapshot). No schema parsing or formula compilation runs.
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from parsed_cache_new or parsed_cache_global
+/// - key must be a valid null-terminated UTF-8 string
+/// - snapshot must be a valid pointer to snapshot bytes (may be memory-mapped)
+/// - snapshot_len must be the exact length of the snapshot
+#[no_mangle]
+pub unsafe extern "C" fn parsed_cache_insert_snapshot(
+    handle: *mut ParsedSchemaCacheHandle,
+    key: *const c_char,
+    snapshot: *const u8,
+    snapshot_len: usize,
+) -> FFIResult {
+    if handle.is_null() || key.is_null() || snapshot.is_null() || snapshot_len == 0 {
+        return FFIResult::error("Invalid pointer or length".to_string());
+    }
+
+    let cache = &mut (*handle).inner;
+
+    let key_str = match CStr::from_ptr(key).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in key".to_string()),
+    };
+
+    let snapshot_bytes = std::slice::from_raw_parts(snapshot, snapshot_len);
+
+    match ParsedSchema::from_snapshot(snapshot_bytes) {
+        Ok(parsed) => {
+            cache.insert(key_str.to_string(), Arc::new(parsed));
+            FFIResult::success(Vec::new())
+        }
+        Err(e) => FFIResult::error(format!("Failed to load schema snapshot: {}", e)),
+    }
+}
+
+/// Write the snapshot of a cached schema, for later use with
+/// parsed_cache_insert_snapshot or json_eval_new_from_snapshot
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from parsed_cache_new or parsed_cache_global
+/// - key must be a valid null-terminated UTF-8 string
+/// - Returns the snapshot bytes, caller must free with json_eval_free_result
+#[no_mangle]
+pub unsafe extern "C" fn parsed_cache_snapshot(
+    handle: *const ParsedSchemaCacheHandle,
+    key: *const c_char,
+) -> FFIResult {
+    if handle.is_null() || key.is_null() {
+        return FFIResult::error("Invalid pointer".to_string());
+    }
+
+    let cache = &(*handle).inner;
+
+    let key_str = match CStr::from_ptr(key).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in key".to_string()),
+    };
+
+    match cache.get(key_str) {
+        Some(parsed) => match parsed.to_snapshot() {
+            Ok(bytes) => FFIResult::success(bytes),
+            Err(e) => FFIResult::error(e),
+        },
+        None => FFIResult::error(format!("Schema '{}' not found in cache", key_str)),
+    }
+}
+
 /// Get a cached schema by key
 ///
 /// # Safety
@@ -258,7 +331,62 @@ pub unsafe extern "C" fn parsed_cache_is_empty(handle: *const ParsedSchemaCacheH
     }
 }
 
-/// Get cache statistics (entry count and keys)
+/// Bound the cache by entry count and/or estimated bytes (0 means unbounded)
+///
+/// Least recently used unpinned entries are evicted to stay within the limits.
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from parsed_cache_new or parsed_cache_global
+#[no_mangle]
+pub unsafe extern "C" fn parsed_cache_set_capacity(
+    handle: *const ParsedSchemaCacheHandle,
+    max_entries: usize,
+    max_bytes: usize,
+) {
+    if handle.is_null() {
+        return;
+    }
+
+    let cache = &(*handle).inner;
+    cache.set_capacity(ParsedSchemaCacheCapacity {
+        max_entries: (max_entries > 0).then_some(max_entries),
+        max_bytes: (max_bytes > 0).then_some(max_bytes),
+    });
+}
+
+/// Pin (pinned != 0) or unpin a cached schema; pinned entries are never evicted
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from parsed_cache_new or parsed_cache_global
+/// - key must be a valid null-terminated UTF-8 string
+/// - Returns 1 if the key exists, 0 otherwise
+#[no_mangle]
+pub unsafe extern "C" fn parsed_cache_pin(
+    handle: *const ParsedSchemaCacheHandle,
+    key: *const c_char,
+    pinned: i32,
+) -> i32 {
+    if handle.is_null() || key.is_null() {
+        return 0;
+    }
+
+    let cache = &(*handle).inner;
+
+    let key_str = match CStr::from_ptr(key).to_str() {
+        Ok(s) => s,
+        Err(_) => return 0,
+    };
+
+    if cache.set_pinned(key_str, pinned != 0) {
+        1
+    } else {
+        0
+    }
+}
+
+/// Get cache statistics (entries, size, limits and hit/miss/eviction counters)
 ///
 /// # Safety
 ///
@@ -276,6 +404,13 @@ pub unsafe extern "C" fn parsed_cache_stats(handle: *const ParsedSchemaCacheHand
     let stats_json = serde_json::json!({
         "entry_count": stats.entry_count,
         "keys": stats.keys,
+        "total_bytes": stats.total_bytes,
+        "pinned_count": stats.pinned_count,
+        "max_entries": stats.max_entries,
+        "max_bytes": stats.max_bytes,
+        "hits": stats.hits,
+        "misses": stats.misses,
+        "evictions": stats.evictions,
     });
 
     let result_bytes = serde_json::to_vec(&stats_json).unwrap_or_default();
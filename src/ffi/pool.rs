@@ -0,0 +1,116 @@
+//! FFI functions for the JSONEval instance pool
+
+use super::types::JSONEvalHandle;
+use std::ffi::CStr;
+use std::os::raw::c_char;
+use std::ptr;
+
+/// Take a JSONEval instance for a cached ParsedSchema from the global pool
+///
+/// The instance is reset to `context` and `data`, or built like
+/// json_eval_new_from_cache when the pool holds none for `cache_key`.
+///
+/// # Safety
+///
+/// - cache_key must be a valid null-terminated UTF-8 string
+/// - context and data can be NULL
+/// - Returns non-null handle on success, null on failure
+/// - Caller must call json_eval_pool_release (or json_eval_free) when done
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_pool_acquire(
+    cache_key: *const c_char,
+    context: *const c_char,
+    data: *const c_char,
+) -> *mut JSONEvalHandle {
+    if cache_key.is_null() {
+        eprintln!("[FFI ERROR] json_eval_pool_acquire: cache_key pointer is null");
+        return ptr::null_mut();
+    }
+
+    let key_str = match CStr::from_ptr(cache_key).to_str() {
+        Ok(s) => s,
+        Err(e) => {
+            eprintln!(
+                "[FFI ERROR] json_eval_pool_acquire: invalid UTF-8 in cache_key: {}",
+                e
+            );
+            return ptr::null_mut();
+        }
+    };
+
+    let context_str = if !context.is_null() {
+        match CStr::from_ptr(context).to_str() {
+            Ok(s) => Some(s),
+            Err(e) => {
+                eprintln!(
+                    "[FFI ERROR] json_eval_pool_acquire: invalid UTF-8 in context: {}",
+                    e
+                );
+                return ptr::null_mut();
+            }
+        }
+    } else {
+        None
+    };
+
+    let data_str = if !data.is_null() {
+        match CStr::from_ptr(data).to_str() {
+            Ok(s) => Some(s),
+            Err(e) => {
+                eprintln!(
+                    "[FFI ERROR] json_eval_pool_acquire: invalid UTF-8 in data: {}",
+                    e
+                );
+                return ptr::null_mut();
+            }
+        }
+    } else {
+        None
+    };
+
+    match crate::JSON_EVAL_POOL.acquire(key_str, context_str, data_str) {
+        Ok(eval) => {
+            let handle = Box::new(JSONEvalHandle {
+                inner: Box::new(eval),
+                current_token: None,
+                pool_key: Some(key_str.to_string()),
+            });
+            Box::into_raw(handle)
+        }
+        Err(e) => {
+            eprintln!("[FFI ERROR] json_eval_pool_acquire: {}", e);
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Return an instance to the global pool, or free it
+///
+/// Handles from json_eval_pool_acquire go back to the pool for their cache key;
+/// any other handle is freed as by json_eval_free.
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from a json_eval_new* or json_eval_pool_acquire call, or NULL
+/// - handle must not be used after this call
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_pool_release(handle: *mut JSONEvalHandle) {
+    if handle.is_null() {
+        return;
+    }
+    let mut handle = *Box::from_raw(handle);
+    if let Some(token) = handle.current_token.take() {
+        token.cancel();
+    }
+    if let Some(key) = handle.pool_key.take() {
+        crate::JSON_EVAL_POOL.release(&key, *handle.inner);
+    }
+}
+
+/// Drop every idle instance held by the global pool
+///
+/// Handles currently acquired are unaffected and may still be released.
+#[no_mangle]
+pub extern "C" fn json_eval_pool_clear() {
+    crate::JSON_EVAL_POOL.clear();
+}
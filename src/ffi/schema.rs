@@ -1,6 +1,7 @@
 //! FFI schema getter functions
 
 use super::types::{FFIResult, JSONEvalHandle};
+use crate::jsoneval::output_cache::OutputKind;
 use std::ffi::CStr;
 use std::os::raw::c_char;
 
@@ -17,10 +18,10 @@ pub unsafe extern "C" fn json_eval_get_evaluated_schema(handle: *mut JSONEvalHan
     }
 
     let eval = &mut (*handle).inner;
-    let result = eval.get_evaluated_schema();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-
-    FFIResult::success(result_bytes)
+    match eval.get_output_bytes(OutputKind::EvaluatedSchema) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get the evaluated schema in MessagePack format (compact, without $layout resolution)
@@ -49,8 +50,8 @@ pub unsafe extern "C" fn json_eval_get_evaluated_schema_msgpack(
     }
 
     let eval = &mut (*handle).inner;
-    match eval.get_evaluated_schema_msgpack() {
-        Ok(msgpack_bytes) => FFIResult::success(msgpack_bytes),
+    match eval.get_output_bytes(OutputKind::EvaluatedSchemaMsgpack) {
+        Ok(bytes) => FFIResult::shared(bytes),
         Err(e) => FFIResult::error(e),
     }
 }
@@ -73,12 +74,30 @@ pub unsafe extern "C" fn json_eval_get_evaluated_schema_resolved_msgpack(
     }
 
     let eval = &mut (*handle).inner;
-    match eval.get_evaluated_schema_resolved_msgpack() {
-        Ok(msgpack_bytes) => FFIResult::success(msgpack_bytes),
+    match eval.get_output_bytes(OutputKind::EvaluatedSchemaResolvedMsgpack) {
+        Ok(bytes) => FFIResult::shared(bytes),
         Err(e) => FFIResult::error(e),
     }
 }
 
+/// Get the output generation of an instance
+///
+/// The value changes whenever an operation may have changed what the getters return.
+/// Getters called at the same generation share one cached serialized result, so a
+/// caller can also skip fetching outputs whose generation it has already seen.
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from json_eval_new
+/// - Returns 0 for a null handle
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_output_generation(handle: *mut JSONEvalHandle) -> u64 {
+    if handle.is_null() {
+        return 0;
+    }
+    (*handle).inner.output_generation()
+}
+
 /// Get all schema values (evaluations ending with .value)
 ///
 /// # Safety
@@ -92,10 +111,10 @@ pub unsafe extern "C" fn json_eval_get_schema_value(handle: *mut JSONEvalHandle)
     }
 
     let eval = &mut (*handle).inner;
-    let result = eval.get_schema_value();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-
-    FFIResult::success(result_bytes)
+    match eval.get_output_bytes(OutputKind::SchemaValue) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get all schema values as array of path-value pairs
@@ -113,11 +132,11 @@ pub unsafe extern "C" fn json_eval_get_schema_value_array(
         return FFIResult::error("Invalid handle pointer".to_string());
     }
 
-    let eval = &(*handle).inner;
-    let result = eval.get_schema_value_array();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-
-    FFIResult::success(result_bytes)
+    let eval = &mut (*handle).inner;
+    match eval.get_output_bytes(OutputKind::SchemaValueArray) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get all schema values as object with dotted path keys
@@ -135,11 +154,11 @@ pub unsafe extern "C" fn json_eval_get_schema_value_object(
         return FFIResult::error("Invalid handle pointer".to_string());
     }
 
-    let eval = &(*handle).inner;
-    let result = eval.get_schema_value_object();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-
-    FFIResult::success(result_bytes)
+    let eval = &mut (*handle).inner;
+    match eval.get_output_bytes(OutputKind::SchemaValueObject) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get the evaluated schema without $params field (compact, without $layout resolution)
@@ -157,10 +176,10 @@ pub unsafe extern "C" fn json_eval_get_evaluated_schema_without_params(
     }
 
     let eval = &mut (*handle).inner;
-    let result = eval.get_evaluated_schema_without_params();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-
-    FFIResult::success(result_bytes)
+    match eval.get_output_bytes(OutputKind::EvaluatedSchemaWithoutParams) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get a value from the evaluated schema using dotted path notation (compact, without $layout resolution)
@@ -328,9 +347,10 @@ pub unsafe extern "C" fn json_eval_get_resolved_layout(handle: *mut JSONEvalHand
     }
 
     let eval = &mut (*handle).inner;
-    let result = eval.get_resolved_layout();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-    FFIResult::success(result_bytes)
+    match eval.get_output_bytes(OutputKind::ResolvedLayout) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Get the evaluated schema with $layout resolution merged in
@@ -349,9 +369,10 @@ pub unsafe extern "C" fn json_eval_get_evaluated_schema_resolved(
     }
 
     let eval = &mut (*handle).inner;
-    let result = eval.get_evaluated_schema_resolved();
-    let result_bytes = serde_json::to_vec(&result).unwrap_or_default();
-    FFIResult::success(result_bytes)
+    match eval.get_output_bytes(OutputKind::EvaluatedSchemaResolved) {
+        Ok(bytes) => FFIResult::shared(bytes),
+        Err(e) => FFIResult::error(e),
+    }
 }
 
 /// Evaluate and return the options for a specific field on demand.
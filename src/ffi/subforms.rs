@@ -72,6 +72,54 @@ pub unsafe extern "C" fn json_eval_evaluate_subform(
     }
 }
 
+/// Evaluate every item of a subform array, on worker threads where available
+///
+/// # Safety
+///
+/// - handle must be a valid pointer from json_eval_new
+/// - subform_path must be a valid null-terminated UTF-8 string
+/// - data must be a valid null-terminated UTF-8 string (the full parent payload)
+/// - context can be NULL
+#[no_mangle]
+pub unsafe extern "C" fn json_eval_evaluate_subform_items(
+    handle: *mut JSONEvalHandle,
+    subform_path: *const c_char,
+    data: *const c_char,
+    context: *const c_char,
+) -> FFIResult {
+    if handle.is_null() || subform_path.is_null() || data.is_null() {
+        return FFIResult::error("Invalid pointer".to_string());
+    }
+
+    let handle_ref = &mut *handle;
+    let token = handle_ref.reset_token();
+    let eval = &mut handle_ref.inner;
+
+    let path_str = match CStr::from_ptr(subform_path).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in subform_path".to_string()),
+    };
+
+    let data_str = match CStr::from_ptr(data).to_str() {
+        Ok(s) => s,
+        Err(_) => return FFIResult::error("Invalid UTF-8 in data".to_string()),
+    };
+
+    let context_str = if !context.is_null() {
+        match CStr::from_ptr(context).to_str() {
+            Ok(s) => Some(s),
+            Err(_) => return FFIResult::error("Invalid UTF-8 in context".to_string()),
+        }
+    } else {
+        None
+    };
+
+    match eval.evaluate_subform_items(path_str, data_str, context_str, token.as_ref()) {
+        Ok(_) => FFIResult::success(Vec::new()),
+        Err(e) => FFIResult::error(e),
+    }
+}
+
 /// Validate subform data against its schema rules
 ///
 /// # Safety
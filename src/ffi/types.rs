@@ -4,6 +4,7 @@ use crate::JSONEval;
 use std::ffi::CString;
 use std::os::raw::c_char;
 use std::ptr;
+use std::sync::Arc;
 
 use crate::jsoneval::cancellation::CancellationToken;
 
@@ -11,6 +12,8 @@ use crate::jsoneval::cancellation::CancellationToken;
 pub struct JSONEvalHandle {
     pub(super) inner: Box<JSONEval>,
     pub(super) current_token: Option<CancellationToken>,
+    /// Cache key of the pool the instance goes back to on `json_eval_pool_release`
+    pub(super) pool_key: Option<String>,
 }
 
 impl JSONEvalHandle {
@@ -30,7 +33,8 @@ impl JSONEvalHandle {
 ///
 /// This structure implements true zero-copy data transfer across the FFI boundary:
 ///
-/// 1. **Rust Side**: Serialized data (JSON/MessagePack) is allocated in a Vec<u8>
+/// 1. **Rust Side**: Serialized data (JSON/MessagePack) is allocated in a Vec<u8>,
+///    or shared from a cached getter output (`Arc<[u8]>`, see [`FFIResult::shared`])
 /// 2. **Boxing**: Vec is boxed and converted to raw pointer via Box::into_raw()
 /// 3. **Transfer**: Raw pointer and length are passed to caller (NO COPY)
 /// 4. **Caller Side**: Reads data directly from Rust-owned memory (NO COPY)
@@ -55,7 +59,18 @@ pub struct FFIResult {
     pub data_len: usize,
     pub error: *mut c_char,
     // Internal pointer to owned data for cleanup
-    pub(super) _owned_data: *mut Vec<u8>,
+    pub(super) _owned_data: *mut FFIOwnedData,
+}
+
+/// Bytes kept alive for an [`FFIResult`] until `json_eval_free_result`
+///
+/// The payloads are never read back: `data_ptr` points into them and they are
+/// only held so that dropping the variant releases the bytes.
+#[allow(dead_code)]
+pub(super) enum FFIOwnedData {
+    Bytes(Vec<u8>),
+    /// Cached output shared with the instance; freeing only drops this reference
+    Shared(Arc<[u8]>),
 }
 
 impl Default for FFIResult {
@@ -72,15 +87,28 @@ impl Default for FFIResult {
 
 impl FFIResult {
     pub fn success(data: Vec<u8>) -> Self {
-        let boxed_data = Box::new(data);
-        let data_ptr = boxed_data.as_ptr();
-        let data_len = boxed_data.len();
+        let data_ptr = data.as_ptr();
+        let data_len = data.len();
+        Self {
+            success: true,
+            data_ptr,
+            data_len,
+            error: ptr::null_mut(),
+            _owned_data: Box::into_raw(Box::new(FFIOwnedData::Bytes(data))),
+        }
+    }
+
+    /// Success result pointing into shared bytes (e.g. a cached getter output)
+    /// without copying them
+    pub fn shared(data: Arc<[u8]>) -> Self {
+        let data_ptr = data.as_ptr();
+        let data_len = data.len();
         Self {
             success: true,
             data_ptr,
             data_len,
             error: ptr::null_mut(),
-            _owned_data: Box::into_raw(boxed_data),
+            _owned_data: Box::into_raw(Box::new(FFIOwnedData::Shared(data))),
         }
     }
 
@@ -0,0 +1,164 @@
+//! Bulk evaluation of many data records against one parsed schema.
+//!
+//! [`evaluate_batch`] runs records through a pool of worker threads. Each worker
+//! owns one [`BatchWorker`]: a `JSONEval` built once from the shared
+//! [`ParsedSchema`] and reused for every record it takes, so the evaluator is
+//! reset with new data instead of being rebuilt per record. Only the requested
+//! output paths are copied out of the evaluated schema.
+
+use std::sync::{Arc, Mutex};
+
+use once_cell::sync::Lazy;
+use serde_json::Value;
+
+use super::JSONEval;
+use crate::jsoneval::parsed_schema::ParsedSchema;
+use crate::jsoneval::types::ReturnFormat;
+use crate::jsoneval::worker_guard;
+use crate::time_block;
+
+/// Upper bound on worker threads for batch evaluation.
+///
+/// Defaults to the available parallelism; `JSONEVAL_BATCH_THREADS` overrides it
+/// (`1` evaluates records one after another).
+static BATCH_WORKER_LIMIT: Lazy<usize> = Lazy::new(|| {
+    std::env::var("JSONEVAL_BATCH_THREADS")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .filter(|&n| n > 0)
+        .unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+});
+
+/// Number of batch workers, capped by `records` when the record count is known.
+/// A batch started from an evaluation worker thread runs on that thread.
+#[inline]
+pub fn batch_workers(records: Option<usize>) -> usize {
+    if cfg!(target_arch = "wasm32") || worker_guard::in_eval_worker() {
+        return 1;
+    }
+    match records {
+        Some(n) => n.clamp(1, *BATCH_WORKER_LIMIT),
+        None => *BATCH_WORKER_LIMIT,
+    }
+}
+
+/// Reusable evaluator for one batch worker
+pub struct BatchWorker {
+    eval: JSONEval,
+    output_paths: Vec<String>,
+}
+
+impl BatchWorker {
+    /// Create a worker evaluating against `parsed`. With empty `output_paths` each
+    /// record yields the whole evaluated schema.
+    pub fn new(parsed: Arc<ParsedSchema>, output_paths: &[String]) -> Result<Self, String> {
+        let eval = JSONEval::with_parsed_schema(parsed, None, None)?;
+        Ok(Self {
+            eval,
+            output_paths: output_paths.to_vec(),
+        })
+    }
+
+    /// Evaluate one record and return the requested outputs as a flat
+    /// `{ path: value }` object.
+    ///
+    /// The evaluator is reset before every record, so nothing from an earlier
+    /// record (data keys, cached results, partial state after a failure) reaches
+    /// the next one. The reset restores the schema in place and clears caches
+    /// without freeing them, which is what makes reuse cheaper than a rebuild.
+    pub fn evaluate(&mut self, record: Value) -> Result<Value, String> {
+        let empty = || Value::Object(serde_json::Map::new());
+        self.eval.reset_values(empty(), empty());
+        self.eval
+            .evaluate_internal_with_new_data(record, empty(), None, None)?;
+        if self.output_paths.is_empty() {
+            Ok(self.eval.get_evaluated_schema())
+        } else {
+            Ok(self
+                .eval
+                .get_evaluated_schema_by_paths(&self.output_paths, Some(ReturnFormat::Flat)))
+        }
+    }
+}
+
+/// Evaluate every record against `parsed` on a pool of worker threads.
+///
+/// Results come back in record order, one per record; a failed record does not
+/// stop the others. See [`BatchWorker::evaluate`] for the shape of each result.
+pub fn evaluate_batch<I>(
+    parsed: Arc<ParsedSchema>,
+    records: I,
+    output_paths: &[String],
+) -> Vec<Result<Value, String>>
+where
+    I: IntoIterator<Item = Value>,
+    I::IntoIter: Send,
+{
+    let records = records.into_iter();
+    let (lower, upper) = records.size_hint();
+    let workers = batch_workers(upper.or(Some(lower)).filter(|&n| n > 0));
+
+    if workers <= 1 {
+        let mut worker = match BatchWorker::new(parsed, output_paths) {
+            Ok(worker) => worker,
+            Err(e) => return records.map(|_| Err(e.clone())).collect(),
+        };
+        return records.map(|record| worker.evaluate(record)).collect();
+    }
+
+    time_block!("evaluate_batch() [parallel]", {
+        // Workers pull the next record as they finish the previous one, so slow
+        // records do not hold up a whole chunk
+        let queue = Mutex::new((0usize, records));
+        let indexed: Vec<(usize, Result<Value, String>)> = std::thread::scope(|s| {
+            let handles: Vec<_> = (0..workers)
+                .map(|_| {
+                    let queue = &queue;
+                    let parsed = Arc::clone(&parsed);
+                    s.spawn(move || {
+                        worker_guard::enter_eval_worker();
+                        let mut worker = BatchWorker::new(parsed, output_paths);
+                        let mut out = Vec::new();
+                        loop {
+                            let next = {
+                                let mut queue = queue.lock().unwrap_or_else(|e| e.into_inner());
+                                let (taken, records) = &mut *queue;
+                                records.next().map(|record| {
+                                    *taken += 1;
+                                    (*taken - 1, record)
+                                })
+                            };
+                            let Some((idx, record)) = next else { break };
+                            let result = match &mut worker {
+                                Ok(worker) => worker.evaluate(record),
+                                Err(e) => Err(e.clone()),
+                            };
+                            out.push((idx, result));
+                        }
+                        out
+                    })
+                })
+                .collect();
+            handles
+                .into_iter()
+                .flat_map(|handle| handle.join().unwrap_or_default())
+                .collect()
+        });
+
+        // Records taken by a panicked worker have no result
+        let (taken, _) = queue.into_inner().unwrap_or_else(|e| e.into_inner());
+        let mut results: Vec<Option<Result<Value, String>>> = Vec::new();
+        results.resize_with(taken, || None);
+        for (idx, result) in indexed {
+            results[idx] = Some(result);
+        }
+        results
+            .into_iter()
+            .map(|r| r.unwrap_or_else(|| Err("Batch worker panicked".to_string())))
+            .collect()
+    })
+}
@@ -1,8 +1,10 @@
 use super::JSONEval;
+use crate::jsoneval::eval_cache::EvalCache;
 use crate::jsoneval::eval_data::EvalData;
 use crate::jsoneval::json_parser;
 use crate::jsoneval::parsed_schema::ParsedSchema;
 use crate::jsoneval::parsed_schema_cache::PARSED_SCHEMA_CACHE;
+use crate::jsoneval::path_id::PathTable;
 use crate::parse_schema;
 use crate::rlogic::{RLogic, RLogicConfig};
 
@@ -11,8 +13,7 @@ use crate::time_block;
 use indexmap::IndexMap;
 use serde::de::Error as _;
 use serde_json::Value;
-use std::collections::HashMap;
-use std::sync::{Arc, Mutex, RwLock};
+use std::sync::{Arc, Mutex};
 
 impl Clone for JSONEval {
     fn clone(&self) -> Self {
@@ -23,6 +24,7 @@ impl Clone for JSONEval {
             tables: self.tables.clone(),
             table_metadata: self.table_metadata.clone(),
             dependencies: self.dependencies.clone(),
+            dependency_ids: self.dependency_ids.clone(),
             sorted_evaluations: self.sorted_evaluations.clone(),
             dependents_evaluations: self.dependents_evaluations.clone(),
             rules_evaluations: self.rules_evaluations.clone(),
@@ -31,6 +33,7 @@ impl Clone for JSONEval {
             value_evaluations: self.value_evaluations.clone(),
             layout_paths: self.layout_paths.clone(),
             layout_field_refs: self.layout_field_refs.clone(),
+            layout_dependencies: self.layout_dependencies.clone(),
             options_templates: self.options_templates.clone(),
             subforms: self.subforms.clone(),
             reffed_by: self.reffed_by.clone(),
@@ -43,10 +46,12 @@ impl Clone for JSONEval {
             eval_lock: Mutex::new(()), // Create fresh mutex for the clone
             cached_msgpack_schema: self.cached_msgpack_schema.clone(),
             resolved_layout_cache: None,
+            layout_state: Default::default(),
+            output_cache: Default::default(),
             conditional_hidden_fields: self.conditional_hidden_fields.clone(),
             conditional_readonly_fields: self.conditional_readonly_fields.clone(),
             static_arrays: self.static_arrays.clone(),
-            regex_cache: RwLock::new(HashMap::new()),
+            rule_patterns: Arc::clone(&self.rule_patterns),
             layout_hidden_refs: indexmap::IndexSet::new(),
             layout_visible_refs: indexmap::IndexSet::new(),
             layout_condition_hidden_refs: indexmap::IndexSet::new(),
@@ -97,6 +102,7 @@ impl JSONEval {
                     tables: Arc::new(IndexMap::new()),
                     table_metadata: Arc::new(IndexMap::new()),
                     dependencies: Arc::new(IndexMap::new()),
+                    dependency_ids: Arc::default(),
                     sorted_evaluations: Arc::new(Vec::new()),
                     dependents_evaluations: Arc::new(IndexMap::new()),
                     rules_evaluations: Arc::new(Vec::new()),
@@ -105,6 +111,7 @@ impl JSONEval {
                     value_evaluations: Arc::new(Vec::new()),
                     layout_paths: Arc::new(Vec::new()),
                     layout_field_refs: Arc::new(indexmap::IndexSet::new()),
+                    layout_dependencies: Arc::new(IndexMap::new()),
                     options_templates: Arc::new(Vec::new()),
                     subforms: IndexMap::new(),
                     engine: Arc::new(engine),
@@ -118,14 +125,16 @@ impl JSONEval {
                         &data,
                         &context,
                     ),
-                    eval_cache: crate::jsoneval::eval_cache::EvalCache::new(),
+                    eval_cache: EvalCache::new(),
                     eval_lock: Mutex::new(()),
                     cached_msgpack_schema: None,
                     resolved_layout_cache: None,
+                    layout_state: Default::default(),
+                    output_cache: Default::default(),
                     conditional_hidden_fields: Arc::new(Vec::new()),
                     conditional_readonly_fields: Arc::new(Vec::new()),
                     static_arrays,
-                    regex_cache: RwLock::new(HashMap::new()),
+                    rule_patterns: Default::default(),
                     layout_hidden_refs: indexmap::IndexSet::new(),
                     layout_visible_refs: indexmap::IndexSet::new(),
                     layout_condition_hidden_refs: indexmap::IndexSet::new(),
@@ -144,6 +153,7 @@ impl JSONEval {
         schema_val: Value,
         context: Value,
         static_arrays: Arc<IndexMap<String, Arc<Value>>>,
+        paths: Arc<PathTable>,
     ) -> Result<Self, serde_json::Error> {
         time_block!("JSONEval::new_subform() [total]", {
             // Data is empty for a subform initially
@@ -162,6 +172,7 @@ impl JSONEval {
                     tables: Arc::new(IndexMap::new()),
                     table_metadata: Arc::new(IndexMap::new()),
                     dependencies: Arc::new(IndexMap::new()),
+                    dependency_ids: Arc::default(),
                     sorted_evaluations: Arc::new(Vec::new()),
                     dependents_evaluations: Arc::new(IndexMap::new()),
                     rules_evaluations: Arc::new(Vec::new()),
@@ -170,6 +181,7 @@ impl JSONEval {
                     value_evaluations: Arc::new(Vec::new()),
                     layout_paths: Arc::new(Vec::new()),
                     layout_field_refs: Arc::new(indexmap::IndexSet::new()),
+                    layout_dependencies: Arc::new(IndexMap::new()),
                     options_templates: Arc::new(Vec::new()),
                     subforms: IndexMap::new(),
                     engine: Arc::new(engine),
@@ -183,14 +195,16 @@ impl JSONEval {
                         &data,
                         &context,
                     ),
-                    eval_cache: crate::jsoneval::eval_cache::EvalCache::new(),
+                    eval_cache: EvalCache::with_paths(paths),
                     eval_lock: Mutex::new(()),
                     cached_msgpack_schema: None,
                     resolved_layout_cache: None,
+                    layout_state: Default::default(),
+                    output_cache: Default::default(),
                     conditional_hidden_fields: Arc::new(Vec::new()),
                     conditional_readonly_fields: Arc::new(Vec::new()),
                     static_arrays,
-                    regex_cache: RwLock::new(HashMap::new()),
+                    rule_patterns: Default::default(),
                     layout_hidden_refs: indexmap::IndexSet::new(),
                     layout_visible_refs: indexmap::IndexSet::new(),
                     layout_condition_hidden_refs: indexmap::IndexSet::new(),
@@ -254,6 +268,7 @@ impl JSONEval {
             tables: Arc::new(IndexMap::new()),
             table_metadata: Arc::new(IndexMap::new()),
             dependencies: Arc::new(IndexMap::new()),
+            dependency_ids: Arc::default(),
             sorted_evaluations: Arc::new(Vec::new()),
             dependents_evaluations: Arc::new(IndexMap::new()),
             rules_evaluations: Arc::new(Vec::new()),
@@ -262,6 +277,7 @@ impl JSONEval {
             value_evaluations: Arc::new(Vec::new()),
             layout_paths: Arc::new(Vec::new()),
             layout_field_refs: Arc::new(indexmap::IndexSet::new()),
+            layout_dependencies: Arc::new(IndexMap::new()),
             options_templates: Arc::new(Vec::new()),
             subforms: IndexMap::new(),
             engine: Arc::new(engine),
@@ -271,14 +287,16 @@ impl JSONEval {
             data: data.clone(),
             evaluated_schema: evaluated_schema.clone(),
             eval_data: EvalData::with_schema_data_context(&evaluated_schema, &data, &context),
-            eval_cache: crate::jsoneval::eval_cache::EvalCache::new(),
+            eval_cache: EvalCache::new(),
             eval_lock: Mutex::new(()),
             cached_msgpack_schema: Some(cached_msgpack),
             resolved_layout_cache: None,
+            layout_state: Default::default(),
+            output_cache: Default::default(),
             conditional_hidden_fields: Arc::new(Vec::new()),
             conditional_readonly_fields: Arc::new(Vec::new()),
             static_arrays,
-            regex_cache: RwLock::new(HashMap::new()),
+            rule_patterns: Default::default(),
             layout_hidden_refs: indexmap::IndexSet::new(),
             layout_visible_refs: indexmap::IndexSet::new(),
             layout_condition_hidden_refs: indexmap::IndexSet::new(),
@@ -346,6 +364,7 @@ impl JSONEval {
             tables: Arc::clone(&parsed.tables),
             table_metadata: Arc::clone(&parsed.table_metadata),
             dependencies: Arc::clone(&parsed.dependencies),
+            dependency_ids: Arc::clone(&parsed.dependency_ids),
             sorted_evaluations: Arc::clone(&parsed.sorted_evaluations),
             dependents_evaluations: Arc::clone(&parsed.dependents_evaluations),
             rules_evaluations: Arc::clone(&parsed.rules_evaluations),
@@ -354,6 +373,7 @@ impl JSONEval {
             value_evaluations: Arc::clone(&parsed.value_evaluations),
             layout_paths: Arc::clone(&parsed.layout_paths),
             layout_field_refs: Arc::clone(&parsed.layout_field_refs),
+            layout_dependencies: Arc::clone(&parsed.layout_dependencies),
             options_templates: Arc::clone(&parsed.options_templates),
             subforms,
             engine,
@@ -363,14 +383,16 @@ impl JSONEval {
             data: data.clone(),
             evaluated_schema: (*evaluated_schema).clone(),
             eval_data: EvalData::with_schema_data_context(&evaluated_schema, &data, &context),
-            eval_cache: crate::jsoneval::eval_cache::EvalCache::new(),
+            eval_cache: EvalCache::with_paths(Arc::clone(&parsed.paths)),
             eval_lock: Mutex::new(()),
             cached_msgpack_schema: None,
             resolved_layout_cache: None,
+            layout_state: Default::default(),
+            output_cache: Default::default(),
             conditional_hidden_fields: Arc::clone(&parsed.conditional_hidden_fields),
             conditional_readonly_fields: Arc::clone(&parsed.conditional_readonly_fields),
             static_arrays: Arc::clone(&parsed.static_arrays),
-            regex_cache: RwLock::new(HashMap::new()),
+            rule_patterns: Arc::clone(&parsed.rule_patterns),
             layout_hidden_refs: indexmap::IndexSet::new(),
             layout_visible_refs: indexmap::IndexSet::new(),
             layout_condition_hidden_refs: indexmap::IndexSet::new(),
@@ -413,6 +435,7 @@ impl JSONEval {
         self.tables = Arc::new(IndexMap::new());
         self.table_metadata = Arc::new(IndexMap::new());
         self.dependencies = Arc::new(IndexMap::new());
+        self.dependency_ids = Arc::default();
         self.sorted_evaluations = Arc::new(Vec::new());
         self.dependents_evaluations = Arc::new(IndexMap::new());
         self.rules_evaluations = Arc::new(Vec::new());
@@ -426,19 +449,19 @@ impl JSONEval {
         self.conditional_hidden_fields = Arc::new(Vec::new());
         self.conditional_readonly_fields = Arc::new(Vec::new());
         self.subforms.clear();
+        // Paths of the old schema go with its cache
+        self.eval_cache = EvalCache::new();
         parse_schema::legacy::parse_schema(self)?;
 
         // Re-initialize eval_data with new schema, data, and context
         self.eval_data =
             EvalData::with_schema_data_context(&self.evaluated_schema, &data, &context);
-        self.eval_cache.clear();
-        if let Ok(mut cache) = self.regex_cache.write() {
-            cache.clear();
-        }
 
         // Clear MessagePack cache since schema has been mutated
         self.cached_msgpack_schema = None;
         self.resolved_layout_cache = None;
+        self.layout_state = Default::default();
+        self.invalidate_outputs();
         self.layout_hidden_refs.clear();
         self.layout_visible_refs.clear();
         self.layout_condition_hidden_refs.clear();
@@ -481,6 +504,7 @@ impl JSONEval {
         self.engine = Arc::new(engine);
 
         let _ = parse_schema::legacy::parse_schema(self);
+        self.invalidate_outputs();
     }
 
     /// Reload schema from MessagePack-encoded bytes
@@ -530,6 +554,7 @@ impl JSONEval {
         self.tables = Arc::new(IndexMap::new());
         self.table_metadata = Arc::new(IndexMap::new());
         self.dependencies = Arc::new(IndexMap::new());
+        self.dependency_ids = Arc::default();
         self.sorted_evaluations = Arc::new(Vec::new());
         self.dependents_evaluations = Arc::new(IndexMap::new());
         self.rules_evaluations = Arc::new(Vec::new());
@@ -543,19 +568,19 @@ impl JSONEval {
         self.conditional_hidden_fields = Arc::new(Vec::new());
         self.conditional_readonly_fields = Arc::new(Vec::new());
         self.subforms.clear();
+        // Paths of the old schema go with its cache
+        self.eval_cache = EvalCache::new();
         parse_schema::legacy::parse_schema(self)?;
 
         // Re-initialize eval_data
         self.eval_data =
             EvalData::with_schema_data_context(&self.evaluated_schema, &data, &context);
-        self.eval_cache.clear();
-        if let Ok(mut cache) = self.regex_cache.write() {
-            cache.clear();
-        }
 
         // Cache the MessagePack for future retrievals
         self.cached_msgpack_schema = Some(schema_msgpack.to_vec());
         self.resolved_layout_cache = None;
+        self.layout_state = Default::default();
+        self.invalidate_outputs();
         self.layout_hidden_refs.clear();
         self.layout_visible_refs.clear();
         self.layout_condition_hidden_refs.clear();
@@ -591,6 +616,7 @@ impl JSONEval {
         self.tables = parsed.tables.clone();
         self.table_metadata = parsed.table_metadata.clone();
         self.dependencies = parsed.dependencies.clone();
+        self.dependency_ids = parsed.dependency_ids.clone();
         self.sorted_evaluations = parsed.sorted_evaluations.clone();
         self.dependents_evaluations = parsed.dependents_evaluations.clone();
         self.rules_evaluations = parsed.rules_evaluations.clone();
@@ -599,12 +625,14 @@ impl JSONEval {
         self.value_evaluations = parsed.value_evaluations.clone();
         self.layout_paths = parsed.layout_paths.clone();
         self.layout_field_refs = parsed.layout_field_refs.clone();
+        self.layout_dependencies = parsed.layout_dependencies.clone();
         self.options_templates = parsed.options_templates.clone();
         self.reffed_by = parsed.reffed_by.clone();
         self.dep_formula_triggers = parsed.dep_formula_triggers.clone();
         self.conditional_hidden_fields = parsed.conditional_hidden_fields.clone();
         self.conditional_readonly_fields = parsed.conditional_readonly_fields.clone();
         self.static_arrays = parsed.static_arrays.clone();
+        self.rule_patterns = parsed.rule_patterns.clone();
 
         // Share the engine Arc (cheap pointer clone, not data clone)
         self.engine = parsed.engine.clone();
@@ -625,15 +653,14 @@ impl JSONEval {
         // Re-initialize eval_data
         self.eval_data =
             EvalData::with_schema_data_context(&self.evaluated_schema, &data, &context);
-        self.eval_cache.clear();
+        self.eval_cache = EvalCache::with_paths(Arc::clone(&parsed.paths));
         self.engine.clear_indices();
-        if let Ok(mut cache) = self.regex_cache.write() {
-            cache.clear();
-        }
 
         // Clear MessagePack cache since we're loading from ParsedSchema
         self.cached_msgpack_schema = None;
         self.resolved_layout_cache = None;
+        self.layout_state = Default::default();
+        self.invalidate_outputs();
         self.layout_hidden_refs.clear();
         self.layout_visible_refs.clear();
         self.layout_condition_hidden_refs.clear();
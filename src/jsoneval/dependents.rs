@@ -32,6 +32,7 @@ impl JSONEval {
                 return Err("Cancelled".to_string());
             }
         }
+        self.invalidate_outputs();
         let _lock = self.eval_lock.lock().unwrap();
         let mut structural_change_data = None;
 
@@ -43,12 +44,12 @@ impl JSONEval {
             } else {
                 Value::Object(serde_json::Map::new())
             };
-            let old_data = self.eval_data.snapshot_data_clone();
+            let old_data = self.eval_data.snapshot_data();
             time_block!("  [dep] data_replace_and_context", {
                 self.eval_data
                     .replace_data_and_context(data_value, context_value);
             });
-            let new_data = self.eval_data.snapshot_data_clone();
+            let new_data = self.eval_data.snapshot_data();
             time_block!("  [dep] data_diff_versions", {
                 self.eval_cache
                     .store_snapshot_and_diff_versions(&old_data, &new_data);
@@ -249,8 +250,7 @@ impl JSONEval {
         // Only update when no subform item is active — subform evaluate_dependents calls
         // must not overwrite the parent's snapshot.
         if self.eval_cache.active_item_index.is_none() {
-            let current_snapshot = self.eval_data.snapshot_data_clone();
-            self.eval_cache.main_form_snapshot = Some(current_snapshot);
+            self.eval_cache.main_form_snapshot = Some(self.eval_data.snapshot_data());
         }
 
         Ok(Value::Array(deduped))
@@ -514,7 +514,7 @@ impl JSONEval {
         // Rebuild layout refs from current evaluated_schema. Unlike mutable legacy JS
         // objects, Rust resolved refs are copies, so inherited visibility must stay
         // per-run state rather than be written back into the source schema.
-        self.resolve_layout(false)?;
+        self.refresh_layout();
 
         let mut hidden_fields = Vec::new();
         for path in self.conditional_hidden_fields.iter() {
@@ -1145,18 +1145,14 @@ impl JSONEval {
                     &pre_diff_item_versions,
                     parent_cache.subform_caches.get(&idx),
                 ) {
-                    let field_prefix_slash = format!("/{}/", field_key);
-                    let newly_bumped: Vec<String> = c
+                    let newly_bumped = c
                         .data_versions
-                        .versions()
-                        .filter(|(k, &v)| k.starts_with(&field_prefix_slash) && v > pre.get(k))
-                        .map(|(k, _)| k.to_string())
-                        .collect();
+                        .newly_bumped_under(&format!("/{}", field_key), pre);
                     if !newly_bumped.is_empty() {
-                        for k in newly_bumped {
+                        for (id, _) in newly_bumped {
                             parent_cache
                                 .data_versions
-                                .bump(&k, "propagate_newly_bumped");
+                                .bump_id(id, "propagate_newly_bumped");
                         }
                         parent_cache.eval_generation += 1;
                     }
@@ -1168,19 +1164,19 @@ impl JSONEval {
                 // their formulas read subform-local paths like #/riders/properties/sa which
                 // only resolve correctly when the active item is injected under the riders key.
                 {
-                    let field_prefix_slash = format!("/{}/", field_key);
+                    let item_root = format!("/{}", field_key);
                     let newly_bumped_schema_paths: Vec<String> = if let (Some(ref pre), Some(c)) = (
                         &pre_diff_item_versions,
                         parent_cache.subform_caches.get(&idx),
                     ) {
                         c.data_versions
-                            .versions()
-                            .filter(|(k, &v)| k.starts_with(&field_prefix_slash) && v > pre.get(k))
-                            .map(|(k, _)| {
+                            .newly_bumped_under(&item_root, pre)
+                            .into_iter()
+                            .map(|(_, k)| {
                                 // Convert data-version path (e.g. /riders/sa) to schema dep
                                 // format (e.g. /riders/properties/sa) for dep matching against
                                 // self.dependencies, which stores paths WITHOUT the '#' prefix.
-                                let sub = k.trim_start_matches(&field_prefix_slash);
+                                let sub = &k[item_root.len() + 1..];
                                 format!(
                                     "/{}/properties/{}",
                                     field_key,
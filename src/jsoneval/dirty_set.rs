@@ -0,0 +1,250 @@
+//! Dirty-set driven re-evaluation.
+//!
+//! A full `evaluate_internal` pass visits every formula and validates its cache
+//! entry against the current dependency versions, even when one input changed.
+//! Once a pass has completed, the version counters it started from are kept as a
+//! [`CleanBaseline`]: every formula's cache entry is valid for those versions or
+//! newer ones. The next pass seeds a dirty set with the paths whose version moved
+//! since, and visits only the formulas reachable from them through [`EvalGraph`],
+//! in evaluation order. Bumps made while the pass runs (changed results) extend the
+//! dirty set to their readers, so the work is proportional to the affected cone.
+
+use std::cmp::Reverse;
+use std::collections::BinaryHeap;
+use std::sync::Arc;
+
+use indexmap::{IndexMap, IndexSet};
+use rapidhash::{HashMapExt, RapidHashMap};
+use smallvec::SmallVec;
+
+use crate::jsoneval::eval_cache::VersionTracker;
+use crate::jsoneval::path_id::{DependencyIds, PathId, PathTable};
+use crate::jsoneval::path_utils;
+use crate::jsoneval::table_metadata::TableMetadata;
+use crate::rlogic::LogicId;
+
+/// How `evaluate_internal` visits a formula
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum NodeKind {
+    /// Dependency-free entry of `value_evaluations`
+    Value,
+    /// Formula inside a `sorted_evaluations` batch
+    Batch,
+    /// Table inside a batch: validated by its own cache, visited on every pass
+    Table,
+}
+
+pub(crate) struct EvalNode {
+    pub key: String,
+    pub kind: NodeKind,
+}
+
+/// Reverse dependency graph over the formulas of one schema, in evaluation order
+pub(crate) struct EvalGraph {
+    /// The batches this graph was built from (identity check after a reload)
+    batches: Arc<Vec<Vec<String>>>,
+    pub nodes: Vec<EvalNode>,
+    /// Dependency path → nodes whose cache entry records its version
+    readers: RapidHashMap<PathId, SmallVec<[u32; 4]>>,
+    /// Output path → nodes whose stored value lives there
+    writers: RapidHashMap<PathId, SmallVec<[u32; 2]>>,
+    tables: Vec<u32>,
+    /// Field `value` formulas whose results the computed-value refresh overlays:
+    /// index into `evaluations` and the data path of the field
+    pub computed_values: Vec<(u32, String)>,
+    /// Data path → formulas the computed-value refresh re-runs when it changes
+    /// (indexes into `evaluations`, ascending)
+    refresh_readers: RapidHashMap<String, SmallVec<[u32; 4]>>,
+}
+
+impl EvalGraph {
+    #[allow(clippy::too_many_arguments)]
+    pub fn build(
+        evaluations: &IndexMap<String, LogicId>,
+        value_evaluations: &[String],
+        batches: &Arc<Vec<Vec<String>>>,
+        dependencies: &IndexMap<String, IndexSet<String>>,
+        dependency_ids: &DependencyIds,
+        paths: &PathTable,
+        tables: &IndexMap<String, serde_json::Value>,
+        table_metadata: &IndexMap<String, TableMetadata>,
+    ) -> Self {
+        let mut graph = EvalGraph {
+            batches: Arc::clone(batches),
+            nodes: Vec::new(),
+            readers: RapidHashMap::new(),
+            writers: RapidHashMap::new(),
+            tables: Vec::new(),
+            computed_values: Vec::new(),
+            refresh_readers: RapidHashMap::new(),
+        };
+        graph.index_refresh(evaluations, dependencies, tables);
+
+        // Mirror evaluate_internal: dependency-free value formulas first, then batches
+        let free_values = value_evaluations
+            .iter()
+            .filter(|key| dependencies.get(*key).map_or(true, IndexSet::is_empty))
+            .map(|key| (key, NodeKind::Value));
+        let batched = batches.iter().flatten().map(|key| {
+            if table_metadata.contains_key(key) {
+                (key, NodeKind::Table)
+            } else {
+                (key, NodeKind::Batch)
+            }
+        });
+
+        for (key, kind) in free_values.chain(batched) {
+            let node = graph.nodes.len() as u32;
+            for &dep in dependency_ids.of(key) {
+                graph.readers.entry(dep).or_default().push(node);
+            }
+            // Values are written at the schema pointer and versioned at its data path
+            let pointer = path_utils::normalize_to_json_pointer(key);
+            let data_path = path_utils::schema_path_to_data_pointer(&pointer);
+            for output in [paths.id(&pointer), paths.id(&data_path)] {
+                let writers = graph.writers.entry(output).or_default();
+                if !writers.contains(&node) {
+                    writers.push(node);
+                }
+            }
+            if kind == NodeKind::Table {
+                graph.tables.push(node);
+            }
+            graph.nodes.push(EvalNode {
+                key: key.clone(),
+                kind,
+            });
+        }
+        graph
+    }
+
+    /// Index the formulas `refresh_computed_value_dependents` reads and re-runs,
+    /// so its passes look up the readers of changed paths instead of scanning
+    fn index_refresh(
+        &mut self,
+        evaluations: &IndexMap<String, LogicId>,
+        dependencies: &IndexMap<String, IndexSet<String>>,
+        tables: &IndexMap<String, serde_json::Value>,
+    ) {
+        for (idx, key) in evaluations.keys().enumerate() {
+            let idx = idx as u32;
+            if let Some(field_path) = key.strip_suffix("/value") {
+                if field_path.contains("/properties/") && !key.contains("/rules/") {
+                    let data_path = path_utils::schema_path_to_data_pointer(field_path);
+                    self.computed_values.push((idx, data_path.into_owned()));
+                }
+            }
+
+            if key.contains("/dependents/")
+                || key.contains("/$params/")
+                || tables.keys().any(|table| key.starts_with(table.as_str()))
+            {
+                continue;
+            }
+            let Some(deps) = dependencies.get(key) else {
+                continue;
+            };
+            for dep in deps {
+                let data_path = path_utils::schema_path_to_data_pointer(dep);
+                let readers = self
+                    .refresh_readers
+                    .entry(data_path.into_owned())
+                    .or_default();
+                if readers.last() != Some(&idx) {
+                    readers.push(idx);
+                }
+            }
+        }
+    }
+
+    /// Formulas the computed-value refresh re-runs after `changed` data paths
+    /// moved, as ascending indexes into `evaluations`
+    pub fn refresh_readers_of<'a>(
+        &self,
+        changed: impl IntoIterator<Item = &'a String>,
+    ) -> Vec<u32> {
+        let mut readers: Vec<u32> = changed
+            .into_iter()
+            .filter_map(|path| self.refresh_readers.get(path))
+            .flatten()
+            .copied()
+            .collect();
+        readers.sort_unstable();
+        readers.dedup();
+        readers
+    }
+
+    /// Whether this graph was built from `batches`
+    pub fn is_for(&self, batches: &Arc<Vec<Vec<String>>>) -> bool {
+        Arc::ptr_eq(&self.batches, batches)
+    }
+}
+
+/// Version counters at the start of the last completed full-coverage pass
+#[derive(Clone)]
+pub(crate) struct CleanBaseline {
+    pub data_versions: VersionTracker,
+    pub params_versions: VersionTracker,
+    /// `EvalData::payload_id` the pass wrote its results into
+    pub payload_id: (u64, u64),
+}
+
+/// Nodes still to visit in the current pass, popped in evaluation order
+pub(crate) struct DirtyQueue<'g> {
+    graph: &'g EvalGraph,
+    heap: BinaryHeap<Reverse<u32>>,
+    queued: Vec<bool>,
+    /// Last node popped; bumps only reach readers evaluated after it
+    cursor: Option<u32>,
+    queued_count: usize,
+}
+
+impl<'g> DirtyQueue<'g> {
+    /// Queue every table plus the readers and writers of `seeds`
+    pub fn new(graph: &'g EvalGraph, seeds: &[PathId]) -> Self {
+        let mut queue = DirtyQueue {
+            graph,
+            heap: BinaryHeap::new(),
+            queued: vec![false; graph.nodes.len()],
+            cursor: None,
+            queued_count: 0,
+        };
+        for &node in &graph.tables {
+            queue.push(node);
+        }
+        queue.mark(seeds);
+        queue
+    }
+
+    /// Queue the readers and writers of paths that were bumped
+    pub fn mark(&mut self, bumped: &[PathId]) {
+        let graph = self.graph;
+        for id in bumped {
+            let readers = graph.readers.get(id).into_iter().flatten();
+            let writers = graph.writers.get(id).into_iter().flatten();
+            for &node in readers.chain(writers) {
+                self.push(node);
+            }
+        }
+    }
+
+    fn push(&mut self, node: u32) {
+        if self.cursor.is_some_and(|cursor| node <= cursor) || self.queued[node as usize] {
+            return;
+        }
+        self.queued[node as usize] = true;
+        self.queued_count += 1;
+        self.heap.push(Reverse(node));
+    }
+
+    pub fn pop(&mut self) -> Option<&'g EvalNode> {
+        let Reverse(node) = self.heap.pop()?;
+        self.cursor = Some(node);
+        Some(&self.graph.nodes[node as usize])
+    }
+
+    /// Number of nodes queued so far
+    pub fn queued_count(&self) -> usize {
+        self.queued_count
+    }
+}
@@ -1,99 +1,267 @@
-use indexmap::IndexSet;
+use rapidhash::RapidHashMap;
 use serde_json::Value;
-use std::collections::{HashMap, HashSet};
+use std::collections::HashMap;
+use std::sync::Arc;
+
+use crate::jsoneval::dirty_set::{CleanBaseline, EvalGraph};
+use crate::jsoneval::path_id::{PathId, PathTable};
+use crate::jsoneval::validation_cache::ValidationCache;
 
 /// Token-version tracker for json paths
-#[derive(Default, Clone)]
+///
+/// Only bumped paths are stored, keyed by [`PathId`] from the schema's
+/// [`PathTable`]; a path that was never bumped has version 0. Memory and scans
+/// scale with what this tracker saw, not with every path the schema interned.
+/// The map is shared copy-on-write, so copying a tracker (item forks, clean
+/// baselines) is O(1) until one side bumps.
+#[derive(Clone)]
 pub struct VersionTracker {
-    versions: HashMap<String, u64>,
+    paths: Arc<PathTable>,
+    versions: Arc<RapidHashMap<PathId, u64>>,
+    /// Ids bumped while journaling is on (see `start_journal`)
+    journal: Option<Vec<PathId>>,
 }
 
 impl VersionTracker {
-    pub fn new() -> Self {
+    /// Empty tracker over the ids of `paths`
+    pub fn new(paths: &Arc<PathTable>) -> Self {
         Self {
-            versions: HashMap::new(),
+            paths: Arc::clone(paths),
+            versions: Arc::default(),
+            journal: None,
+        }
+    }
+
+    /// Copy of the version counters, without the journal
+    pub(crate) fn snapshot(&self) -> VersionTracker {
+        VersionTracker {
+            paths: Arc::clone(&self.paths),
+            versions: Arc::clone(&self.versions),
+            journal: None,
+        }
+    }
+
+    /// Ids whose version differs from `base`, in id order
+    pub(crate) fn changed_since(&self, base: &VersionTracker) -> Vec<PathId> {
+        if Arc::ptr_eq(&self.versions, &base.versions) {
+            return Vec::new();
         }
+        let mut changed: Vec<PathId> = self
+            .entries()
+            .filter(|&(id, v)| base.get_id(id) != v)
+            .chain(base.entries().filter(|&(id, _)| self.get_id(id) == 0))
+            .map(|(id, _)| id)
+            .collect();
+        changed.sort_unstable();
+        changed
+    }
+
+    /// Record the id of every subsequent `bump_id` until `stop_journal`
+    pub(crate) fn start_journal(&mut self) {
+        self.journal = Some(Vec::new());
+    }
+
+    /// Ids bumped since the last call (or since `start_journal`)
+    pub(crate) fn take_journal(&mut self) -> Vec<PathId> {
+        self.journal
+            .as_mut()
+            .map(std::mem::take)
+            .unwrap_or_default()
+    }
+
+    pub(crate) fn stop_journal(&mut self) {
+        self.journal = None;
     }
 
     #[inline]
     pub fn get(&self, path: &str) -> u64 {
-        self.versions.get(path).copied().unwrap_or(0)
+        self.paths.lookup(path).map_or(0, |id| self.get_id(id))
+    }
+
+    #[inline]
+    pub fn get_id(&self, id: PathId) -> u64 {
+        self.versions.get(&id).copied().unwrap_or(0)
     }
 
     #[inline]
     pub fn bump(&mut self, path: &str, source: &str) {
-        let current = self.get(path);
+        self.bump_id(self.paths.id(path), source);
+    }
+
+    #[inline]
+    pub fn bump_id(&mut self, id: PathId, source: &str) {
+        let slot = Arc::make_mut(&mut self.versions).entry(id).or_insert(0);
+        *slot += 1;
         if crate::utils::is_debug_cache_enabled() {
             println!(
                 "[store_cache] BUMPING for {} -> {} ({})",
-                path,
-                current + 1,
+                self.paths.path(id),
+                *slot,
                 source
             );
         }
-        // We use actual data pointers here
-        self.versions.insert(path.to_string(), current + 1);
+        if let Some(journal) = self.journal.as_mut() {
+            journal.push(id);
+        }
+    }
+
+    /// Raise each counter to at least its value in `pairs`, copying the shared
+    /// map only when something actually moves
+    fn raise_to(&mut self, pairs: impl IntoIterator<Item = (PathId, u64)>) {
+        let raised: Vec<(PathId, u64)> = pairs
+            .into_iter()
+            .filter(|&(id, v)| v > self.get_id(id))
+            .collect();
+        if raised.is_empty() {
+            return;
+        }
+        let versions = Arc::make_mut(&mut self.versions);
+        for (id, v) in raised {
+            versions.insert(id, v);
+        }
     }
 
     /// Merge version counters from `other`, taking the **maximum** for each path.
     /// Using max (not insert) ensures that if this tracker already saw a higher version
     /// for a path (e.g., from a previous subform evaluation round), it is never downgraded.
     pub fn merge_from(&mut self, other: &VersionTracker) {
-        for (k, v) in &other.versions {
-            let current = self.versions.get(k).copied().unwrap_or(0);
-            self.versions.insert(k.clone(), current.max(*v));
+        debug_assert!(Arc::ptr_eq(&self.paths, &other.paths));
+        if Arc::ptr_eq(&self.versions, &other.versions) {
+            return;
         }
+        self.raise_to(other.entries());
     }
 
     /// Merge only `/$params`-prefixed version counters from `other` (max strategy).
     /// Used when giving a per-item tracker the latest schema-level param versions
     /// without absorbing data-path bumps that belong to other items.
     pub fn merge_from_params(&mut self, other: &VersionTracker) {
-        for (k, v) in &other.versions {
-            if k.starts_with("/$params") {
-                let current = self.versions.get(k).copied().unwrap_or(0);
-                self.versions.insert(k.clone(), current.max(*v));
-            }
+        debug_assert!(Arc::ptr_eq(&self.paths, &other.paths));
+        if Arc::ptr_eq(&self.versions, &other.versions) {
+            return;
         }
+        self.raise_to(other.entries().filter(|(id, _)| id.is_params()));
     }
 
-    /// Merge counters except paths local to a different active subform item.
-    pub(crate) fn merge_excluding_prefix(&mut self, other: &VersionTracker, excluded_prefix: &str) {
-        for (k, v) in &other.versions {
-            if !k.starts_with(excluded_prefix) {
-                let current = self.versions.get(k).copied().unwrap_or(0);
-                self.versions.insert(k.clone(), current.max(*v));
+    /// Merge counters except paths under `excluded_root`, which belong to a
+    /// different active subform item.
+    pub(crate) fn merge_excluding_subtree(&mut self, other: &VersionTracker, excluded_root: &str) {
+        debug_assert!(Arc::ptr_eq(&self.paths, &other.paths));
+        let kept: Vec<(PathId, u64)> = {
+            let paths = other.paths.read();
+            match paths.lookup(excluded_root) {
+                Some(root) => other
+                    .entries()
+                    .filter(|&(id, _)| !paths.is_within(id, root))
+                    .collect(),
+                None => other.entries().collect(),
             }
+        };
+        self.raise_to(kept);
+    }
+
+    /// Add the bumps `other` made on top of `base` (a tracker it was copied
+    /// from) to this tracker's counters.
+    ///
+    /// Unlike `merge_from`, bumps made on separate copies add up: two copies that
+    /// each bumped a path from v leave it at v + 2 here, so no version either copy
+    /// stored results under is current afterwards.
+    pub(crate) fn add_bumps_since(&mut self, other: &VersionTracker, base: &VersionTracker) {
+        debug_assert!(Arc::ptr_eq(&self.paths, &other.paths));
+        if Arc::ptr_eq(&other.versions, &base.versions) {
+            return;
+        }
+        let bumps: Vec<(PathId, u64)> = other
+            .entries()
+            .filter_map(|(id, v)| {
+                let since = v.saturating_sub(base.get_id(id));
+                (since > 0).then_some((id, since))
+            })
+            .collect();
+        if bumps.is_empty() {
+            return;
+        }
+        let versions = Arc::make_mut(&mut self.versions);
+        for (id, since) in bumps {
+            *versions.entry(id).or_insert(0) += since;
         }
     }
 
-    /// Returns true if any tracked path with the given prefix has been bumped (version > 0).
+    /// Returns true if any tracked path under `root` has been bumped (version > 0).
     /// Used to gate table re-evaluation when item fields change without the item being new.
-    pub fn any_bumped_with_prefix(&self, prefix: &str) -> bool {
-        self.versions
-            .iter()
-            .any(|(k, &v)| k.starts_with(prefix) && v > 0)
+    pub fn any_bumped_under(&self, root: &str) -> bool {
+        if self.versions.is_empty() {
+            return false;
+        }
+        let paths = self.paths.read();
+        let Some(root) = paths.lookup(root) else {
+            return false;
+        };
+        self.entries().any(|(id, _)| paths.is_within(id, root))
     }
 
-    /// Returns true if any path with the given prefix has a **higher** version than in `baseline`.
-    /// Unlike `any_bumped_with_prefix`, this detects only brand-new bumps from a specific diff
+    /// Returns true if any path under `root` has a **higher** version than in `baseline`.
+    /// Unlike `any_bumped_under`, this detects only brand-new bumps from a specific diff
     /// pass, ignoring historical bumps that were already present in the baseline.
-    pub fn any_newly_bumped_with_prefix(&self, prefix: &str, baseline: &VersionTracker) -> bool {
-        self.versions
-            .iter()
-            .any(|(k, &v)| k.starts_with(prefix) && v > baseline.get(k))
+    pub fn any_newly_bumped_under(&self, root: &str, baseline: &VersionTracker) -> bool {
+        if Arc::ptr_eq(&self.versions, &baseline.versions) {
+            return false;
+        }
+        let paths = self.paths.read();
+        let Some(root) = paths.lookup(root) else {
+            return false;
+        };
+        self.entries()
+            .any(|(id, v)| v > baseline.get_id(id) && paths.is_within(id, root))
+    }
+
+    /// Paths under `root` with a higher version than in `baseline`, in id order
+    pub fn newly_bumped_under(
+        &self,
+        root: &str,
+        baseline: &VersionTracker,
+    ) -> Vec<(PathId, Arc<str>)> {
+        if Arc::ptr_eq(&self.versions, &baseline.versions) {
+            return Vec::new();
+        }
+        let paths = self.paths.read();
+        let Some(root) = paths.lookup(root) else {
+            return Vec::new();
+        };
+        let mut bumped: Vec<(PathId, Arc<str>)> = self
+            .entries()
+            .filter(|&(id, v)| v > baseline.get_id(id) && paths.is_within(id, root))
+            .map(|(id, _)| (id, paths.shared_path(id)))
+            .collect();
+        bumped.sort_unstable_by_key(|&(id, _)| id);
+        bumped
     }
 
-    /// Returns an iterator over all (path, version) pairs, for targeted bump enumeration.
-    pub fn versions(&self) -> impl Iterator<Item = (&str, &u64)> {
-        self.versions.iter().map(|(k, v)| (k.as_str(), v))
+    /// All bumped `(path, version)` pairs in id order, for targeted bump enumeration.
+    pub fn versions(&self) -> impl Iterator<Item = (Arc<str>, u64)> {
+        let mut entries: Vec<(PathId, u64)> = self.entries().collect();
+        entries.sort_unstable();
+        let pairs: Vec<(Arc<str>, u64)> = {
+            let paths = self.paths.read();
+            entries
+                .into_iter()
+                .map(|(id, v)| (paths.shared_path(id), v))
+                .collect()
+        };
+        pairs.into_iter()
+    }
+
+    /// All bumped `(id, version)` pairs, in no particular order
+    pub fn entries(&self) -> impl Iterator<Item = (PathId, u64)> + '_ {
+        self.versions.iter().map(|(&id, &v)| (id, v))
     }
 }
 
 /// A cached evaluation result with the specific dependency versions it was evaluated against
 #[derive(Clone)]
 pub struct CacheEntry {
-    pub dep_versions: HashMap<String, u64>,
+    /// Dependency versions in the order the formula's dependencies are listed
+    pub dep_versions: Vec<(PathId, u64)>,
     pub result: Value,
     /// The `active_item_index` this entry was computed under.
     /// `None` = computed during main-form evaluation (safe to reuse across all items
@@ -102,8 +270,30 @@ pub struct CacheEntry {
     pub computed_for_item: Option<usize>,
 }
 
+impl CacheEntry {
+    /// Version recorded for `dep`. `hint` is its expected position: entries are
+    /// validated with the same dependency list they were stored with.
+    #[inline]
+    pub fn dep_version(&self, dep: PathId, hint: usize) -> Option<u64> {
+        match self.dep_versions.get(hint) {
+            Some(&(id, v)) if id == dep => Some(v),
+            _ => self
+                .dep_versions
+                .iter()
+                .find(|(id, _)| *id == dep)
+                .map(|&(_, v)| v),
+        }
+    }
+
+    /// Whether every dependency is a `$params` path (result is item-independent)
+    #[inline]
+    pub fn params_only(&self) -> bool {
+        self.dep_versions.iter().all(|(id, _)| id.is_params())
+    }
+}
+
 /// Independent cache state for a single item in a subform array
-#[derive(Default, Clone)]
+#[derive(Clone)]
 pub struct SubformItemCache {
     pub data_versions: VersionTracker,
     pub entries: HashMap<String, CacheEntry>,
@@ -115,9 +305,9 @@ pub struct SubformItemCache {
 }
 
 impl SubformItemCache {
-    pub fn new() -> Self {
+    pub fn new(paths: &Arc<PathTable>) -> Self {
         Self {
-            data_versions: VersionTracker::new(),
+            data_versions: VersionTracker::new(paths),
             entries: HashMap::new(),
             item_snapshot: Value::Null,
             evaluated_schema: None,
@@ -128,9 +318,12 @@ impl SubformItemCache {
 /// Primary cache structure for a JSON evaluation instance
 #[derive(Clone)]
 pub struct EvalCache {
+    /// Interned paths of the schema, shared with its subforms' caches
+    paths: Arc<PathTable>,
     pub data_versions: VersionTracker,
     pub params_versions: VersionTracker,
-    pub entries: HashMap<String, CacheEntry>,
+    /// Global (Tier 2) entries, shared copy-on-write with item forks
+    pub entries: Arc<HashMap<String, CacheEntry>>,
 
     pub active_item_index: Option<usize>,
     pub subform_caches: HashMap<usize, SubformItemCache>,
@@ -144,7 +337,32 @@ pub struct EvalCache {
     /// Snapshot of the last fully-diffed main-form data payload.
     /// Stored after each successful `evaluate_internal_with_new_data` call so the next
     /// invocation can avoid an extra `snapshot_data_clone()` when computing the diff.
-    pub main_form_snapshot: Option<Value>,
+    /// Shares its tree with `EvalData` (`snapshot_data()`), so storing it is O(1).
+    pub main_form_snapshot: Option<Arc<Value>>,
+
+    /// Reverse dependency graph of the schema, built on the first dirty-set pass
+    pub(crate) eval_graph: Option<Arc<EvalGraph>>,
+    /// Versions the last completed main-form pass started from; `None` forces a full pass
+    pub(crate) clean_baseline: Option<CleanBaseline>,
+
+    /// Per-field validation outcomes, keyed on the versions of their rule inputs
+    pub(crate) validation: ValidationCache,
+
+    /// Set while this cache is a fork for one subform item (see `fork_item`)
+    pub(crate) item_fork: Option<ItemFork>,
+}
+
+/// What a cache forked for one subform item starts from, read back by `join_item`
+#[derive(Clone)]
+pub(crate) struct ItemFork {
+    /// `eval_generation` when the fork was taken
+    base_generation: u64,
+    /// Version counters when the fork was taken
+    base_data_versions: VersionTracker,
+    base_params_versions: VersionTracker,
+    /// The parent's global entries, read under the fork's own `entries` (which
+    /// only holds what the item stored). Dropped by `release_fork_base`.
+    base_entries: Arc<HashMap<String, CacheEntry>>,
 }
 
 impl Default for EvalCache {
@@ -154,28 +372,146 @@ impl Default for EvalCache {
 }
 
 impl EvalCache {
+    /// Cache over a path table of its own
     pub fn new() -> Self {
+        Self::with_paths(Arc::default())
+    }
+
+    /// Cache over the path table of a schema; the caches of a schema and its
+    /// subforms must share one table
+    pub fn with_paths(paths: Arc<PathTable>) -> Self {
         Self {
-            data_versions: VersionTracker::new(),
-            params_versions: VersionTracker::new(),
-            entries: HashMap::new(),
+            data_versions: VersionTracker::new(&paths),
+            params_versions: VersionTracker::new(&paths),
+            paths,
+            entries: Arc::default(),
             active_item_index: None,
             subform_caches: HashMap::new(),
             eval_generation: 0,
             last_evaluated_generation: u64::MAX, // force first evaluate_internal to run
             main_form_snapshot: None,
+            eval_graph: None,
+            clean_baseline: None,
+            validation: ValidationCache::default(),
+            item_fork: None,
         }
     }
 
+    /// Interned paths the version trackers are keyed by
+    pub fn paths(&self) -> &Arc<PathTable> {
+        &self.paths
+    }
+
     pub fn clear(&mut self) {
-        self.data_versions = VersionTracker::new();
-        self.params_versions = VersionTracker::new();
-        self.entries.clear();
+        self.data_versions = VersionTracker::new(&self.paths);
+        self.params_versions = VersionTracker::new(&self.paths);
+        match Arc::get_mut(&mut self.entries) {
+            Some(entries) => entries.clear(),
+            None => self.entries = Arc::default(),
+        }
         self.active_item_index = None;
         self.subform_caches.clear();
         self.eval_generation = 0;
         self.last_evaluated_generation = u64::MAX;
         self.main_form_snapshot = None;
+        // eval_graph depends only on the schema and `is_for` catches reloads, so a
+        // reset instance keeps it
+        self.clean_baseline = None;
+        self.validation = ValidationCache::default();
+        self.item_fork = None;
+    }
+
+    /// Fork the state item `idx` needs to evaluate on another thread. Version
+    /// trackers and global entries are shared with the parent, not copied; the
+    /// item's own cache is moved into the fork. Hand the fork back to `join_item`
+    /// once the item has run.
+    pub(crate) fn fork_item(&mut self, idx: usize) -> EvalCache {
+        let mut subform_caches = HashMap::new();
+        if let Some(item_cache) = self.subform_caches.remove(&idx) {
+            subform_caches.insert(idx, item_cache);
+        }
+        EvalCache {
+            paths: Arc::clone(&self.paths),
+            data_versions: self.data_versions.snapshot(),
+            params_versions: self.params_versions.snapshot(),
+            entries: Arc::default(),
+            active_item_index: Some(idx),
+            subform_caches,
+            eval_generation: self.eval_generation,
+            last_evaluated_generation: self.last_evaluated_generation,
+            main_form_snapshot: self.main_form_snapshot.clone(),
+            eval_graph: self.eval_graph.clone(),
+            clean_baseline: self.clean_baseline.clone(),
+            validation: ValidationCache::default(),
+            item_fork: Some(ItemFork {
+                base_generation: self.eval_generation,
+                base_data_versions: self.data_versions.snapshot(),
+                base_params_versions: self.params_versions.snapshot(),
+                base_entries: Arc::clone(&self.entries),
+            }),
+        }
+    }
+
+    /// Let go of the parent's global entries once the fork has run, so joining
+    /// writes them in place instead of copying them
+    pub(crate) fn release_fork_base(&mut self) {
+        if let Some(item_fork) = self.item_fork.as_mut() {
+            item_fork.base_entries = Arc::default();
+        }
+    }
+
+    /// Merge back a cache returned by `fork_item` for item `idx`.
+    ///
+    /// Joining forks in item order leaves the cache as running the items one after
+    /// another would: global entries an item stored replace earlier ones, and the
+    /// version counters and generation advance by what each item advanced them.
+    /// Items that ran side by side did not see each other's bumps, so a path two
+    /// of them bumped ends past every version either one stored results under.
+    pub(crate) fn join_item(&mut self, idx: usize, mut fork: EvalCache) {
+        let item_fork = fork.item_fork.take().unwrap_or_else(|| ItemFork {
+            base_generation: 0,
+            base_data_versions: VersionTracker::new(&self.paths),
+            base_params_versions: VersionTracker::new(&self.paths),
+            base_entries: Arc::default(),
+        });
+        if let Some(item_cache) = fork.subform_caches.remove(&idx) {
+            self.subform_caches.insert(idx, item_cache);
+        }
+        if !fork.entries.is_empty() {
+            let promoted = Arc::try_unwrap(fork.entries).unwrap_or_else(|shared| (*shared).clone());
+            Arc::make_mut(&mut self.entries).extend(promoted);
+        }
+        self.data_versions
+            .add_bumps_since(&fork.data_versions, &item_fork.base_data_versions);
+        self.params_versions
+            .add_bumps_since(&fork.params_versions, &item_fork.base_params_versions);
+        self.eval_generation += fork
+            .eval_generation
+            .saturating_sub(item_fork.base_generation);
+        if fork.last_evaluated_generation == fork.eval_generation {
+            self.mark_evaluated();
+        }
+        if fork.clean_baseline.is_none() {
+            self.invalidate_clean_baseline();
+        }
+    }
+
+    /// Global (Tier 2) entry for `eval_key`. An item fork sees what it stored
+    /// itself over the parent's entries.
+    #[inline]
+    fn global_entry(&self, eval_key: &str) -> Option<&CacheEntry> {
+        self.entries.get(eval_key).or_else(|| {
+            self.item_fork
+                .as_ref()
+                .and_then(|item_fork| item_fork.base_entries.get(eval_key))
+        })
+    }
+
+    /// Store a global (Tier 2) entry; an item fork keeps it apart from the
+    /// parent's entries until it is joined
+    #[inline]
+    fn insert_global(&mut self, eval_key: &str, entry: CacheEntry) {
+        Arc::make_mut(&mut self.entries).insert(eval_key.to_string(), entry);
     }
 
     /// Remove item caches for indices >= `current_count`.
@@ -218,10 +554,86 @@ impl EvalCache {
         self.last_evaluated_generation = self.eval_generation;
     }
 
+    /// Paths whose version moved since the clean baseline, or `None` when a full
+    /// pass is required (no baseline, or the data payload was replaced since)
+    pub(crate) fn dirty_seeds(&self, payload_id: (u64, u64)) -> Option<Vec<PathId>> {
+        let base = self.clean_baseline.as_ref()?;
+        if base.payload_id != payload_id {
+            return None;
+        }
+        let mut seeds = self.data_versions.changed_since(&base.data_versions);
+        seeds.extend(self.params_versions.changed_since(&base.params_versions));
+        Some(seeds)
+    }
+
+    /// Whether nothing changed since the last completed main-form pass
+    pub(crate) fn is_clean(&self, payload_id: (u64, u64)) -> bool {
+        self.dirty_seeds(payload_id)
+            .is_some_and(|seeds| seeds.is_empty())
+    }
+
+    /// Version counters to record as the baseline once the pass starting now completes
+    pub(crate) fn baseline_from_here(&self, payload_id: (u64, u64)) -> CleanBaseline {
+        CleanBaseline {
+            data_versions: self.data_versions.snapshot(),
+            params_versions: self.params_versions.snapshot(),
+            payload_id,
+        }
+    }
+
+    /// Drop the clean baseline: cache entries changed in a way version counters
+    /// do not show, so the next main-form pass must visit every formula
+    pub(crate) fn invalidate_clean_baseline(&mut self) {
+        self.clean_baseline = None;
+    }
+
+    /// Journal bumps on the main-form trackers (see `take_bump_journal`)
+    pub(crate) fn start_bump_journal(&mut self) {
+        self.data_versions.start_journal();
+        self.params_versions.start_journal();
+    }
+
+    /// Paths bumped on the main-form trackers since the last call
+    pub(crate) fn take_bump_journal(&mut self) -> Vec<PathId> {
+        let mut bumped = self.data_versions.take_journal();
+        bumped.extend(self.params_versions.take_journal());
+        bumped
+    }
+
+    pub(crate) fn stop_bump_journal(&mut self) {
+        self.data_versions.stop_journal();
+        self.params_versions.stop_journal();
+    }
+
+    /// Current version of `dep` in the tracker `store_cache` snapshots it from
+    pub(crate) fn dep_version(&self, dep: PathId) -> u64 {
+        if dep.is_params() {
+            self.params_versions.get_id(dep)
+        } else if let Some(idx) = self.active_item_index {
+            self.subform_caches
+                .get(&idx)
+                .map_or(0, |c| c.data_versions.get_id(dep))
+        } else {
+            self.data_versions.get_id(dep)
+        }
+    }
+
     pub(crate) fn ensure_active_item_cache(&mut self, idx: usize) {
         self.subform_caches
             .entry(idx)
-            .or_insert_with(SubformItemCache::new);
+            .or_insert_with(|| SubformItemCache::new(&self.paths));
+    }
+
+    /// Give item `idx` a baseline snapshot when it has none yet. An existing
+    /// snapshot is kept so the next item scope diffs it against the new item.
+    pub(crate) fn seed_item_snapshot(&mut self, idx: usize, item: &Value) {
+        let cache = self
+            .subform_caches
+            .entry(idx)
+            .or_insert_with(|| SubformItemCache::new(&self.paths));
+        if cache.item_snapshot.is_null() {
+            cache.item_snapshot = item.clone();
+        }
     }
 
     pub fn set_active_item(&mut self, idx: usize) {
@@ -235,6 +647,9 @@ impl EvalCache {
 
     /// Recursively diffs `old` against `new` and bumps version for every changed data path scalar.
     pub fn store_snapshot_and_diff_versions(&mut self, old: &Value, new: &Value) {
+        if std::ptr::eq(old, new) && self.active_item_index.is_none() {
+            return; // Same shared snapshot: nothing changed
+        }
         if let Some(idx) = self.active_item_index {
             self.ensure_active_item_cache(idx);
             let sub_cache = self.subform_caches.get_mut(&idx).unwrap();
@@ -257,6 +672,20 @@ impl EvalCache {
         }
     }
 
+    /// Bump versions for the scalars that changed under a single data `pointer`,
+    /// routed to the active item's tracker like `store_snapshot_and_diff_versions`.
+    /// Costs O(size of the changed subtree) instead of a whole-document diff.
+    pub fn diff_versions_at(&mut self, pointer: &str, old: &Value, new: &Value) {
+        let tracker = match self.active_item_index {
+            Some(idx) => {
+                self.ensure_active_item_cache(idx);
+                &mut self.subform_caches.get_mut(&idx).unwrap().data_versions
+            }
+            None => &mut self.data_versions,
+        };
+        diff_and_update_versions(tracker, pointer, old, new, "diff_versions_at");
+    }
+
     pub fn get_active_snapshot(&self) -> Value {
         if let Some(idx) = self.active_item_index {
             self.subform_caches
@@ -317,13 +746,16 @@ impl EvalCache {
     /// Two-tier lookup:
     /// - Tier 1: item-scoped entries in `subform_caches[idx]` — checked first when an active item is set
     /// - Tier 2: global `self.entries` — allows Run 1 (main form) results to be reused in Run 2 (subform)
-    pub fn check_cache(&self, eval_key: &str, deps: &IndexSet<String>) -> Option<Value> {
+    pub fn check_cache(&self, eval_key: &str, deps: &[PathId]) -> Option<Value> {
         if let Some(idx) = self.active_item_index {
             // Tier 1: item-specific entries (always safe to reuse for the same index)
             if let Some(cache) = self.subform_caches.get(&idx) {
-                if let Some(hit) =
-                    self.validate_entry(eval_key, deps, &cache.entries, &cache.data_versions)
-                {
+                if let Some(hit) = self.validate_entry(
+                    eval_key,
+                    deps,
+                    cache.entries.get(eval_key),
+                    &cache.data_versions,
+                ) {
                     if crate::utils::is_debug_cache_enabled() {
                         println!("Cache HIT [T1 idx={}] {}", idx, eval_key);
                     }
@@ -342,19 +774,19 @@ impl EvalCache {
                 .map(|c| &c.data_versions)
                 .unwrap_or(&self.data_versions);
 
-            if let Some(entry) = self.entries.get(eval_key) {
+            if let Some(entry) = self.global_entry(eval_key) {
                 let index_safe = match entry.computed_for_item {
                     // Main-form entry (no active item when stored): only safe if ALL its deps
                     // are $params-scoped. Non-$params deps (like /riders/prem_pay_period) mean
                     // the formula result is rider-specific — using it for a different rider via
                     // the batch fast path would corrupt eval_data and poison subsequent formulas.
-                    None => entry.dep_versions.keys().all(|p| p.starts_with("/$params")),
+                    None => entry.params_only(),
                     Some(stored_idx) if stored_idx == idx => true,
-                    _ => entry.dep_versions.keys().all(|p| p.starts_with("/$params")),
+                    _ => entry.params_only(),
                 };
                 if index_safe {
                     let result =
-                        self.validate_entry(eval_key, deps, &self.entries, item_data_versions);
+                        self.validate_entry(eval_key, deps, Some(entry), item_data_versions);
                     if result.is_some() {
                         if crate::utils::is_debug_cache_enabled() {
                             println!(
@@ -369,7 +801,12 @@ impl EvalCache {
 
             None
         } else {
-            self.validate_entry(eval_key, deps, &self.entries, &self.data_versions)
+            self.validate_entry(
+                eval_key,
+                deps,
+                self.global_entry(eval_key),
+                &self.data_versions,
+            )
         }
     }
 
@@ -384,13 +821,16 @@ impl EvalCache {
     /// This method validates the global entry directly — using `item_data_versions` for
     /// non-`$params` deps — without the `index_safe` gate, allowing the expensive table forward/
     /// backward pass to be skipped when inputs have not changed.
-    pub fn check_table_cache(&self, eval_key: &str, deps: &IndexSet<String>) -> Option<Value> {
+    pub fn check_table_cache(&self, eval_key: &str, deps: &[PathId]) -> Option<Value> {
         if let Some(idx) = self.active_item_index {
             // Tier 1: item-scoped entries first (unlikely for $params tables but check anyway)
             if let Some(cache) = self.subform_caches.get(&idx) {
-                if let Some(hit) =
-                    self.validate_entry(eval_key, deps, &cache.entries, &cache.data_versions)
-                {
+                if let Some(hit) = self.validate_entry(
+                    eval_key,
+                    deps,
+                    cache.entries.get(eval_key),
+                    &cache.data_versions,
+                ) {
                     if crate::utils::is_debug_cache_enabled() {
                         println!("Cache HIT [T1 table idx={}] {}", idx, eval_key);
                     }
@@ -403,21 +843,21 @@ impl EvalCache {
             // `SubformScope` aliases it locally. Reuse that result while this item's local
             // rider inputs remain unchanged; a local input bump makes the alias stale and
             // forces item-scoped table recomputation.
-            let has_item_data_dependency = deps.iter().any(|dep| {
-                !crate::jsoneval::path_utils::schema_path_to_data_pointer(dep)
-                    .starts_with("/$params")
-            });
-            let active_item_changed = self.subform_caches.get(&idx).is_some_and(|cache| {
-                cache
-                    .data_versions
-                    .versions()
-                    .any(|(path, version)| path.starts_with("/riders/") && *version > 0)
-            });
+            let has_item_data_dependency = deps.iter().any(|dep| !dep.is_params());
+            let active_item_changed = self
+                .subform_caches
+                .get(&idx)
+                .is_some_and(|cache| cache.data_versions.any_bumped_under("/riders"));
             if has_item_data_dependency && active_item_changed {
                 return None;
             }
 
-            let result = self.validate_entry(eval_key, deps, &self.entries, &self.data_versions);
+            let result = self.validate_entry(
+                eval_key,
+                deps,
+                self.global_entry(eval_key),
+                &self.data_versions,
+            );
             if result.is_some() {
                 if crate::utils::is_debug_cache_enabled() {
                     println!("Cache HIT [T2 table idx={}] {}", idx, eval_key);
@@ -425,45 +865,54 @@ impl EvalCache {
             }
             result
         } else {
-            self.validate_entry(eval_key, deps, &self.entries, &self.data_versions)
+            self.validate_entry(
+                eval_key,
+                deps,
+                self.global_entry(eval_key),
+                &self.data_versions,
+            )
         }
     }
 
     fn validate_entry(
         &self,
         eval_key: &str,
-        deps: &IndexSet<String>,
-        entries: &HashMap<String, CacheEntry>,
+        deps: &[PathId],
+        entry: Option<&CacheEntry>,
         data_versions: &VersionTracker,
     ) -> Option<Value> {
-        let entry = entries.get(eval_key)?;
-        for dep in deps {
-            let data_dep_path = crate::jsoneval::path_utils::schema_path_to_data_pointer(dep);
-
-            let current_ver = if data_dep_path.starts_with("/$params") {
-                self.params_versions.get(&data_dep_path)
+        let entry = entry?;
+        for (i, &dep) in deps.iter().enumerate() {
+            let current_ver = if dep.is_params() {
+                self.params_versions.get_id(dep)
             } else {
-                data_versions.get(&data_dep_path)
+                data_versions.get_id(dep)
             };
 
-            if let Some(&cached_ver) = entry.dep_versions.get(data_dep_path.as_ref()) {
-                if current_ver != cached_ver {
+            match entry.dep_version(dep, i) {
+                Some(cached_ver) if cached_ver == current_ver => {}
+                Some(cached_ver) => {
                     if crate::utils::is_debug_cache_enabled() {
                         println!(
                             "Cache MISS {}: dep {} changed ({} -> {})",
-                            eval_key, data_dep_path, cached_ver, current_ver
+                            eval_key,
+                            self.paths.path(dep),
+                            cached_ver,
+                            current_ver
                         );
                     }
                     return None;
                 }
-            } else {
-                if crate::utils::is_debug_cache_enabled() {
-                    println!(
-                        "Cache MISS {}: dep {} missing from cache entry",
-                        eval_key, data_dep_path
-                    );
+                None => {
+                    if crate::utils::is_debug_cache_enabled() {
+                        println!(
+                            "Cache MISS {}: dep {} missing from cache entry",
+                            eval_key,
+                            self.paths.path(dep)
+                        );
+                    }
+                    return None;
                 }
-                return None;
             }
         }
         if crate::utils::is_debug_cache_enabled() {
@@ -479,12 +928,15 @@ impl EvalCache {
     ///   This isolates per-rider results so different items with different data don't collide.
     /// - The global `self.entries` is written only from the main form (no active item).
     ///   Subforms can reuse these via the Tier 2 fallback in `check_cache`.
-    pub fn store_cache(&mut self, eval_key: &str, deps: &IndexSet<String>, result: Value) {
+    pub fn store_cache(&mut self, eval_key: &str, deps: &[PathId], result: Value) {
+        if self.active_item_index.is_some() {
+            // Item runs may promote entries to the global tier behind the main form's back
+            self.invalidate_clean_baseline();
+        }
         // Phase 1: snapshot dep versions using the correct data_versions tracker.
         // Always use item data_versions for T1; for T2 promotion of $params tables we
         // build a separate snapshot using PARENT data_versions (see Phase 2 note below).
-        let mut dep_versions = HashMap::with_capacity(deps.len());
-        {
+        let dep_versions: Vec<(PathId, u64)> = {
             let data_versions = if let Some(idx) = self.active_item_index {
                 self.ensure_active_item_cache(idx);
                 &self.subform_caches[&idx].data_versions
@@ -492,16 +944,17 @@ impl EvalCache {
                 &self.data_versions
             };
 
-            for dep in deps {
-                let data_dep_path = crate::jsoneval::path_utils::schema_path_to_data_pointer(dep);
-                let ver = if data_dep_path.starts_with("/$params") {
-                    self.params_versions.get(&data_dep_path)
-                } else {
-                    data_versions.get(&data_dep_path)
-                };
-                dep_versions.insert(data_dep_path.into_owned(), ver);
-            }
-        }
+            deps.iter()
+                .map(|&dep| {
+                    let ver = if dep.is_params() {
+                        self.params_versions.get_id(dep)
+                    } else {
+                        data_versions.get_id(dep)
+                    };
+                    (dep, ver)
+                })
+                .collect()
+        };
 
         // Phase 2: insert into the correct tier, tagging with the current item index.
         let computed_for_item = self.active_item_index;
@@ -517,14 +970,14 @@ impl EvalCache {
         if eval_key.starts_with("#/$params") {
             let existing_result: Option<&Value> = if let Some(idx) = self.active_item_index {
                 // Check T2 (global) first — if T2 has same value, no need to bump again.
-                self.entries.get(eval_key).map(|e| &e.result).or_else(|| {
+                self.global_entry(eval_key).map(|e| &e.result).or_else(|| {
                     self.subform_caches
                         .get(&idx)
                         .and_then(|c| c.entries.get(eval_key))
                         .map(|e| &e.result)
                 })
             } else {
-                self.entries.get(eval_key).map(|e| &e.result)
+                self.global_entry(eval_key).map(|e| &e.result)
             };
 
             let value_changed = existing_result.map_or(true, |r| r != &result);
@@ -574,17 +1027,17 @@ impl EvalCache {
             // Fix: rebuild dep_versions using PARENT data_versions for non-$params paths.
             // T1 retains item data_versions (correct for per-item scoping).
             if eval_key.starts_with("#/$params") {
-                let t2_dep_versions: HashMap<String, u64> = entry
+                let t2_dep_versions: Vec<(PathId, u64)> = entry
                     .dep_versions
                     .iter()
-                    .map(|(path, &item_ver)| {
-                        let parent_ver = if path.starts_with("/$params") {
+                    .map(|&(dep, item_ver)| {
+                        let parent_ver = if dep.is_params() {
                             item_ver // params_versions are global — same for both
                         } else {
                             // Use parent data_versions, which is what check_table_cache reads
-                            self.data_versions.get(path)
+                            self.data_versions.get_id(dep)
                         };
-                        (path.clone(), parent_ver)
+                        (dep, parent_ver)
                     })
                     .collect();
 
@@ -593,10 +1046,10 @@ impl EvalCache {
                     result: entry.result.clone(),
                     computed_for_item,
                 };
-                self.entries.insert(eval_key.to_string(), t2_entry);
+                self.insert_global(eval_key, t2_entry);
             }
         } else {
-            self.entries.insert(eval_key.to_string(), entry);
+            self.insert_global(eval_key, entry);
         }
     }
 }
@@ -617,9 +1070,53 @@ pub(crate) fn diff_and_update_versions(
 #[cfg(test)]
 mod cache_tests {
     use super::{CacheEntry, EvalCache};
-    use indexmap::IndexSet;
     use serde_json::json;
-    use std::collections::HashMap;
+    use std::sync::Arc;
+
+    fn entry(result: serde_json::Value) -> CacheEntry {
+        CacheEntry {
+            dep_versions: Vec::new(),
+            result,
+            computed_for_item: None,
+        }
+    }
+
+    #[test]
+    fn joined_forks_add_up_their_bumps() {
+        let mut parent = EvalCache::new();
+        parent.bump_params_version("/$params/rate");
+        Arc::make_mut(&mut parent.entries).insert("#/$params/a".to_string(), entry(json!(1)));
+
+        let mut first = parent.fork_item(0);
+        let mut second = parent.fork_item(1);
+
+        // Forks read the parent's global entries without copying them
+        assert!(first.entries.is_empty());
+        assert_eq!(
+            first.global_entry("#/$params/a").map(|e| &e.result),
+            Some(&json!(1))
+        );
+
+        first.bump_params_version("/$params/rate");
+        first.insert_global("#/$params/b", entry(json!(2)));
+        second.bump_params_version("/$params/rate");
+        second.insert_global("#/$params/b", entry(json!(3)));
+        assert!(second
+            .global_entry("#/$params/b")
+            .is_some_and(|e| e.result == json!(3)));
+        assert!(parent.global_entry("#/$params/b").is_none());
+
+        first.release_fork_base();
+        second.release_fork_base();
+        parent.join_item(0, first);
+        parent.join_item(1, second);
+
+        // Each item bumped from 1, as running them one after another would have
+        assert_eq!(parent.params_versions.get("/$params/rate"), 3);
+        assert_eq!(parent.eval_generation, 3);
+        assert_eq!(parent.entries["#/$params/a"].result, json!(1));
+        assert_eq!(parent.entries["#/$params/b"].result, json!(3));
+    }
 
     #[test]
     fn unchanged_active_item_reuses_global_table_with_item_dependency() {
@@ -627,11 +1124,11 @@ mod cache_tests {
         cache.set_active_item(1);
 
         let eval_key = "#/$params/references/RIDER_RATE";
-        let deps = IndexSet::from_iter(["#/riders/properties/benefit".to_string()]);
-        cache.entries.insert(
+        let deps = [cache.paths().id("/riders/benefit")];
+        Arc::make_mut(&mut cache.entries).insert(
             eval_key.to_string(),
             CacheEntry {
-                dep_versions: HashMap::from([("/riders/benefit".to_string(), 0)]),
+                dep_versions: vec![(deps[0], 0)],
                 result: json!([{"rate": 97}]),
                 computed_for_item: None,
             },
@@ -656,11 +1153,11 @@ mod cache_tests {
             .bump("/riders/benefit", "test rider input change");
 
         let eval_key = "#/$params/references/RIDER_RATE";
-        let deps = IndexSet::from_iter(["#/riders/properties/benefit".to_string()]);
-        cache.entries.insert(
+        let deps = [cache.paths().id("/riders/benefit")];
+        Arc::make_mut(&mut cache.entries).insert(
             eval_key.to_string(),
             CacheEntry {
-                dep_versions: HashMap::from([("/riders/benefit".to_string(), 0)]),
+                dep_versions: vec![(deps[0], 0)],
                 result: json!([{"rate": 97}]),
                 computed_for_item: None,
             },
@@ -678,11 +1175,11 @@ mod cache_tests {
         cache.set_active_item(1);
 
         let eval_key = "#/$params/references/SHARED_RATE";
-        let deps = IndexSet::from_iter(["#/$params/others/currency".to_string()]);
-        cache.entries.insert(
+        let deps = [cache.paths().id("/$params/others/currency")];
+        Arc::make_mut(&mut cache.entries).insert(
             eval_key.to_string(),
             CacheEntry {
-                dep_versions: HashMap::from([("/$params/others/currency".to_string(), 0)]),
+                dep_versions: vec![(deps[0], 0)],
                 result: json!([{"rate": 10}]),
                 computed_for_item: None,
             },
@@ -695,6 +1192,9 @@ mod cache_tests {
     }
 }
 
+/// Single-pass diff: containers are walked, never compared wholesale with `==`,
+/// so a change deep in the tree costs O(n) instead of O(n × depth). Nodes shared
+/// between the two snapshots (same address) are skipped in O(1).
 fn diff_and_update_versions_internal(
     tracker: &mut VersionTracker,
     pointer: &mut String,
@@ -702,45 +1202,36 @@ fn diff_and_update_versions_internal(
     new: &Value,
     source: &str,
 ) {
-    if old == new {
+    // Snapshots only share the root node, so identity is checked first and
+    // equal subtrees at different addresses are cut off by value
+    if std::ptr::eq(old, new) || old == new {
         return;
     }
 
-    if crate::utils::is_debug_cache_enabled() {
-        println!(
-            "[diff_and_update_versions_internal] {} pointer={}, old={:?}, new={:?}",
-            source, pointer, old, new
-        );
-    }
-
     match (old, new) {
         (Value::Object(a), Value::Object(b)) => {
-            let mut keys = HashSet::new();
-            for k in a.keys() {
-                keys.insert(k.as_str());
-            }
-            for k in b.keys() {
-                keys.insert(k.as_str());
-            }
-
-            for key in keys {
-                // Do not deep-diff $params at any nesting level — it is manually tracked
-                // via bump_params_version on evaluations. Skipping at root-only was insufficient
-                // when item data is diffed via a non-empty pointer prefix.
+            // Do not deep-diff $params at any nesting level — it is manually tracked
+            // via bump_params_version on evaluations. Skipping at root-only was insufficient
+            // when item data is diffed via a non-empty pointer prefix.
+            for (key, a_val) in a {
                 if key == "$params" {
                     continue;
                 }
-
-                let a_val = a.get(key).unwrap_or(&Value::Null);
                 let b_val = b.get(key).unwrap_or(&Value::Null);
-
-                let escaped_key = key.replace('~', "~0").replace('/', "~1");
                 let old_len = pointer.len();
-                pointer.push('/');
-                pointer.push_str(&escaped_key);
+                push_pointer_key(pointer, key);
                 diff_and_update_versions_internal(tracker, pointer, a_val, b_val, source);
                 pointer.truncate(old_len);
             }
+            for (key, b_val) in b {
+                if key == "$params" || a.contains_key(key) {
+                    continue;
+                }
+                let old_len = pointer.len();
+                push_pointer_key(pointer, key);
+                diff_and_update_versions_internal(tracker, pointer, &Value::Null, b_val, source);
+                pointer.truncate(old_len);
+            }
         }
         (Value::Array(a), Value::Array(b)) => {
             let max_len = a.len().max(b.len());
@@ -755,61 +1246,58 @@ fn diff_and_update_versions_internal(
             }
         }
         (old_val, new_val) => {
-            if old_val != new_val {
-                if crate::utils::is_debug_cache_enabled() {
-                    println!(
-                        "[store_cache] Catch-all for {}: old={}, new={}",
-                        pointer,
-                        match old_val {
-                            Value::Null => "Null",
-                            Value::Bool(_) => "Bool",
-                            Value::Number(_) => "Number",
-                            Value::String(_) => "String",
-                            Value::Array(_) => "Array",
-                            Value::Object(_) => "Object",
-                        },
-                        match new_val {
-                            Value::Null => "Null",
-                            Value::Bool(_) => "Bool",
-                            Value::Number(_) => "Number",
-                            Value::String(_) => "String",
-                            Value::Array(_) => "Array",
-                            Value::Object(_) => "Object",
-                        }
-                    );
-                }
-                tracker.bump(pointer, "diff_and_update_versions_internal");
+            if crate::utils::is_debug_cache_enabled() {
+                println!(
+                    "[diff_and_update_versions_internal] {} pointer={}, old={:?}, new={:?}",
+                    source, pointer, old_val, new_val
+                );
+            }
+            tracker.bump(pointer, "diff_and_update_versions_internal");
 
-                // If either side contains nested structures (e.g. Object replaced by Null, or vice versa)
-                // we must recursively bump all paths inside them so targeted cache entries invalidate.
-                if old_val.is_object() || old_val.is_array() {
-                    traverse_and_bump(tracker, pointer, old_val);
-                }
-                if new_val.is_object() || new_val.is_array() {
-                    traverse_and_bump(tracker, pointer, new_val);
-                }
+            // If either side contains nested structures (e.g. Object replaced by Null, or vice versa)
+            // we must recursively bump all paths inside them so targeted cache entries invalidate.
+            if old_val.is_object() || old_val.is_array() {
+                traverse_and_bump(tracker, pointer, old_val);
+            }
+            if new_val.is_object() || new_val.is_array() {
+                traverse_and_bump(tracker, pointer, new_val);
             }
         }
     }
 }
 
+/// Append `/key` to a JSON pointer, escaping `~` and `/` only when present
+#[inline]
+fn push_pointer_key(pointer: &mut String, key: &str) {
+    pointer.push('/');
+    if key.contains(['~', '/']) {
+        pointer.push_str(&key.replace('~', "~0").replace('/', "~1"));
+    } else {
+        pointer.push_str(key);
+    }
+}
+
 /// Recursively traverses a value and bumps the version for every nested path.
 /// Used when a structural type mismatch occurs (e.g., Object -> Null) so that
 /// cache entries depending on nested fields are correctly invalidated.
 #[cfg(test)]
 mod tests {
     use super::VersionTracker;
+    use crate::jsoneval::path_id::PathTable;
+    use serde_json::{json, Value};
+    use std::sync::Arc;
 
     #[test]
-    fn merge_excluding_prefix_keeps_item_versions_isolated() {
-        let mut item = VersionTracker::new();
+    fn merge_excluding_subtree_keeps_item_versions_isolated() {
+        let paths = Arc::new(PathTable::default());
+        let mut item = VersionTracker::new(&paths);
         item.bump("/riders/wop_flag", "test");
 
-        let mut parent = VersionTracker::new();
+        let mut parent = VersionTracker::new(&paths);
         parent.bump("/illustration/insured/phins_relation", "test");
         parent.bump("/riders/wop_flag", "test");
 
-        item.merge_excluding_prefix(&parent, "/riders/");
+        item.merge_excluding_subtree(&parent, "/riders");
 
         assert_eq!(item.get("/illustration/insured/phins_relation"), 1);
         assert_eq!(
@@ -818,6 +1306,201 @@ mod tests {
             "another rider's parent-tracker bump must not alter this item's version"
         );
     }
+
+    #[test]
+    fn snapshot_is_unaffected_by_later_bumps() {
+        let mut tracker = VersionTracker::new(&Arc::default());
+        tracker.bump("/a", "test");
+        let base = tracker.snapshot();
+        assert!(tracker.changed_since(&base).is_empty());
+
+        tracker.bump("/a", "test");
+        tracker.bump("/$params/rate", "test");
+        assert_eq!(base.get("/a"), 1);
+        assert_eq!(base.get("/$params/rate"), 0);
+        assert_eq!(tracker.get("/a"), 2);
+        assert_eq!(tracker.changed_since(&base).len(), 2);
+
+        let mut merged = base.snapshot();
+        merged.merge_from_params(&tracker);
+        assert_eq!(merged.get("/a"), 1);
+        assert_eq!(merged.get("/$params/rate"), 1);
+    }
+
+    #[test]
+    fn diff_bumps_only_changed_leaves() {
+        let old = serde_json::json!({
+            "$params": {"rate": 1},
+            "user": {"name": "John", "a/b": 1, "tags": [1, 2]},
+            "same": {"deep": {"x": 1}}
+        });
+        let new = serde_json::json!({
+            "$params": {"rate": 2},
+            "user": {"name": "Jane", "a/b": 2, "tags": [1, 2, 3], "age": 30},
+            "same": {"deep": {"x": 1}}
+        });
+
+        let mut tracker = VersionTracker::new(&Arc::default());
+        super::diff_and_update_versions(&mut tracker, "", &old, &new, "test");
+
+        for changed in ["/user/name", "/user/a~1b", "/user/tags/2", "/user/age"] {
+            assert_eq!(tracker.get(changed), 1, "{} must be bumped", changed);
+        }
+        for unchanged in ["/user", "/user/tags/0", "/same/deep/x", "/$params/rate"] {
+            assert_eq!(
+                tracker.get(unchanged),
+                0,
+                "{} must not be bumped",
+                unchanged
+            );
+        }
+
+        let mut tracker = VersionTracker::new(&Arc::default());
+        super::diff_and_update_versions(&mut tracker, "", &new, &new, "test");
+        assert_eq!(tracker.get("/user/name"), 0);
+    }
+
+    /// The diff as it was before the single-pass walk: compare with `==` first,
+    /// then descend into the union of keys
+    fn reference_diff(
+        tracker: &mut VersionTracker,
+        pointer: &mut String,
+        old: &Value,
+        new: &Value,
+    ) {
+        if old == new {
+            return;
+        }
+        match (old, new) {
+            (Value::Object(a), Value::Object(b)) => {
+                let keys: std::collections::BTreeSet<&String> = a.keys().chain(b.keys()).collect();
+                for key in keys {
+                    if key == "$params" {
+                        continue;
+                    }
+                    let old_len = pointer.len();
+                    pointer.push('/');
+                    pointer.push_str(&key.replace('~', "~0").replace('/', "~1"));
+                    let a_val = a.get(key).unwrap_or(&Value::Null);
+                    let b_val = b.get(key).unwrap_or(&Value::Null);
+                    reference_diff(tracker, pointer, a_val, b_val);
+                    pointer.truncate(old_len);
+                }
+            }
+            (Value::Array(a), Value::Array(b)) => {
+                for i in 0..a.len().max(b.len()) {
+                    let old_len = pointer.len();
+                    pointer.push_str(&format!("/{}", i));
+                    let a_val = a.get(i).unwrap_or(&Value::Null);
+                    let b_val = b.get(i).unwrap_or(&Value::Null);
+                    reference_diff(tracker, pointer, a_val, b_val);
+                    pointer.truncate(old_len);
+                }
+            }
+            (old_val, new_val) => {
+                tracker.bump(pointer, "test");
+                for val in [old_val, new_val] {
+                    if val.is_object() || val.is_array() {
+                        super::traverse_and_bump(tracker, pointer, val);
+                    }
+                }
+            }
+        }
+    }
+
+    fn bumped(tracker: &VersionTracker) -> Vec<(String, u64)> {
+        let mut bumped: Vec<(String, u64)> = tracker
+            .versions()
+            .map(|(path, version)| (path.to_string(), version))
+            .collect();
+        bumped.sort();
+        bumped
+    }
+
+    #[test]
+    fn diff_bumps_the_same_paths_as_the_reference_diff() {
+        let cases = [
+            // changed leaves, including escaped keys and nested arrays
+            (
+                json!({"user": {"name": "John", "a/b~c": 1, "tags": [1, [2, 3]]}}),
+                json!({"user": {"name": "Jane", "a/b~c": 2, "tags": [1, [2, 4]]}}),
+            ),
+            // added keys, with nested values that get bumped as a whole
+            (
+                json!({"user": {"name": "John"}}),
+                json!({"user": {"name": "John", "address": {"city": "X", "zip": [1, 2]}}, "flag": true}),
+            ),
+            // removed keys
+            (
+                json!({"user": {"name": "John", "address": {"city": "X"}}, "flag": true}),
+                json!({"user": {"name": "John"}}),
+            ),
+            // arrays growing and shrinking, and type changes
+            (
+                json!({"rows": [{"a": 1}, {"a": 2}, {"a": 3}], "obj": {"x": 1}, "n": 1}),
+                json!({"rows": [{"a": 1}, {"b": 2}], "obj": null, "n": "1"}),
+            ),
+            // $params is skipped at every level
+            (
+                json!({"$params": {"rate": 1}, "item": {"$params": {"x": 1}, "v": 1}}),
+                json!({"$params": {"rate": 2}, "item": {"$params": {"x": 2}, "v": 1}}),
+            ),
+            // equal content at different addresses
+            (
+                json!({"same": {"deep": {"x": [1, 2, {"y": null}]}}}),
+                json!({"same": {"deep": {"x": [1, 2, {"y": null}]}}}),
+            ),
+        ];
+
+        for (old, new) in &cases {
+            for prefix in ["", "/riders/0"] {
+                let mut tracker = VersionTracker::new(&Arc::default());
+                super::diff_and_update_versions(&mut tracker, prefix, old, new, "test");
+
+                let mut expected = VersionTracker::new(&Arc::default());
+                reference_diff(&mut expected, &mut prefix.to_string(), old, new);
+
+                assert_eq!(
+                    bumped(&tracker),
+                    bumped(&expected),
+                    "diff of {} -> {} under '{}'",
+                    old,
+                    new,
+                    prefix
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn diff_skips_shared_and_equal_subtrees() {
+        let shared = json!({"deep": {"x": [1, 2, 3], "y": {"z": "s"}}});
+        let old = json!({"shared": shared.clone(), "leaf": 1});
+        let mut new = old.clone();
+        new["leaf"] = json!(2);
+
+        // The same node on both sides is skipped without being walked
+        let mut tracker = VersionTracker::new(&Arc::default());
+        let mut pointer = String::from("/shared");
+        super::diff_and_update_versions_internal(
+            &mut tracker,
+            &mut pointer,
+            &shared,
+            &shared,
+            "test",
+        );
+        assert!(bumped(&tracker).is_empty());
+        assert_eq!(pointer, "/shared");
+
+        // Whole-snapshot identity bumps nothing either, while a real change still does
+        super::diff_and_update_versions(&mut tracker, "", &new, &new, "test");
+        assert!(bumped(&tracker).is_empty());
+        let copy = new.clone();
+        super::diff_and_update_versions(&mut tracker, "", &new, &copy, "test");
+        assert!(bumped(&tracker).is_empty());
+        super::diff_and_update_versions(&mut tracker, "", &old, &new, "test");
+        assert_eq!(bumped(&tracker), vec![("/leaf".to_string(), 1)]);
+    }
 }
 
 fn traverse_and_bump(tracker: &mut VersionTracker, pointer: &mut String, val: &Value) {
@@ -827,10 +1510,8 @@ fn traverse_and_bump(tracker: &mut VersionTracker, pointer: &mut String, val: &V
                 if key == "$params" {
                     continue; // Skip the special top-level params branch if it leaked here
                 }
-                let escaped_key = key.replace('~', "~0").replace('/', "~1");
                 let old_len = pointer.len();
-                pointer.push('/');
-                pointer.push_str(&escaped_key);
+                push_pointer_key(pointer, key);
                 tracker.bump(pointer, "traverse_and_bump1");
                 traverse_and_bump(tracker, pointer, v);
                 pointer.truncate(old_len);
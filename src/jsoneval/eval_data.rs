@@ -31,10 +31,15 @@ pub struct DataVersion(pub u64);
 ///
 /// - Read operations are zero-cost (direct Arc dereference)
 /// - Clone operations are cheap (Arc reference counting)
-/// - First mutation triggers deep clone via Arc::make_mut
+/// - Snapshots (`snapshot_data`) share the tree and are O(1); prefer them over
+///   `snapshot_data_clone` when the snapshot is only read or diffed
+/// - First mutation triggers deep clone via Arc::make_mut, except for
+///   `replace_data_and_context`, which copies only the root entries it keeps
 /// - Subsequent mutations on exclusive owner are zero-cost
 pub struct EvalData {
     instance_id: u64,
+    /// Incremented whenever `replace_data_and_context` swaps in a new payload
+    replacements: u64,
     data: Arc<Value>,
 }
 
@@ -43,6 +48,7 @@ impl EvalData {
     pub fn new(data: Value) -> Self {
         Self {
             instance_id: NEXT_INSTANCE_ID.fetch_add(1, Ordering::Relaxed),
+            replacements: 0,
             data: Arc::new(data),
         }
     }
@@ -56,6 +62,7 @@ impl EvalData {
     pub fn from_arc(data: Arc<Value>) -> Self {
         Self {
             instance_id: NEXT_INSTANCE_ID.fetch_add(1, Ordering::Relaxed),
+            replacements: 0,
             data,
         }
     }
@@ -88,19 +95,44 @@ impl EvalData {
     }
 
     /// Replace data and context in existing EvalData (for evaluation updates)
-    /// Uses CoW: replaces Arc, no clone needed if not shared
+    ///
+    /// Input values are moved in, never cloned. When the data is shared with a
+    /// snapshot, the root is rebuilt instead of going through `Arc::make_mut`:
+    /// only the root entries the new payload does not replace (typically `$params`)
+    /// are copied, and the snapshot keeps the old tree untouched.
     pub fn replace_data_and_context(&mut self, input_data: Value, context_data: Value) {
-        let Some(input_obj) = input_data.as_object() else {
+        let Value::Object(input_obj) = input_data else {
             // Public evaluation entry points accept JSON text. A non-object root cannot
             // represent form data, but must not abort the process through `unwrap()`.
             return;
         };
+        self.replacements += 1;
 
-        let data = Arc::make_mut(&mut self.data); // CoW: clone only if shared
-        input_obj.iter().for_each(|(key, value)| {
-            Self::set_by_pointer(data, &format!("/{key}"), value.clone());
-        });
-        Self::set_by_pointer(data, "/$context", context_data);
+        if Arc::get_mut(&mut self.data).is_none() {
+            // Shared: placeholders keep the key order of replaced entries without copying them
+            let Value::Object(old_root) = &*self.data else {
+                return;
+            };
+            let root: Map<String, Value> = old_root
+                .iter()
+                .map(|(key, value)| {
+                    if key == "$context" || input_obj.contains_key(key) {
+                        (key.clone(), Value::Null)
+                    } else {
+                        (key.clone(), value.clone())
+                    }
+                })
+                .collect();
+            self.data = Arc::new(Value::Object(root));
+        }
+
+        let Some(Value::Object(root)) = Arc::get_mut(&mut self.data) else {
+            return;
+        };
+        for (key, value) in input_obj {
+            root.insert(key, value);
+        }
+        root.insert("$context".to_string(), context_data);
     }
 
     /// Get the unique instance ID
@@ -109,6 +141,14 @@ impl EvalData {
         self.instance_id
     }
 
+    /// Identifies the current payload: instance id and replacement count.
+    /// In-place writes (`set`, `push_to_array`, ...) keep it; replacing the
+    /// payload changes it, so values written by earlier passes may be gone.
+    #[inline(always)]
+    pub fn payload_id(&self) -> (u64, u64) {
+        (self.instance_id, self.replacements)
+    }
+
     /// Get a reference to the underlying data (read-only)
     /// Zero-cost access via Arc dereference
     #[inline(always)]
@@ -116,7 +156,7 @@ impl EvalData {
         &*self.data
     }
 
-    /// Clone a Value without certain keys
+    /// O(1) snapshot sharing the current tree; later writes copy-on-write away from it
     #[inline(always)]
     pub fn snapshot_data(&self) -> Arc<Value> {
         Arc::clone(&self.data)
@@ -267,7 +307,7 @@ impl EvalData {
     }
 
     /// Set a value by JSON pointer, creating intermediate structures as needed
-    fn set_by_pointer(data: &mut Value, pointer: &str, new_value: Value) {
+    pub(crate) fn set_by_pointer(data: &mut Value, pointer: &str, new_value: Value) {
         if pointer.is_empty() {
             return;
         }
@@ -347,7 +387,8 @@ impl Clone for EvalData {
     fn clone(&self) -> Self {
         Self {
             instance_id: self.instance_id, // Keep same ID for clones
-            data: Arc::clone(&self.data),  // CoW: cheap Arc clone (ref count only)
+            replacements: self.replacements,
+            data: Arc::clone(&self.data), // CoW: cheap Arc clone (ref count only)
         }
     }
 }
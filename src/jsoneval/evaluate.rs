@@ -2,8 +2,11 @@ use std::sync::Arc;
 
 use super::JSONEval;
 use crate::jsoneval::cancellation::CancellationToken;
+use crate::jsoneval::dirty_set::{DirtyQueue, EvalGraph, NodeKind};
 use crate::jsoneval::eval_data::EvalData;
 use crate::jsoneval::json_parser;
+use crate::jsoneval::path_filter::PathFilter;
+use crate::jsoneval::path_id::PathId;
 use crate::jsoneval::path_utils;
 use crate::jsoneval::table_evaluate;
 use crate::time_block;
@@ -80,6 +83,7 @@ impl JSONEval {
         paths: Option<&[String]>,
         token: Option<&CancellationToken>,
     ) -> Result<(), String> {
+        self.invalidate_outputs();
         time_block!("  evaluate_internal_with_new_data", {
             // Reuse the previously stored snapshot as `old_data` to avoid an O(n) deep clone
             // on every main-form evaluation call.
@@ -88,7 +92,7 @@ impl JSONEval {
                 .eval_cache
                 .main_form_snapshot
                 .take()
-                .unwrap_or_else(|| self.eval_data.snapshot_data_clone());
+                .unwrap_or_else(|| self.eval_data.snapshot_data());
 
             let old_context = self
                 .eval_data
@@ -104,7 +108,7 @@ impl JSONEval {
                 self.eval_data.replace_data_and_context(data, context);
             });
 
-            let new_data = self.eval_data.snapshot_data_clone();
+            let new_data = self.eval_data.snapshot_data();
             let new_context = self
                 .eval_data
                 .data()
@@ -113,7 +117,7 @@ impl JSONEval {
                 .unwrap_or(Value::Null);
 
             if has_previous_eval
-                && old_data == new_data
+                && (Arc::ptr_eq(&old_data, &new_data) || old_data == new_data)
                 && old_context == new_context
                 && paths.is_none()
             {
@@ -129,27 +133,26 @@ impl JSONEval {
             // time the user opens a rider (`evaluate_subform`), the cache is empty (item_snapshot=Null).
             // The diff between Null and the full rider data will then mark EVERY field (sa, code, etc.)
             // as "changed", spuriously bumping secondary trackers and causing false T2 table misses.
+            // Items that already have a snapshot keep it: the next item scope diffs it against the
+            // new item, which is how edits made through this payload reach the item caches.
             for (subform_path, subform) in &mut self.subforms {
                 let subform_ptr =
                     crate::jsoneval::path_utils::normalize_to_json_pointer(subform_path);
                 if let Some(items) = new_data.pointer(&subform_ptr).and_then(|v| v.as_array()) {
                     for (idx, item_val) in items.iter().enumerate() {
-                        self.eval_cache.ensure_active_item_cache(idx);
-                        if let Some(c) = self.eval_cache.subform_caches.get_mut(&idx) {
-                            c.item_snapshot = item_val.clone();
-                        }
-                        subform.eval_cache.ensure_active_item_cache(idx);
-                        if let Some(c) = subform.eval_cache.subform_caches.get_mut(&idx) {
-                            c.item_snapshot = item_val.clone();
-                        }
+                        self.eval_cache.seed_item_snapshot(idx, item_val);
+                        subform.eval_cache.seed_item_snapshot(idx, item_val);
                     }
                 }
             }
 
             self.eval_cache
                 .store_snapshot_and_diff_versions(&old_data, &new_data);
-            // Save snapshot for the next evaluation cycle (avoids one snapshot_data_clone() call)
-            self.eval_cache.main_form_snapshot = Some(new_data.clone());
+            // Save snapshot for the next evaluation cycle (O(1): shares the eval_data tree).
+            // The snapshot is held across the write phase, so the first eval_data write
+            // below copies the document once through Arc::make_mut; the snapshot keeps
+            // the payload as received for the next diff.
+            self.eval_cache.main_form_snapshot = Some(Arc::clone(&new_data));
 
             // Detect subform array structural changes: length differences OR item identity shifts
             // (e.g., rider reorder). When items move indices their per-index T1 caches are misaligned,
@@ -157,27 +160,39 @@ impl JSONEval {
             // evicted — the parent diff only bumps indexed full paths like
             // `/illustration/product_benefit/riders/2/code`, which never match the stored dep key.
             self.invalidate_subform_caches_on_structural_change(&old_data, &new_data);
+            drop((old_data, new_data));
 
-            // Generation-based fast skip: diff_and_update_versions bumps data_versions.versions
-            // but does NOT increment eval_generation. Only bump_data_version / bump_params_version
-            // (called from formula stores) advance eval_generation.
-            // If eval_generation == last_evaluated_generation after the diff, no formula's cached
-            // deps are actually stale — all batches would be cache hits. Skip the full traversal.
-            // Safe only in the external evaluate() path; run_re_evaluate_pass must always evaluate.
-            if paths.is_none() && !self.eval_cache.needs_full_evaluation() {
-                self.evaluate_others(paths, token);
-                return Ok(());
-            }
+            self.evaluate_after_data_change(paths, token)
+        })
+    }
+
+    /// Run the evaluation passes after input data changed and its versions were bumped.
+    /// Shared by `evaluate_internal_with_new_data` and `set_values`.
+    pub(crate) fn evaluate_after_data_change(
+        &mut self,
+        paths: Option<&[String]>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        // Fast skip when nothing moved since the last completed pass: no formula store
+        // advanced eval_generation, and no tracked version (input diffs included, which
+        // do not touch eval_generation) differs from the clean baseline.
+        // Safe only in the external evaluate() path; run_re_evaluate_pass must always evaluate.
+        if paths.is_none()
+            && !self.eval_cache.needs_full_evaluation()
+            && self.eval_cache.is_clean(self.eval_data.payload_id())
+        {
+            self.evaluate_others(paths, token);
+            return Ok(());
+        }
 
-            // Resolve visibility first, then initialize visible static defaults before
-            // final formula pass. Without this, first full evaluation sees `null`
-            // for optional defaulted inputs such as ZPP's ph_em multiplier.
+        // Resolve visibility first, then initialize visible static defaults before
+        // final formula pass. Without this, first full evaluation sees `null`
+        // for optional defaulted inputs such as ZPP's ph_em multiplier.
+        self.evaluate_internal(paths, token)?;
+        if self.apply_visible_static_defaults() {
             self.evaluate_internal(paths, token)?;
-            if self.apply_visible_static_defaults() {
-                self.evaluate_internal(paths, token)?;
-            }
-            Ok(())
-        })
+        }
+        Ok(())
     }
 
     /// Detect structural changes in subform arrays between `old_data` and `new_data`
@@ -187,50 +202,63 @@ impl JSONEval {
         old_data: &Value,
         new_data: &Value,
     ) {
-        for (subform_path, _) in &self.subforms {
+        let subform_ptrs: Vec<String> = self
+            .subforms
+            .keys()
+            .map(|path| crate::jsoneval::path_utils::schema_path_to_data_pointer(path).into_owned())
+            .collect();
+        for subform_ptr in subform_ptrs {
             // Resolve the data pointer for this subform
             // (e.g., `/illustration/product_benefit/riders`)
-            let subform_ptr =
-                crate::jsoneval::path_utils::schema_path_to_data_pointer(subform_path).to_string();
-
             let old_items = old_data.pointer(&subform_ptr).and_then(Value::as_array);
             let new_items = new_data.pointer(&subform_ptr).and_then(Value::as_array);
+            self.invalidate_subform_items(&subform_ptr, old_items, new_items);
+        }
+    }
 
-            let old_len = old_items.map(Vec::len).unwrap_or(0);
-            let new_len = new_items.map(Vec::len).unwrap_or(0);
-            let min_len = old_len.min(new_len);
-
-            // Detect identity shift in the overlapping index range using subset comparison.
-            // We check whether the raw input fields of new_items[i] all match old_items[i],
-            // ignoring extra computed keys that only exist in the old snapshot.
-            let identities_shifted = (0..min_len).any(|i| {
-                let old_item = old_items.and_then(|a| a.get(i));
-                let new_item = new_items.and_then(|a| a.get(i));
-                !items_same_input_identity(old_item, new_item)
-            });
+    /// Evict stale caches for one subform array whose items changed from
+    /// `old_items` to `new_items` (length change or item identity shift).
+    pub(crate) fn invalidate_subform_items(
+        &mut self,
+        subform_ptr: &str,
+        old_items: Option<&Vec<Value>>,
+        new_items: Option<&Vec<Value>>,
+    ) {
+        let old_len = old_items.map(Vec::len).unwrap_or(0);
+        let new_len = new_items.map(Vec::len).unwrap_or(0);
+        let min_len = old_len.min(new_len);
+
+        // Detect identity shift in the overlapping index range using subset comparison.
+        // We check whether the raw input fields of new_items[i] all match old_items[i],
+        // ignoring extra computed keys that only exist in the old snapshot.
+        let identities_shifted = (0..min_len).any(|i| {
+            let old_item = old_items.and_then(|a| a.get(i));
+            let new_item = new_items.and_then(|a| a.get(i));
+            !items_same_input_identity(old_item, new_item)
+        });
 
-            if old_len == new_len && !identities_shifted {
-                continue; // No structural change for this subform
-            }
+        if old_len == new_len && !identities_shifted {
+            return; // No structural change for this subform
+        }
 
-            // Build the subform-local dep-path prefix stored in T2 dep_versions
-            // (e.g., `/riders/` for a riders subform). T2 dep keys are normalized data
-            // paths — never schema paths — so only one prefix is needed.
-            let field_key = subform_ptr
-                .split('/')
-                .next_back()
-                .unwrap_or(subform_ptr.as_str());
-            let subform_dep_prefix = format!("/{}/", field_key);
-
-            // Evict T2 global entries whose deps include any subform-local path.
-            // `retain` evicts inline (no intermediate Vec allocation).
-            // Collect the normalized path of each evicted key for the params_versions bump.
-            let mut evicted_paths: Vec<String> = Vec::new();
-            self.eval_cache.entries.retain(|eval_key, entry| {
+        // Subform-local dependencies stored in T2 dep_versions live under the
+        // subform's root (e.g., `/riders` for a riders subform). T2 dep keys are
+        // normalized data paths — never schema paths — so only one root is needed.
+        let field_key = subform_ptr.split('/').next_back().unwrap_or(subform_ptr);
+        let paths = Arc::clone(self.eval_cache.paths());
+        let subform_root = paths.lookup(&format!("/{}", field_key));
+
+        // Evict T2 global entries whose deps include any subform-local path.
+        // `retain` evicts inline (no intermediate Vec allocation).
+        // Collect the normalized path of each evicted key for the params_versions bump.
+        let mut evicted_paths: Vec<String> = Vec::new();
+        if let Some(subform_root) = subform_root {
+            let paths = paths.read();
+            Arc::make_mut(&mut self.eval_cache.entries).retain(|eval_key, entry| {
                 let has_subform_dep = entry
                     .dep_versions
-                    .keys()
-                    .any(|dep| dep.starts_with(&subform_dep_prefix));
+                    .iter()
+                    .any(|&(dep, _)| paths.is_within(dep, subform_root));
 
                 if has_subform_dep {
                     let normalized =
@@ -241,34 +269,37 @@ impl JSONEval {
                     true // keep
                 }
             });
+        }
 
-            // Bump params_versions for every evicted T2 entry so downstream $params formulas
-            // (SA_WOP_RIDER, TOTAL_WOP_SA, etc.) correctly miss their caches.
-            for path in &evicted_paths {
-                self.eval_cache
-                    .params_versions
-                    .bump(path, "invalidate_subform_caches_on_structural_change");
-            }
+        // Bump params_versions for every evicted T2 entry so downstream $params formulas
+        // (SA_WOP_RIDER, TOTAL_WOP_SA, etc.) correctly miss their caches.
+        for path in &evicted_paths {
+            self.eval_cache
+                .params_versions
+                .bump(path, "invalidate_subform_caches_on_structural_change");
+        }
 
-            // Clear T1 per-item caches for indices where item identity has shifted.
-            // This prevents stale per-rider results being reused for a different rider
-            // occupying the same array slot after a reorder.
-            for idx in 0..min_len {
-                let old_item = old_items.and_then(|a| a.get(idx));
-                let new_item = new_items.and_then(|a| a.get(idx));
-                if !items_same_input_identity(old_item, new_item) {
-                    if let Some(c) = self.eval_cache.subform_caches.get_mut(&idx) {
-                        c.entries.clear();
-                        c.data_versions = crate::jsoneval::eval_cache::VersionTracker::new();
-                    }
+        // Clear T1 per-item caches for indices where item identity has shifted.
+        // This prevents stale per-rider results being reused for a different rider
+        // occupying the same array slot after a reorder.
+        for idx in 0..min_len {
+            let old_item = old_items.and_then(|a| a.get(idx));
+            let new_item = new_items.and_then(|a| a.get(idx));
+            if !items_same_input_identity(old_item, new_item) {
+                if let Some(c) = self.eval_cache.subform_caches.get_mut(&idx) {
+                    c.entries.clear();
+                    c.data_versions = crate::jsoneval::eval_cache::VersionTracker::new(&paths);
                 }
             }
-            // Prune T1 caches for indices that no longer exist (removed items)
-            self.eval_cache.prune_subform_caches(new_len);
+        }
+        // Prune T1 caches for indices that no longer exist (removed items)
+        self.eval_cache.prune_subform_caches(new_len);
 
-            if !evicted_paths.is_empty() || old_len != new_len {
-                self.eval_cache.eval_generation += 1;
-            }
+        if !evicted_paths.is_empty() {
+            self.eval_cache.invalidate_clean_baseline();
+        }
+        if !evicted_paths.is_empty() || old_len != new_len {
+            self.eval_cache.eval_generation += 1;
         }
     }
 
@@ -320,343 +351,382 @@ impl JSONEval {
             // Acquire lock for synchronous execution
             let _lock = self.eval_lock.lock().unwrap();
 
-            // Normalize paths to schema pointers for correct filtering
-            let normalized_paths_storage; // Keep alive
-            let normalized_paths = if let Some(p_list) = paths {
-                normalized_paths_storage = p_list
-                    .iter()
-                    .flat_map(|p| {
-                        let normalized = if p.starts_with("#/") {
-                            p.to_string()
-                        } else if p.starts_with('/') {
-                            format!("#{}", p)
-                        } else {
-                            format!("#/{}", p.replace('.', "/"))
-                        };
-                        vec![normalized]
-                    })
-                    .collect::<Vec<_>>();
-                Some(normalized_paths_storage.as_slice())
+            // Compile selective paths into a prefix trie (schema pointers) once per call
+            let filter = paths.and_then(PathFilter::from_selectors);
+
+            // A main-form pass over every formula can visit just the dirty cone when a
+            // clean baseline exists; once it completes, its starting versions become the
+            // next baseline.
+            let full_coverage = filter.is_none() && self.eval_cache.active_item_index.is_none();
+            let payload_id = self.eval_data.payload_id();
+            let baseline = full_coverage.then(|| self.eval_cache.baseline_from_here(payload_id));
+            let dirty_seeds = if full_coverage {
+                self.eval_cache.dirty_seeds(payload_id)
             } else {
                 None
             };
 
-            // Borrow sorted_evaluations via Arc (avoid deep-cloning Vec<Vec<String>>)
-            let eval_batches = self.sorted_evaluations.clone();
-
-            // Process each batch - sequentially
-            // Batches are processed sequentially to maintain dependency order
-            // Process value evaluations (simple computed fields with no dependencies)
-            let eval_data_values = self.eval_data.clone();
-            time_block!("      evaluate values", {
-                for eval_key in self.value_evaluations.iter() {
-                    if let Some(t) = token {
-                        if t.is_cancelled() {
-                            return Err("Cancelled".to_string());
-                        }
-                    }
-                    // Skip if has dependencies (handled in sorted batches with correct ordering)
-                    if let Some(deps) = self.dependencies.get(eval_key) {
-                        if !deps.is_empty() {
-                            continue;
-                        }
-                    }
+            // Drop the lock before calling per-formula methods that need &mut self
+            drop(_lock);
 
-                    // Filter items if paths are provided
-                    if let Some(filter_paths) = normalized_paths {
-                        if !filter_paths.is_empty()
-                            && !filter_paths.iter().any(|p| {
-                                eval_key.starts_with(p.as_str()) || p.starts_with(eval_key.as_str())
-                            })
-                        {
-                            continue;
-                        }
-                    }
+            if let Some(seeds) = dirty_seeds {
+                time_block!("    evaluate dirty set", {
+                    self.evaluate_dirty(&seeds, token)?;
+                });
+            } else {
+                self.evaluate_all_formulas(filter.as_ref(), token)?;
+            }
 
-                    let pointer_path = path_utils::normalize_to_json_pointer(eval_key).into_owned();
-                    let empty_deps = indexmap::IndexSet::new();
-                    let deps = self.dependencies.get(eval_key).unwrap_or(&empty_deps);
+            if let Some(baseline) = baseline {
+                self.eval_cache.clean_baseline = Some(baseline);
+            }
 
-                    // Cache hit check
-                    if let Some(_cached_result) = self.eval_cache.check_cache(eval_key, deps) {
-                        continue;
-                    }
+            // Mark generation stable so the next evaluate_internal call can detect whether
+            // any formula was actually re-stored (via bump_data/params_version) since this run.
+            self.eval_cache.mark_evaluated();
 
-                    // Cache miss - evaluate
-                    if let Some(logic_id) = self.evaluations.get(eval_key) {
-                        match self.engine.run(logic_id, eval_data_values.data()) {
-                            Ok(val) => {
-                                let cleaned_val = clean_float_noise_scalar(val);
-                                self.eval_cache
-                                    .store_cache(eval_key, deps, cleaned_val.clone());
+            self.evaluate_others(paths, token);
 
-                                if let Some(pointer_value) =
-                                    self.evaluated_schema.pointer_mut(&pointer_path)
-                                {
-                                    *pointer_value = cleaned_val;
-                                }
-                            }
-                            Err(_) => {
-                                // Formula failed — ensure no raw $evaluation object leaks.
-                                // Write null only if the node still holds the unevaluated formula.
-                                if let Some(node) = self.evaluated_schema.pointer_mut(&pointer_path)
-                                {
-                                    if node.is_object() && node.get("$evaluation").is_some() {
-                                        *node = Value::Null;
-                                    }
-                                }
-                            }
-                        }
+            Ok(())
+        })
+    }
+
+    /// Visit every formula in dependency order (optionally restricted by `filter`),
+    /// validating each against the cache.
+    fn evaluate_all_formulas(
+        &mut self,
+        filter: Option<&PathFilter>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        // Borrow sorted_evaluations via Arc (avoid deep-cloning Vec<Vec<String>>)
+        let eval_batches = self.sorted_evaluations.clone();
+        let value_evaluations = self.value_evaluations.clone();
+
+        // Process each batch - sequentially
+        // Batches are processed sequentially to maintain dependency order
+        // Process value evaluations (simple computed fields with no dependencies)
+        time_block!("      evaluate values", {
+            for eval_key in value_evaluations.iter() {
+                if let Some(t) = token {
+                    if t.is_cancelled() {
+                        return Err("Cancelled".to_string());
                     }
                 }
-            });
-
-            time_block!("    process batches", {
-                for batch in eval_batches.iter() {
-                    if let Some(t) = token {
-                        if t.is_cancelled() {
-                            return Err("Cancelled".to_string());
-                        }
+                // Skip if has dependencies (handled in sorted batches with correct ordering)
+                if let Some(deps) = self.dependencies.get(eval_key) {
+                    if !deps.is_empty() {
+                        continue;
                     }
-                    // Skip empty batches
-                    if batch.is_empty() {
+                }
+
+                // Filter items if paths are provided
+                if let Some(filter) = &filter {
+                    if !filter.matches(eval_key) {
                         continue;
                     }
+                }
 
-                    // Check if we can skip this entire batch optimization
-                    let batch_skipped = time_block!("      batch filter check", {
-                        if let Some(filter_paths) = normalized_paths {
-                            if !filter_paths.is_empty() {
-                                let batch_has_match = batch.iter().any(|eval_key| {
-                                    filter_paths.iter().any(|p| {
-                                        eval_key.starts_with(p.as_str())
-                                            || (p.starts_with(eval_key.as_str())
-                                                && !eval_key.contains("/$params/"))
-                                    })
-                                });
-                                !batch_has_match
-                            } else {
-                                false
-                            }
+                self.evaluate_value_formula(eval_key);
+            }
+        });
+
+        time_block!("    process batches", {
+            for batch in eval_batches.iter() {
+                if let Some(t) = token {
+                    if t.is_cancelled() {
+                        return Err("Cancelled".to_string());
+                    }
+                }
+                // Skip empty batches
+                if batch.is_empty() {
+                    continue;
+                }
+
+                // Check if we can skip this entire batch optimization
+                let batch_skipped = time_block!("      batch filter check", {
+                    filter
+                        .as_ref()
+                        .is_some_and(|f| !batch.iter().any(|eval_key| f.matches_key(eval_key)))
+                });
+                if batch_skipped {
+                    continue;
+                }
+
+                // Fast path: try to resolve every eval_key in this batch from cache.
+                // If all hit, skip the expensive exclusive_clone() of the full eval_data tree.
+                // This is critical for subforms where eval_data contains the full parent payload.
+                let all_cache_hit = time_block!("      batch cache fast path", {
+                    let mut batch_hits: Vec<(String, Value)> = Vec::with_capacity(batch.len());
+                    let all_hit = batch.iter().all(|eval_key| {
+                        let deps = self.dependency_ids.of(eval_key);
+                        if let Some(cached) = self.eval_cache.check_cache(eval_key, deps) {
+                            let pointer_path =
+                                path_utils::normalize_to_json_pointer(eval_key).into_owned();
+                            batch_hits.push((pointer_path, cached));
+                            true
                         } else {
                             false
                         }
                     });
-                    if batch_skipped {
-                        continue;
-                    }
 
-                    // Fast path: try to resolve every eval_key in this batch from cache.
-                    // If all hit, skip the expensive exclusive_clone() of the full eval_data tree.
-                    // This is critical for subforms where eval_data contains the full parent payload.
-                    let all_cache_hit = time_block!("      batch cache fast path", {
-                        let mut batch_hits: Vec<(String, Value)> = Vec::with_capacity(batch.len());
-                        let all_hit = batch.iter().all(|eval_key| {
-                            let empty_deps = indexmap::IndexSet::new();
-                            let deps = self.dependencies.get(eval_key).unwrap_or(&empty_deps);
-                            if let Some(cached) = self.eval_cache.check_cache(eval_key, deps) {
-                                let pointer_path =
-                                    path_utils::normalize_to_json_pointer(eval_key).into_owned();
-                                batch_hits.push((pointer_path, cached));
-                                true
-                            } else {
-                                false
-                            }
-                        });
-
-                        if all_hit {
-                            // Populate eval_data AND evaluated_schema so both downstream batches
-                            // and get_evaluated_schema callers see the correct per-item values.
-                            // Previously only eval_data was written here, leaving evaluated_schema
-                            // with stale values from the last full-miss evaluation (e.g. the first
-                            // rider), causing all riders to report the same schema outputs.
-                            for (ptr, val) in batch_hits {
-                                self.eval_data.set(&ptr, val.clone());
-                                if let Some(schema_value) = self.evaluated_schema.pointer_mut(&ptr)
-                                {
-                                    *schema_value = val;
-                                }
+                    if all_hit {
+                        // Populate eval_data AND evaluated_schema so both downstream batches
+                        // and get_evaluated_schema callers see the correct per-item values.
+                        // Previously only eval_data was written here, leaving evaluated_schema
+                        // with stale values from the last full-miss evaluation (e.g. the first
+                        // rider), causing all riders to report the same schema outputs.
+                        for (ptr, val) in batch_hits {
+                            self.eval_data.set(&ptr, val.clone());
+                            if let Some(schema_value) = self.evaluated_schema.pointer_mut(&ptr) {
+                                *schema_value = val;
                             }
                         }
-                        // Partial or full miss — fall through to the normal exclusive_clone path below.
-                        // batch_hits is dropped here; cache lookups will repeat but that's cheap.
-                        all_hit
-                    });
-                    if all_cache_hit {
-                        continue;
                     }
+                    // Partial or full miss — fall through to the normal exclusive_clone path below.
+                    // batch_hits is dropped here; cache lookups will repeat but that's cheap.
+                    all_hit
+                });
+                if all_cache_hit {
+                    continue;
+                }
 
-                    // Sequential execution.
-                    // For each formula miss, snapshot_data() gives an O(1) Arc::clone
-                    // as a stable read view. The Arc is dropped before self.eval_data.set()
-                    // so Arc::make_mut always finds rc=1 — zero deep copy, zero latency.
-                    time_block!("      batch sequential eval", {
-                        for eval_key in batch {
-                            if let Some(t) = token {
-                                if t.is_cancelled() {
-                                    return Err("Cancelled".to_string());
-                                }
+                // Sequential execution.
+                // For each formula miss, snapshot_data() gives an O(1) Arc::clone
+                // as a stable read view. The Arc is dropped before self.eval_data.set(),
+                // so these views never force a copy. Only main_form_snapshot outlives
+                // them: the first set() after a payload change copies the document once.
+                time_block!("      batch sequential eval", {
+                    for eval_key in batch {
+                        if let Some(t) = token {
+                            if t.is_cancelled() {
+                                return Err("Cancelled".to_string());
                             }
-                            // Filter individual items if paths are provided
-                            if let Some(filter_paths) = normalized_paths {
-                                if !filter_paths.is_empty()
-                                    && !filter_paths.iter().any(|p| {
-                                        eval_key.starts_with(p.as_str())
-                                            || (p.starts_with(eval_key.as_str())
-                                                && !eval_key.contains("/$params/"))
-                                    })
-                                {
-                                    continue;
-                                }
+                        }
+                        // Filter individual items if paths are provided
+                        if let Some(filter) = &filter {
+                            if !filter.matches_key(eval_key) {
+                                continue;
                             }
+                        }
 
-                            let pointer_path =
-                                path_utils::normalize_to_json_pointer(eval_key).into_owned();
+                        self.evaluate_batch_formula(eval_key, token);
+                    }
+                });
+            }
+        });
+        Ok(())
+    }
 
-                            // Cache miss - evaluate
-                            let is_table = self.table_metadata.contains_key(eval_key);
-
-                            if is_table {
-                                time_block!("        table eval", {
-                                    // Snapshot for table read access: Arc::clone is O(1).
-                                    // Scoped so it's dropped before self.eval_data.set() below,
-                                    // keeping self.eval_data.data at rc=1 so Arc::make_mut is free.
-                                    let table_result = {
-                                        let table_scope =
-                                            EvalData::from_arc(self.eval_data.snapshot_data());
-                                        table_evaluate::evaluate_table(
-                                            self,
-                                            eval_key,
-                                            &table_scope,
-                                            token,
-                                        )
-                                        // table_scope dropped here → rc back to 1
-                                    };
-                                    if let Ok((rows, external_deps_opt)) = table_result {
-                                        let result_val = Value::Array(rows);
-                                        if let Some(external_deps) = external_deps_opt {
-                                            self.eval_cache.store_cache(
-                                                eval_key,
-                                                &external_deps,
-                                                result_val.clone(),
-                                            );
-                                        }
+    /// Visit only the formulas reachable from `seeds` (paths bumped since the clean
+    /// baseline), in dependency order. Paths bumped by a re-evaluated formula queue
+    /// its readers in turn.
+    fn evaluate_dirty(
+        &mut self,
+        seeds: &[PathId],
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        let graph = self.eval_graph();
+        let mut queue = DirtyQueue::new(&graph, seeds);
+        let mut cancelled = false;
 
-                                        // NOTE: bump_params_version / bump_data_version for table results
-                                        // is now handled inside store_cache (conditional on value change).
-                                        // The separate bump here was double-counting: store_cache uses T2
-                                        // comparison while this block used eval_data as reference point,
-                                        // causing two version increments per changed table.
+        self.eval_cache.start_bump_journal();
+        while let Some(node) = queue.pop() {
+            if token.is_some_and(CancellationToken::is_cancelled) {
+                cancelled = true;
+                break;
+            }
+            match node.kind {
+                NodeKind::Value => self.evaluate_value_formula(&node.key),
+                NodeKind::Batch | NodeKind::Table => self.evaluate_batch_formula(&node.key, token),
+            }
+            let bumped = self.eval_cache.take_bump_journal();
+            queue.mark(&bumped);
+        }
+        self.eval_cache.stop_bump_journal();
+
+        if cancelled {
+            return Err("Cancelled".to_string());
+        }
+        if crate::utils::is_debug_cache_enabled() {
+            println!(
+                "[evaluate_dirty] {} seed paths, visited {} of {} formulas",
+                seeds.len(),
+                queue.queued_count(),
+                graph.nodes.len()
+            );
+        }
+        Ok(())
+    }
 
-                                        let static_key = format!("/$table{}", pointer_path);
-                                        let arc_value = std::sync::Arc::new(result_val);
+    /// Reverse dependency graph for this schema, built once per cache
+    fn eval_graph(&mut self) -> Arc<EvalGraph> {
+        if let Some(graph) = &self.eval_cache.eval_graph {
+            if graph.is_for(&self.sorted_evaluations) {
+                return Arc::clone(graph);
+            }
+        }
+        let graph = Arc::new(EvalGraph::build(
+            &self.evaluations,
+            &self.value_evaluations,
+            &self.sorted_evaluations,
+            &self.dependencies,
+            &self.dependency_ids,
+            self.eval_cache.paths(),
+            &self.tables,
+            &self.table_metadata,
+        ));
+        self.eval_cache.eval_graph = Some(Arc::clone(&graph));
+        graph
+    }
 
-                                        Arc::make_mut(&mut self.static_arrays).insert(
-                                            static_key.clone(),
-                                            std::sync::Arc::clone(&arc_value),
-                                        );
+    /// Evaluate one dependency-free entry of `value_evaluations` unless cached.
+    /// Only the evaluated schema is written.
+    fn evaluate_value_formula(&mut self, eval_key: &str) {
+        let data = self.eval_data.snapshot_data();
+        let pointer_path = path_utils::normalize_to_json_pointer(eval_key).into_owned();
+        let deps = self.dependency_ids.of(eval_key);
 
-                                        self.eval_data.set(&pointer_path, Value::clone(&arc_value));
+        // Cache hit check
+        if let Some(_cached_result) = self.eval_cache.check_cache(eval_key, deps) {
+            return;
+        }
 
-                                        let marker =
-                                            serde_json::json!({ "$static_array": static_key });
-                                        if let Some(schema_value) =
-                                            self.evaluated_schema.pointer_mut(&pointer_path)
-                                        {
-                                            *schema_value = marker;
-                                        }
-                                    }
-                                });
-                            } else {
-                                let empty_deps = indexmap::IndexSet::new();
-                                let deps = self.dependencies.get(eval_key).unwrap_or(&empty_deps);
-                                let cached_result = self.eval_cache.check_cache(eval_key, &deps);
-
-                                time_block!("        formula eval", {
-                                    if let Some(cached_result) = cached_result {
-                                        // Must still populate eval_data out of cache so subsequent formulas
-                                        // referencing this path in the same iteration can read the exact value
-                                        self.eval_data.set(&pointer_path, cached_result.clone());
-                                        if let Some(schema_value) =
-                                            self.evaluated_schema.pointer_mut(&pointer_path)
-                                        {
-                                            *schema_value = cached_result;
-                                        }
-                                    } else if let Some(logic_id) = self.evaluations.get(eval_key) {
-                                        // snapshot_data() is O(1) Arc::clone — no deep copy.
-                                        // Arc is moved into `snap` and lives only for the
-                                        // engine.run() call, then dropped before set() below.
-                                        // This keeps self.eval_data.data at rc=1 when set()
-                                        // calls Arc::make_mut, so no deep clone ever occurs.
-                                        let val = {
-                                            let snap = self.eval_data.snapshot_data();
-                                            self.engine.run(logic_id, &*snap)
-                                            // snap dropped here → rc back to 1
-                                        };
-                                        match val {
-                                            Ok(val) => {
-                                                let cleaned_val = clean_float_noise_scalar(val);
-                                                let data_path = crate::jsoneval::path_utils::schema_path_to_data_pointer(&pointer_path).into_owned();
-                                                self.eval_cache.store_cache(
-                                                    eval_key,
-                                                    &deps,
-                                                    cleaned_val.clone(),
-                                                );
-
-                                                // Bump data_versions when non-$params field value changes.
-                                                // $params bumps are handled inside store_cache (conditional).
-                                                let old_val = self
-                                                    .eval_data
-                                                    .get(&data_path)
-                                                    .cloned()
-                                                    .unwrap_or(Value::Null);
-                                                if cleaned_val != old_val
-                                                    && !data_path.starts_with("/$params")
-                                                {
-                                                    self.eval_cache.bump_data_version(&data_path);
-                                                }
+        // Cache miss - evaluate
+        if let Some(logic_id) = self.evaluations.get(eval_key) {
+            match self.engine.run(logic_id, &data) {
+                Ok(val) => {
+                    let cleaned_val = clean_float_noise_scalar(val);
+                    self.eval_cache
+                        .store_cache(eval_key, deps, cleaned_val.clone());
 
-                                                self.eval_data
-                                                    .set(&pointer_path, cleaned_val.clone());
-                                                if let Some(schema_value) =
-                                                    self.evaluated_schema.pointer_mut(&pointer_path)
-                                                {
-                                                    *schema_value = cleaned_val;
-                                                }
-                                            }
-                                            Err(_) => {
-                                                // Formula failed — ensure no raw $evaluation object leaks.
-                                                // Write null only if the node still holds the unevaluated formula.
-                                                if let Some(node) =
-                                                    self.evaluated_schema.pointer_mut(&pointer_path)
-                                                {
-                                                    if node.is_object()
-                                                        && node.get("$evaluation").is_some()
-                                                    {
-                                                        *node = Value::Null;
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                });
-                            }
+                    if let Some(pointer_value) = self.evaluated_schema.pointer_mut(&pointer_path) {
+                        *pointer_value = cleaned_val;
+                    }
+                }
+                Err(_) => {
+                    // Formula failed — ensure no raw $evaluation object leaks.
+                    // Write null only if the node still holds the unevaluated formula.
+                    if let Some(node) = self.evaluated_schema.pointer_mut(&pointer_path) {
+                        if node.is_object() && node.get("$evaluation").is_some() {
+                            *node = Value::Null;
                         }
-                    });
+                    }
                 }
-            });
+            }
+        }
+    }
 
-            // Drop lock before calling evaluate_others
-            drop(_lock);
+    /// Evaluate one batch formula or table, reusing the cached result when its
+    /// dependencies are unchanged. The result is written to both eval_data (for
+    /// later formulas) and the evaluated schema.
+    fn evaluate_batch_formula(&mut self, eval_key: &str, token: Option<&CancellationToken>) {
+        let pointer_path = path_utils::normalize_to_json_pointer(eval_key).into_owned();
+
+        // Cache miss - evaluate
+        let is_table = self.table_metadata.contains_key(eval_key);
+
+        if is_table {
+            time_block!("        table eval", {
+                // Snapshot for table read access: Arc::clone is O(1).
+                // Scoped so it's dropped before self.eval_data.set() below and
+                // does not add a copy of its own (see main_form_snapshot).
+                let table_result = {
+                    let table_scope = EvalData::from_arc(self.eval_data.snapshot_data());
+                    table_evaluate::evaluate_table(self, eval_key, &table_scope, token)
+                    // table_scope dropped here
+                };
+                if let Ok((rows, external_deps_opt)) = table_result {
+                    let result_val = Value::Array(rows);
+                    if let Some(external_deps) = external_deps_opt {
+                        self.eval_cache
+                            .store_cache(eval_key, &external_deps, result_val.clone());
+                    }
 
-            // Mark generation stable so the next evaluate_internal call can detect whether
-            // any formula was actually re-stored (via bump_data/params_version) since this run.
-            self.eval_cache.mark_evaluated();
+                    // NOTE: bump_params_version / bump_data_version for table results
+                    // is now handled inside store_cache (conditional on value change).
+                    // The separate bump here was double-counting: store_cache uses T2
+                    // comparison while this block used eval_data as reference point,
+                    // causing two version increments per changed table.
 
-            self.evaluate_others(paths, token);
+                    let static_key = format!("/$table{}", pointer_path);
+                    let arc_value = std::sync::Arc::new(result_val);
 
-            Ok(())
-        })
+                    Arc::make_mut(&mut self.static_arrays)
+                        .insert(static_key.clone(), std::sync::Arc::clone(&arc_value));
+
+                    self.eval_data.set(&pointer_path, Value::clone(&arc_value));
+
+                    let marker = serde_json::json!({ "$static_array": static_key });
+                    if let Some(schema_value) = self.evaluated_schema.pointer_mut(&pointer_path) {
+                        *schema_value = marker;
+                    }
+                }
+            });
+        } else {
+            let deps = self.dependency_ids.of(eval_key);
+            let cached_result = self.eval_cache.check_cache(eval_key, deps);
+
+            time_block!("        formula eval", {
+                if let Some(cached_result) = cached_result {
+                    // Must still populate eval_data out of cache so subsequent formulas
+                    // referencing this path in the same iteration can read the exact value
+                    self.eval_data.set(&pointer_path, cached_result.clone());
+                    if let Some(schema_value) = self.evaluated_schema.pointer_mut(&pointer_path) {
+                        *schema_value = cached_result;
+                    }
+                } else if let Some(logic_id) = self.evaluations.get(eval_key) {
+                    // snapshot_data() is O(1) Arc::clone — no deep copy.
+                    // Arc is moved into `snap` and lives only for the
+                    // engine.run() call, then dropped before set() below,
+                    // so it never forces a copy in Arc::make_mut. The one
+                    // copy per payload comes from main_form_snapshot.
+                    let val = {
+                        let snap = self.eval_data.snapshot_data();
+                        self.engine.run(logic_id, &*snap)
+                        // snap dropped here
+                    };
+                    match val {
+                        Ok(val) => {
+                            let cleaned_val = clean_float_noise_scalar(val);
+                            let data_path =
+                                crate::jsoneval::path_utils::schema_path_to_data_pointer(
+                                    &pointer_path,
+                                )
+                                .into_owned();
+                            self.eval_cache
+                                .store_cache(eval_key, deps, cleaned_val.clone());
+
+                            // Bump data_versions when non-$params field value changes.
+                            // $params bumps are handled inside store_cache (conditional).
+                            let old_val = self
+                                .eval_data
+                                .get(&data_path)
+                                .cloned()
+                                .unwrap_or(Value::Null);
+                            if cleaned_val != old_val && !data_path.starts_with("/$params") {
+                                self.eval_cache.bump_data_version(&data_path);
+                            }
+
+                            self.eval_data.set(&pointer_path, cleaned_val.clone());
+                            if let Some(schema_value) =
+                                self.evaluated_schema.pointer_mut(&pointer_path)
+                            {
+                                *schema_value = cleaned_val;
+                            }
+                        }
+                        Err(_) => {
+                            // Formula failed — ensure no raw $evaluation object leaks.
+                            // Write null only if the node still holds the unevaluated formula.
+                            if let Some(node) = self.evaluated_schema.pointer_mut(&pointer_path) {
+                                if node.is_object() && node.get("$evaluation").is_some() {
+                                    *node = Value::Null;
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
     }
 
     pub(crate) fn evaluate_others(
@@ -677,21 +747,7 @@ impl JSONEval {
                 time_block!("      evaluate rules+others", {
                     let eval_data_snapshot = self.eval_data.clone();
 
-                    let normalized_paths: Option<Vec<String>> = paths.map(|p_list| {
-                        p_list
-                            .iter()
-                            .flat_map(|p| {
-                                let ptr = path_utils::dot_notation_to_schema_pointer(p);
-                                // Also support version with /properties/ prefix for root match
-                                let with_props = if ptr.starts_with("#/") {
-                                    format!("#/properties/{}", &ptr[2..])
-                                } else {
-                                    ptr.clone()
-                                };
-                                vec![ptr, with_props]
-                            })
-                            .collect()
-                    });
+                    let filter = paths.and_then(PathFilter::from_field_paths);
 
                     // Sequential evaluation
                     let combined_evals: Vec<&String> = self
@@ -715,24 +771,17 @@ impl JSONEval {
                         // }
 
                         // Filter items if paths are provided
-                        if let Some(filter_paths) = normalized_paths.as_ref() {
-                            if !filter_paths.is_empty()
-                                && !filter_paths.iter().any(|p| {
-                                    eval_key.starts_with(p.as_str())
-                                        || (p.starts_with(eval_key.as_str())
-                                            && !eval_key.contains("/$params/"))
-                                })
-                            {
+                        if let Some(filter) = &filter {
+                            if !filter.matches_key(eval_key) {
                                 continue;
                             }
                         }
 
                         let pointer_path =
                             path_utils::normalize_to_json_pointer(eval_key).into_owned();
-                        let empty_deps = indexmap::IndexSet::new();
-                        let deps = self.dependencies.get(eval_key).unwrap_or(&empty_deps);
+                        let deps = self.dependency_ids.of(eval_key);
 
-                        if let Some(cached_result) = self.eval_cache.check_cache(eval_key, &deps) {
+                        if let Some(cached_result) = self.eval_cache.check_cache(eval_key, deps) {
                             if let Some(pointer_value) =
                                 self.evaluated_schema.pointer_mut(&pointer_path)
                             {
@@ -757,7 +806,7 @@ impl JSONEval {
                                     let cleaned_val = clean_float_noise_scalar(val);
                                     self.eval_cache.store_cache(
                                         eval_key,
-                                        &deps,
+                                        deps,
                                         cleaned_val.clone(),
                                     );
 
@@ -802,38 +851,36 @@ impl JSONEval {
         self.refresh_computed_value_dependents(token);
         self.evaluate_options_templates(paths);
 
-        // Resolve refs and visibility from current evaluated schema every evaluation.
-        // Rust Value refs are copies, so this state cannot be restored from an old overlay
-        // or persisted by mutating evaluated_schema as legacy JavaScript did.
+        // Refresh refs and visibility from current evaluated schema every evaluation.
+        // Rust Value refs are copies, so this state cannot be persisted by mutating
+        // evaluated_schema as legacy JavaScript did; only layouts whose referenced
+        // nodes changed are resolved again.
         time_block!("      resolve_layout", {
-            let _ = self.resolve_layout(false);
+            self.refresh_layout();
         });
 
         // Layout state was rebuilt above. Overlay consumers may reuse it only until next run.
         self.resolved_layout_cache = None;
+        self.invalidate_outputs();
     }
 
-    /// Re-evaluate direct dependents of computed fields against a temporary data overlay.
+    /// Re-evaluate dependents of computed fields against a temporary data overlay.
     /// Computed values are exposed only for this refresh; shared form data, cache entries and
     /// version trackers remain untouched, preventing subform/table cascade contamination.
     fn refresh_computed_value_dependents(&mut self, token: Option<&CancellationToken>) {
-        let computed_values: Vec<(String, Value)> = self
-            .evaluations
-            .keys()
-            .filter_map(|key| {
-                let field_path = key.strip_suffix("/value")?;
-                if !field_path.contains("/properties/") || key.contains("/rules/") {
-                    return None;
-                }
+        // Computed fields and the readers of each data path are indexed once per schema
+        let graph = self.eval_graph();
+        let computed_values: Vec<(&String, Value)> = graph
+            .computed_values
+            .iter()
+            .filter_map(|(idx, data_path)| {
+                let (key, _) = self.evaluations.get_index(*idx as usize)?;
                 let schema_pointer = path_utils::normalize_to_json_pointer(key);
                 let value = self.evaluated_schema.pointer(&schema_pointer)?;
                 if value.is_object() && value.get("$evaluation").is_some() {
                     return None;
                 }
-                Some((
-                    path_utils::schema_path_to_data_pointer(field_path).into_owned(),
-                    value.clone(),
-                ))
+                Some((data_path, value.clone()))
             })
             .collect();
         if computed_values.is_empty() {
@@ -843,55 +890,57 @@ impl JSONEval {
         let mut overlay = EvalData::new(self.eval_data.snapshot_data_clone());
         let mut changed = indexmap::IndexSet::new();
         for (data_path, value) in computed_values {
-            if overlay.get(&data_path) != Some(&value) {
-                overlay.set(&data_path, value);
-                changed.insert(data_path);
+            if overlay.get(data_path) != Some(&value) {
+                overlay.set(data_path, value);
+                changed.insert(data_path.clone());
             }
         }
         if changed.is_empty() {
             return;
         }
 
-        let targets: Vec<String> = self
-            .evaluations
-            .keys()
-            .filter(|key| {
-                !key.contains("/dependents/")
-                    && !key.contains("/$params/")
-                    && !self.tables.keys().any(|table| key.starts_with(table))
-                    && self.dependencies.get(*key).is_some_and(|dependencies| {
-                        dependencies.iter().any(|dependency| {
-                            changed.contains(
-                                path_utils::schema_path_to_data_pointer(dependency).as_ref(),
-                            )
-                        })
-                    })
-            })
-            .cloned()
-            .collect();
+        // Refreshed field values feed the overlay in turn, so chains of computed
+        // fields settle; each pass only re-runs readers of the paths that changed.
+        for _ in 0..self.evaluations.len() {
+            let targets = graph.refresh_readers_of(&changed);
 
-        for key in targets {
-            if token.is_some_and(CancellationToken::is_cancelled) {
-                return;
-            }
-            let Some(logic_id) = self.evaluations.get(&key) else {
-                continue;
-            };
-            let Ok(value) = self.engine.run(logic_id, overlay.data()) else {
-                continue;
-            };
-            let pointer = path_utils::normalize_to_json_pointer(&key);
-            if let Some(node) = self.evaluated_schema.pointer_mut(&pointer) {
+            let mut next_changed = indexmap::IndexSet::new();
+            for idx in targets {
+                if token.is_some_and(CancellationToken::is_cancelled) {
+                    return;
+                }
+                let Some((key, logic_id)) = self.evaluations.get_index(idx as usize) else {
+                    continue;
+                };
+                let Ok(value) = self.engine.run(logic_id, overlay.data()) else {
+                    continue;
+                };
                 let value = clean_float_noise_scalar(value);
-                if pointer.contains("/rules/") && !pointer.ends_with("/value") {
-                    if let Some(rule) = node.as_object_mut() {
-                        rule.remove("$evaluation");
-                        rule.insert("value".to_string(), value);
+                let pointer = path_utils::normalize_to_json_pointer(&key);
+                if let Some(node) = self.evaluated_schema.pointer_mut(&pointer) {
+                    if pointer.contains("/rules/") && !pointer.ends_with("/value") {
+                        if let Some(rule) = node.as_object_mut() {
+                            rule.remove("$evaluation");
+                            rule.insert("value".to_string(), value);
+                        }
+                        continue;
                     }
-                } else {
-                    *node = value;
+                    *node = value.clone();
                 }
+                let field_path = match key.strip_suffix("/value") {
+                    Some(field_path) if field_path.contains("/properties/") => field_path,
+                    _ => continue,
+                };
+                let data_path = path_utils::schema_path_to_data_pointer(field_path).into_owned();
+                if overlay.get(&data_path) != Some(&value) {
+                    overlay.set(&data_path, value);
+                    next_changed.insert(data_path);
+                }
+            }
+            if next_changed.is_empty() {
+                break;
             }
+            changed = next_changed;
         }
     }
 
@@ -900,18 +949,15 @@ impl JSONEval {
     pub(crate) fn evaluate_options_templates(&mut self, paths: Option<&[String]>) {
         // Use pre-collected options templates from parsing (Arc clone is cheap)
         let templates_to_eval = self.options_templates.clone();
+        let filter = paths.and_then(PathFilter::from_paths);
 
         // Evaluate each template
         for (path, template_str, params_path) in templates_to_eval.iter() {
             // Filter items if paths are provided
             // 'path' here is the schema path to the field (dot notation or similar, need to check)
             // It seems to be schema pointer based on usage in other methods
-            if let Some(filter_paths) = paths {
-                if !filter_paths.is_empty()
-                    && !filter_paths
-                        .iter()
-                        .any(|p| path.starts_with(p.as_str()) || p.starts_with(path.as_str()))
-                {
+            if let Some(filter) = &filter {
+                if !filter.matches(path) {
                     continue;
                 }
             }
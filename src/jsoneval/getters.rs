@@ -1,5 +1,6 @@
 use super::JSONEval;
 use crate::jsoneval::path_utils;
+use crate::jsoneval::schema_view::EvaluatedSchemaView;
 use crate::jsoneval::types::{ResolvedLayoutResult, ReturnFormat};
 use crate::time_block;
 use crate::utils::clean_float_noise_scalar;
@@ -120,7 +121,7 @@ impl JSONEval {
     ///
     /// By iterating only over tracked `static_arrays`, we replace markers in O(markers) time
     /// instead of requiring an expensive O(schema_nodes) recursive tree walk.
-    fn resolve_static_markers_in_value(&self, schema_output: &mut Value) {
+    pub(crate) fn resolve_static_markers_in_value(&self, schema_output: &mut Value) {
         for (static_key, array_arc) in self.static_arrays.iter() {
             // Determine the schema pointer path where this marker was placed
             let schema_path = if static_key.starts_with("/$table") {
@@ -145,33 +146,43 @@ impl JSONEval {
     /// to their actual evaluated data.
     pub fn get_evaluated_schema(&mut self) -> Value {
         time_block!("get_evaluated_schema()", {
-            let mut schema = self.evaluated_schema.clone();
-            self.resolve_static_markers_in_value(&mut schema);
-            schema
+            self.evaluated_schema_view(false).to_value()
         })
     }
 
+    /// Borrowed view of the evaluated schema with `$static_array` markers resolved.
+    ///
+    /// Serializing the view (JSON, MessagePack, ...) writes straight from the
+    /// evaluated schema without copying it first; `without_params` omits `$params`.
+    pub fn evaluated_schema_view(&self, without_params: bool) -> EvaluatedSchemaView<'_> {
+        EvaluatedSchemaView::new(&self.evaluated_schema, &self.static_arrays, without_params)
+    }
+
     /// Get layout overlay entries — the delta properties per layout element.
     /// Consumer merges these into compact schema to get fully resolved layout.
     pub fn get_resolved_layout(&mut self) -> ResolvedLayoutResult {
         time_block!("get_resolved_layout()", {
-            // Check cache
-            if let Some(ref cached) = self.resolved_layout_cache {
-                return cached.as_ref().clone();
-            }
-            // Resolve and cache
-            let result = match self.resolve_layout(false) {
-                Ok(entries) => entries,
-                Err(e) => {
-                    eprintln!("Warning: Layout resolution failed: {}", e);
-                    Vec::new()
-                }
-            };
-            self.resolved_layout_cache = Some(Arc::new(result.clone()));
-            result
+            self.resolved_layout_shared().as_ref().clone()
         })
     }
 
+    /// Resolved layout entries, shared with the cache instead of copied
+    fn resolved_layout_shared(&mut self) -> Arc<ResolvedLayoutResult> {
+        if let Some(ref cached) = self.resolved_layout_cache {
+            return Arc::clone(cached);
+        }
+        let result = match self.resolve_layout(false) {
+            Ok(entries) => entries,
+            Err(e) => {
+                eprintln!("Warning: Layout resolution failed: {}", e);
+                Vec::new()
+            }
+        };
+        let shared = Arc::new(result);
+        self.resolved_layout_cache = Some(Arc::clone(&shared));
+        shared
+    }
+
     /// Get evaluated schema with layout overlays already applied.
     /// Convenience: returns compact schema + overlays merged.
     ///
@@ -183,15 +194,15 @@ impl JSONEval {
     pub fn get_evaluated_schema_resolved(&mut self) -> Value {
         time_block!("get_evaluated_schema_resolved()", {
             let mut schema = self.get_evaluated_schema_without_params();
-            let overlays = self.get_resolved_layout();
+            let overlays = self.resolved_layout_shared();
 
-            struct ResolveEntry {
+            struct ResolveEntry<'a> {
                 layout_path: String,
                 element_idx: usize,
-                overlay: indexmap::IndexMap<String, Value>,
+                overlay: &'a indexmap::IndexMap<String, Value>,
             }
 
-            let mut entries: Vec<ResolveEntry> = overlays
+            let mut entries: Vec<ResolveEntry<'_>> = overlays
                 .iter()
                 .map(|entry| {
                     let layout_path =
@@ -199,11 +210,10 @@ impl JSONEval {
                     ResolveEntry {
                         layout_path,
                         element_idx: entry.element_idx,
-                        overlay: entry.overlay.clone(),
+                        overlay: &entry.overlay,
                     }
                 })
                 .collect();
-            drop(overlays);
 
             // Sort entries shallow-first so parent elements are expanded before their children.
             // Child entries (e.g. layout_path = ".../elements/1/elements") depend on the parent
@@ -246,7 +256,7 @@ impl JSONEval {
                     if let Value::Object(ref mut resolved_map) = resolved {
                         if let Some(Value::Object(layout_obj)) = resolved_map.remove("$layout") {
                             let mut result = layout_obj;
-                            for (key, value) in resolved_map.clone().into_iter() {
+                            for (key, value) in std::mem::take(resolved_map) {
                                 if key != "type" || !result.contains_key("type") {
                                     result.insert(key, value);
                                 }
@@ -279,7 +289,7 @@ impl JSONEval {
 
                         // Apply overlay on top
                         if let Value::Object(ref mut map) = element {
-                            for (k, v) in &entry.overlay {
+                            for (k, v) in entry.overlay {
                                 map.insert(k.clone(), v.clone());
                             }
                         }
@@ -608,23 +618,28 @@ impl JSONEval {
 
     /// Get evaluated schema without $params
     pub fn get_evaluated_schema_without_params(&mut self) -> Value {
-        let mut schema = self.get_evaluated_schema();
-        if let Value::Object(ref mut map) = schema {
-            map.remove("$params");
-        }
-        schema
+        self.evaluated_schema_view(true).to_value()
     }
 
     /// Get evaluated schema as MessagePack bytes (compact, without $layout resolution)
     pub fn get_evaluated_schema_msgpack(&mut self) -> Result<Vec<u8>, String> {
-        let schema = self.get_evaluated_schema();
-        rmp_serde::to_vec(&schema).map_err(|e| format!("MessagePack serialization failed: {}", e))
+        rmp_serde::to_vec(&self.evaluated_schema_view(false))
+            .map_err(|e| format!("MessagePack serialization failed: {}", e))
+    }
+
+    /// Get evaluated schema as JSON bytes, serialized without an intermediate copy
+    pub fn get_evaluated_schema_json(&self, without_params: bool) -> Result<Vec<u8>, String> {
+        serde_json::to_vec(&self.evaluated_schema_view(without_params))
+            .map_err(|e| format!("JSON serialization failed: {}", e))
     }
 
     /// Get layout-resolved evaluated schema as MessagePack bytes.
     ///
     /// Reuses `get_evaluated_schema_resolved`, which omits `$params` and merges
-    /// resolved `$layout` overlays.
+    /// resolved `$layout` overlays. Unlike the compact getters this cannot stream
+    /// from [`evaluated_schema_view`](Self::evaluated_schema_view): layout `$ref`s
+    /// are expanded into copies of other subtrees and every property is stamped
+    /// with path metadata, so one owned copy is built and then serialized.
     pub fn get_evaluated_schema_resolved_msgpack(&mut self) -> Result<Vec<u8>, String> {
         let schema = self.get_evaluated_schema_resolved();
         rmp_serde::to_vec(&schema).map_err(|e| format!("MessagePack serialization failed: {}", e))
@@ -0,0 +1,243 @@
+//! Pool of reusable `JSONEval` instances per cached schema.
+//!
+//! Building a `JSONEval` from a cached [`ParsedSchema`] shares the compiled
+//! parts, but still copies the schema into `evaluated_schema` and allocates fresh
+//! caches and evaluation data. Request-scoped callers that create and drop an
+//! instance per request can instead [`acquire`](JSONEvalPool::acquire) one from
+//! [`JSON_EVAL_POOL`] and [`release`](JSONEvalPool::release) it afterwards. A
+//! pooled instance is brought back to its initial state by
+//! [`JSONEval::reset`], which rewrites only the parts of `evaluated_schema` that
+//! differ from the schema and clears caches without giving up their capacity.
+//!
+//! Idle instances hold their schema alive, so the pool follows the cache: slots
+//! whose key was removed, evicted or given another schema are dropped on the
+//! next cache write, acquire or release.
+
+use std::collections::HashMap;
+use std::sync::{Arc, Mutex};
+
+use once_cell::sync::Lazy;
+use serde_json::Value;
+
+use super::JSONEval;
+use crate::jsoneval::eval_data::EvalData;
+use crate::jsoneval::json_parser;
+use crate::jsoneval::parsed_schema::ParsedSchema;
+use crate::PARSED_SCHEMA_CACHE;
+
+/// Idle instances kept per cache key.
+///
+/// Defaults to the available parallelism; `JSONEVAL_POOL_SIZE` overrides it
+/// (`0` disables pooling).
+static POOL_CAPACITY: Lazy<usize> = Lazy::new(|| {
+    std::env::var("JSONEVAL_POOL_SIZE")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+});
+
+/// Global instance pool over [`PARSED_SCHEMA_CACHE`]
+pub static JSON_EVAL_POOL: Lazy<JSONEvalPool> =
+    Lazy::new(|| JSONEvalPool::with_capacity(*POOL_CAPACITY));
+
+/// Idle instances built from one cached schema
+struct PoolSlot {
+    parsed: Arc<ParsedSchema>,
+    idle: Vec<JSONEval>,
+}
+
+#[derive(Default)]
+struct PoolState {
+    slots: HashMap<String, PoolSlot>,
+    /// Cache generation the slots were last checked against
+    pruned_generation: u64,
+}
+
+impl PoolState {
+    /// Drop slots whose key no longer holds their schema in [`PARSED_SCHEMA_CACHE`].
+    /// Only scans when the cache was written since the last check.
+    fn prune(&mut self) {
+        let generation = PARSED_SCHEMA_CACHE.generation();
+        if generation == self.pruned_generation {
+            return;
+        }
+        self.pruned_generation = generation;
+        self.slots
+            .retain(|key, slot| PARSED_SCHEMA_CACHE.holds(key, &slot.parsed));
+    }
+}
+
+/// Idle `JSONEval` instances keyed by `ParsedSchemaCache` key
+pub struct JSONEvalPool {
+    state: Mutex<PoolState>,
+    capacity: usize,
+}
+
+impl JSONEvalPool {
+    /// Create a pool keeping up to `capacity` idle instances per key
+    pub fn with_capacity(capacity: usize) -> Self {
+        Self {
+            state: Mutex::new(PoolState::default()),
+            capacity,
+        }
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, PoolState> {
+        self.state.lock().unwrap_or_else(|e| e.into_inner())
+    }
+
+    /// Get an instance for the schema cached under `key`, reset to `data` and
+    /// `context`. Falls back to building one when none is idle.
+    pub fn acquire(
+        &self,
+        key: &str,
+        context: Option<&str>,
+        data: Option<&str>,
+    ) -> Result<JSONEval, String> {
+        let parsed = PARSED_SCHEMA_CACHE.get(key);
+
+        let pooled = {
+            let mut state = self.lock();
+            // Also drops the slot of a key that was removed or given another schema
+            state.prune();
+            match (&parsed, state.slots.get_mut(key)) {
+                (Some(parsed), Some(slot)) if Arc::ptr_eq(&slot.parsed, parsed) => slot.idle.pop(),
+                _ => None,
+            }
+        };
+        let parsed = parsed.ok_or_else(|| format!("Schema '{}' not found in cache", key))?;
+
+        match pooled {
+            Some(mut eval) => {
+                eval.reset(data, context)?;
+                Ok(eval)
+            }
+            None => JSONEval::with_parsed_schema(parsed, context, data),
+        }
+    }
+
+    /// Return an instance taken from [`acquire`](Self::acquire) with the same
+    /// `key`. It is dropped instead when the pool is full, the key now holds a
+    /// different schema, or the instance's schema or engine were replaced (by a
+    /// reload or a timezone change).
+    pub fn release(&self, key: &str, eval: JSONEval) {
+        if self.capacity == 0 {
+            return;
+        }
+        let parsed = PARSED_SCHEMA_CACHE.get(key).filter(|parsed| {
+            Arc::ptr_eq(&eval.schema, &parsed.schema) && Arc::ptr_eq(&eval.engine, &parsed.engine)
+        });
+        let Some(parsed) = parsed else {
+            // The instance is dropped, but a removed key may still have idle ones
+            self.prune();
+            return;
+        };
+
+        let mut state = self.lock();
+        state.prune();
+        let slot = state
+            .slots
+            .entry(key.to_string())
+            .or_insert_with(|| PoolSlot {
+                parsed: Arc::clone(&parsed),
+                idle: Vec::new(),
+            });
+        if !Arc::ptr_eq(&slot.parsed, &parsed) {
+            slot.parsed = parsed;
+            slot.idle.clear();
+        }
+        if slot.idle.len() < self.capacity {
+            slot.idle.push(eval);
+        }
+    }
+
+    /// Number of idle instances held for `key`
+    pub fn idle_count(&self, key: &str) -> usize {
+        self.lock().slots.get(key).map_or(0, |slot| slot.idle.len())
+    }
+
+    /// Drop idle instances whose schema left [`PARSED_SCHEMA_CACHE`]. Called by
+    /// the global cache after every write.
+    pub(crate) fn prune(&self) {
+        self.lock().prune();
+    }
+
+    /// Drop every idle instance
+    pub fn clear(&self) {
+        self.lock().slots.clear();
+    }
+}
+
+impl JSONEval {
+    /// Bring the instance back to the state it had right after construction,
+    /// with new `data` and `context`.
+    ///
+    /// Only nodes of `evaluated_schema` that evaluation changed are copied back
+    /// from the schema, and caches are cleared in place so their allocations are
+    /// reused. Subforms are reset too.
+    pub fn reset(&mut self, data: Option<&str>, context: Option<&str>) -> Result<(), String> {
+        let context: Value = json_parser::parse_json_str(context.unwrap_or("{}"))
+            .map_err(|e| format!("Failed to parse context: {}", e))?;
+        let data: Value = json_parser::parse_json_str(data.unwrap_or("{}"))
+            .map_err(|e| format!("Failed to parse data: {}", e))?;
+        self.reset_values(data, context);
+        Ok(())
+    }
+
+    pub(crate) fn reset_values(&mut self, data: Value, context: Value) {
+        restore_value(&mut self.evaluated_schema, &self.schema);
+        self.eval_data =
+            EvalData::with_schema_data_context(&self.evaluated_schema, &data, &context);
+        self.data = data;
+        self.context = context;
+
+        self.eval_cache.clear();
+        self.cached_msgpack_schema = None;
+        self.resolved_layout_cache = None;
+        self.layout_state = Default::default();
+        self.layout_hidden_refs.clear();
+        self.layout_visible_refs.clear();
+        self.layout_condition_hidden_refs.clear();
+        self.invalidate_outputs();
+
+        for subform in self.subforms.values_mut() {
+            subform.reset_values(
+                Value::Object(serde_json::Map::new()),
+                Value::Object(serde_json::Map::new()),
+            );
+        }
+    }
+}
+
+/// Make `target` equal to `template`, keeping every node of `target` that
+/// already matches and reusing string buffers where values differ
+fn restore_value(target: &mut Value, template: &Value) {
+    match (&mut *target, template) {
+        (Value::Object(t), Value::Object(s))
+            if t.len() == s.len() && t.keys().zip(s.keys()).all(|(a, b)| a == b) =>
+        {
+            for ((_, tv), (_, sv)) in t.iter_mut().zip(s.iter()) {
+                restore_value(tv, sv);
+            }
+        }
+        (Value::Array(t), Value::Array(s)) if t.len() == s.len() => {
+            for (tv, sv) in t.iter_mut().zip(s.iter()) {
+                restore_value(tv, sv);
+            }
+        }
+        (Value::String(t), Value::String(s)) => {
+            if t != s {
+                t.clone_from(s);
+            }
+        }
+        (t, s) => {
+            if *t != *s {
+                *t = s.clone();
+            }
+        }
+    }
+}
@@ -1,10 +1,31 @@
 use super::JSONEval;
 use crate::jsoneval::path_utils;
 use crate::jsoneval::types::{LayoutOverlayEntry, ResolvedLayoutResult};
+use crate::parse_schema::common::layout_ref_pointer;
+use crate::rlogic::compiled_logic_store::hash_value;
 use crate::time_block;
 
-use indexmap::IndexMap;
+use indexmap::{IndexMap, IndexSet};
+use rapidhash::fast::RapidHasher;
 use serde_json::Value;
+use std::hash::{Hash, Hasher};
+
+/// Resolved overlays and visibility of each root layout, in `layout_dependencies`
+/// order. A root is resolved again only when the fingerprint of the schema nodes
+/// it depends on changes; the others keep their entries as they are.
+#[derive(Debug, Clone, Default)]
+pub(crate) struct LayoutState {
+    roots: Vec<Option<ResolvedRoot>>,
+}
+
+#[derive(Debug, Clone)]
+struct ResolvedRoot {
+    fingerprint: u64,
+    entries: ResolvedLayoutResult,
+    hidden: IndexSet<String>,
+    visible: IndexSet<String>,
+    condition_hidden: IndexSet<String>,
+}
 
 impl JSONEval {
     /// Resolve layout references, return overlay entries.
@@ -17,48 +38,65 @@ impl JSONEval {
     /// * `evaluate` - If true, runs evaluation before resolving layout.
     pub fn resolve_layout(&mut self, evaluate: bool) -> Result<ResolvedLayoutResult, String> {
         if evaluate {
-            let data_str = serde_json::to_string(&self.data)
-                .map_err(|e| format!("Failed to serialize data: {}", e))?;
-            self.evaluate(&data_str, None, None, None)?;
+            // Evaluate the current data directly; it is already parsed
+            self.evaluate_internal_with_new_data(
+                self.data.clone(),
+                Value::Object(serde_json::Map::new()),
+                None,
+                None,
+            )?;
         }
 
         Ok(self.resolve_layout_internal())
     }
 
     fn resolve_layout_internal(&mut self) -> ResolvedLayoutResult {
-        time_block!("  resolve_layout_internal()", {
-            let layout_paths = self.layout_paths.clone();
-            let mut all_entries = ResolvedLayoutResult::new();
+        self.refresh_layout();
+        self.layout_state
+            .roots
+            .iter()
+            .flatten()
+            .flat_map(|root| root.entries.iter().cloned())
+            .collect()
+    }
+
+    /// Bring the per-root layout state and the layout hidden/visible ref sets up to
+    /// date with the current evaluated_schema.
+    ///
+    /// Visibility state remains ephemeral: overlays and hidden indexes never mutate
+    /// evaluated_schema. Roots whose dependencies are unchanged keep their overlays.
+    pub(crate) fn refresh_layout(&mut self) {
+        time_block!("  refresh_layout()", {
+            let dependencies = self.layout_dependencies.clone();
+            let mut state = std::mem::take(&mut self.layout_state);
+            state.roots.resize(dependencies.len(), None);
 
-            // Resolve every ref from current evaluated_schema. Visibility state remains
-            // ephemeral: overlays and hidden indexes never mutate evaluated_schema.
-            self.layout_hidden_refs.clear();
-            self.layout_visible_refs.clear();
-            self.layout_condition_hidden_refs.clear();
-            // A nested field layout is expanded by its parent's `$ref` tree. Resolving it
-            // again as a standalone root loses its actual parent visibility and would make a
-            // shared ref look visible when every real attachment is hidden.
-            let attached_layout_refs = Self::collect_layout_ref_targets(&self.schema);
             time_block!("    resolve_layout_elements", {
-                for layout_path in layout_paths.iter().filter(|path| {
-                    let owner = Self::layout_owner_pointer(path);
-                    owner.is_empty() || !attached_layout_refs.contains(&owner)
-                }) {
-                    let resolved_tree = self.resolve_elements_tree(layout_path);
-                    let entries = Self::tree_to_overlays(
-                        &resolved_tree,
-                        layout_path,
-                        false,
-                        false,
-                        false,
-                        &mut self.layout_hidden_refs,
-                        &mut self.layout_visible_refs,
-                        &mut self.layout_condition_hidden_refs,
-                    );
-                    all_entries.extend(entries);
+                for (slot, (layout_path, pointers)) in
+                    state.roots.iter_mut().zip(dependencies.iter())
+                {
+                    let fingerprint = self.layout_fingerprint(pointers);
+                    if slot
+                        .as_ref()
+                        .is_some_and(|root| root.fingerprint == fingerprint)
+                    {
+                        continue;
+                    }
+                    *slot = Some(self.resolve_layout_root(layout_path, fingerprint));
                 }
             });
 
+            self.layout_hidden_refs.clear();
+            self.layout_visible_refs.clear();
+            self.layout_condition_hidden_refs.clear();
+            for root in state.roots.iter().flatten() {
+                self.layout_hidden_refs.extend(root.hidden.iter().cloned());
+                self.layout_visible_refs
+                    .extend(root.visible.iter().cloned());
+                self.layout_condition_hidden_refs
+                    .extend(root.condition_hidden.iter().cloned());
+            }
+
             // Schema-wide filtering and clearing apply only if no attached layout occurrence
             // renders this ref visible. Overlay entries above retain per-occurrence state.
             for visible_ref in &self.layout_visible_refs {
@@ -66,66 +104,62 @@ impl JSONEval {
                 self.layout_condition_hidden_refs.shift_remove(visible_ref);
             }
 
-            all_entries
+            self.layout_state = state;
         })
     }
 
-    // ── Phase 1 helpers ─────────────────────────────────────────────
-
-    /// Return schema pointer owning `.../$layout/elements`; root layouts have no owner.
-    fn layout_owner_pointer(layout_path: &str) -> String {
-        let owner = layout_path
-            .trim_end_matches("/$layout/elements")
-            .trim_start_matches('#');
-        owner.to_string()
+    /// Resolve one root layout into its overlays and visibility sets
+    fn resolve_layout_root(&self, layout_path: &str, fingerprint: u64) -> ResolvedRoot {
+        let mut root = ResolvedRoot {
+            fingerprint,
+            entries: Vec::new(),
+            hidden: IndexSet::new(),
+            visible: IndexSet::new(),
+            condition_hidden: IndexSet::new(),
+        };
+        let resolved_tree = self.resolve_elements_tree(layout_path);
+        root.entries = Self::tree_to_overlays(
+            &resolved_tree,
+            layout_path,
+            false,
+            false,
+            false,
+            &mut root.hidden,
+            &mut root.visible,
+            &mut root.condition_hidden,
+        );
+        root
     }
 
-    /// Collect schema targets referenced from layout elements only. Formula `$ref`s are
-    /// intentionally ignored: they do not attach a field to a visual layout parent.
-    fn collect_layout_ref_targets(schema: &Value) -> indexmap::IndexSet<String> {
-        fn collect_elements(elements: &Value, refs: &mut indexmap::IndexSet<String>) {
-            let Some(elements) = elements.as_array() else {
-                return;
-            };
-            for element in elements {
-                let Some(map) = element.as_object() else {
-                    continue;
-                };
-                if let Some(reference) = map.get("$ref").and_then(Value::as_str) {
-                    let pointer = path_utils::normalize_to_json_pointer(
-                        &path_utils::dot_notation_to_schema_pointer(reference),
-                    )
-                    .trim_start_matches('#')
-                    .to_string();
-                    refs.insert(pointer);
+    /// Hash the evaluated schema nodes a root layout reads. Nested `properties` and
+    /// `items` are skipped: overlays never copy them, and fields referenced below
+    /// them are dependencies of their own.
+    fn layout_fingerprint(&self, pointers: &[String]) -> u64 {
+        let mut hasher = RapidHasher::default();
+        for pointer in pointers {
+            match self.evaluated_schema.pointer(pointer) {
+                Some(Value::Object(map)) => {
+                    1u8.hash(&mut hasher);
+                    for (key, value) in map {
+                        if key == "properties" || key == "items" {
+                            continue;
+                        }
+                        key.hash(&mut hasher);
+                        hash_value(value, &mut hasher);
+                    }
                 }
-                if let Some(children) = map.get("elements") {
-                    collect_elements(children, refs);
+                Some(value) => {
+                    2u8.hash(&mut hasher);
+                    hash_value(value, &mut hasher);
                 }
+                None => 0u8.hash(&mut hasher),
             }
         }
-
-        fn walk(value: &Value, refs: &mut indexmap::IndexSet<String>) {
-            let Some(map) = value.as_object() else {
-                return;
-            };
-            if let Some(elements) = map
-                .get("$layout")
-                .and_then(Value::as_object)
-                .and_then(|layout| layout.get("elements"))
-            {
-                collect_elements(elements, refs);
-            }
-            for child in map.values() {
-                walk(child, refs);
-            }
-        }
-
-        let mut refs = indexmap::IndexSet::new();
-        walk(schema, &mut refs);
-        refs
+        hasher.finish()
     }
 
+    // ── Phase 1 helpers ─────────────────────────────────────────────
+
     /// Resolve $ref in elements tree, return full resolved tree (no parent cascade yet).
     /// Returns Vec<(resolved_element, schema_ref_path)> — one per element at this level.
     fn resolve_elements_tree(&self, layout_elements_path: &str) -> Vec<(Value, String)> {
@@ -191,19 +225,7 @@ impl JSONEval {
 
                 if let Some(Value::String(ref_str)) = map.get("$ref").cloned() {
                     // Resolve the $ref to an actual schema pointer first
-                    let normalized_path = if ref_str.starts_with('#') || ref_str.starts_with('/') {
-                        path_utils::normalize_to_json_pointer(&ref_str).into_owned()
-                    } else {
-                        let schema_pointer = path_utils::dot_notation_to_schema_pointer(&ref_str);
-                        let schema_path =
-                            path_utils::normalize_to_json_pointer(&schema_pointer).into_owned();
-
-                        if self.evaluated_schema.pointer(&schema_path).is_some() {
-                            schema_path
-                        } else {
-                            format!("/properties/{}", ref_str.replace('.', "/properties/"))
-                        }
-                    };
+                    let normalized_path = layout_ref_pointer(&self.evaluated_schema, &ref_str);
 
                     // Build $fullpath from the actual resolved pointer (not the raw $ref string).
                     // This ensures $fullpath always reflects the true schema field path.
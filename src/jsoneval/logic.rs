@@ -21,6 +21,7 @@ impl JSONEval {
             let context_value = context.unwrap_or(&self.context);
             self.eval_data
                 .replace_data_and_context(input_data.clone(), context_value.clone());
+            self.invalidate_outputs();
             self.eval_data.data()
         } else {
             self.eval_data.data()
@@ -5,10 +5,10 @@
 //! schema caches. Crate root re-exports stable public types so callers usually do
 //! not need to import from submodules directly.
 
-use std::collections::HashMap;
 use std::sync::{Arc, Mutex};
 
 use crate::jsoneval::eval_data::EvalData;
+use crate::jsoneval::path_id::DependencyIds;
 
 use crate::jsoneval::table_metadata::TableMetadata;
 
@@ -19,26 +19,39 @@ use indexmap::{IndexMap, IndexSet};
 
 use serde_json::Value;
 
+pub mod batch;
 pub mod cancellation;
 pub mod core;
 pub mod dependents;
+pub mod dirty_set;
 pub mod eval_cache;
 pub mod eval_data;
 pub mod evaluate;
 pub mod getters;
+pub mod instance_pool;
 pub mod json_parser;
 pub mod layout;
 pub mod logic;
+pub mod output_cache;
 pub mod parsed_schema;
 pub mod parsed_schema_cache;
+pub mod parsed_snapshot;
+pub mod path_filter;
+pub mod path_id;
 pub mod path_utils;
+pub mod rule_patterns;
+pub mod schema_view;
+pub mod set_values;
 pub mod static_arrays;
 pub mod subform_methods;
+pub mod subform_parallel;
 pub(crate) mod subform_scope;
 pub mod table_evaluate;
 pub mod table_metadata;
 pub mod types;
 pub mod validation;
+pub(crate) mod validation_cache;
+pub(crate) mod worker_guard;
 
 pub struct JSONEval {
     pub schema: Arc<Value>,
@@ -47,6 +60,8 @@ pub struct JSONEval {
     pub tables: Arc<IndexMap<String, Value>>,
     pub table_metadata: Arc<IndexMap<String, TableMetadata>>,
     pub dependencies: Arc<IndexMap<String, IndexSet<String>>>,
+    /// `dependencies` interned into the cache's path table
+    pub dependency_ids: Arc<DependencyIds>,
     pub sorted_evaluations: Arc<Vec<Vec<String>>>,
     pub dependents_evaluations: Arc<IndexMap<String, Vec<DependentItem>>>,
     pub rules_evaluations: Arc<Vec<String>>,
@@ -56,6 +71,8 @@ pub struct JSONEval {
     pub layout_paths: Arc<Vec<String>>,
     /// Field schema pointers referenced by one or more `$layout` elements.
     pub layout_field_refs: Arc<IndexSet<String>>,
+    /// Root layout paths mapped to the schema pointers their resolution reads.
+    pub layout_dependencies: Arc<IndexMap<String, Vec<String>>>,
     pub options_templates: Arc<Vec<(String, String, String)>>,
     pub subforms: IndexMap<String, Box<JSONEval>>,
 
@@ -79,6 +96,8 @@ pub struct JSONEval {
     pub(crate) eval_lock: Mutex<()>,
     pub(crate) cached_msgpack_schema: Option<Vec<u8>>,
     pub(crate) resolved_layout_cache: Option<Arc<Vec<crate::jsoneval::types::LayoutOverlayEntry>>>,
+    /// Serialized getter outputs for the current output generation
+    pub(crate) output_cache: output_cache::OutputCache,
     /// `$ref` targets hidden in every current resolved layout occurrence.
     pub(crate) layout_hidden_refs: indexmap::IndexSet<String>,
     /// `$ref` targets visible in at least one current resolved layout occurrence.
@@ -86,5 +105,8 @@ pub struct JSONEval {
     pub(crate) layout_visible_refs: indexmap::IndexSet<String>,
     /// Subset of layout_hidden_refs hidden by a condition.hidden cascade and eligible for clearing.
     pub(crate) layout_condition_hidden_refs: indexmap::IndexSet<String>,
-    pub(crate) regex_cache: std::sync::RwLock<HashMap<String, regex::Regex>>,
+    /// Resolved overlays per root layout, reused while their dependencies are unchanged
+    pub(crate) layout_state: layout::LayoutState,
+    /// Compiled literal `pattern` rules, shared with the `ParsedSchema` it came from
+    pub(crate) rule_patterns: Arc<rule_patterns::RulePatterns>,
 }
@@ -0,0 +1,103 @@
+//! Serialized getter outputs, cached per output generation.
+//!
+//! UIs poll getters such as the evaluated schema or the schema values after every
+//! render, usually with nothing evaluated in between. [`OutputCache`] keeps the
+//! serialized bytes of each getter as a shared `Arc<[u8]>`, tagged with the output
+//! generation they were produced at. Operations that write evaluation state
+//! (evaluate, validate, dependents, `set_values`, schema reloads, ...) bump the
+//! generation, which drops every cached output.
+
+use std::collections::HashMap;
+use std::sync::Arc;
+
+use super::JSONEval;
+
+/// A getter whose serialized result can be cached
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum OutputKind {
+    /// `get_evaluated_schema` as JSON
+    EvaluatedSchema,
+    /// `get_evaluated_schema` as MessagePack
+    EvaluatedSchemaMsgpack,
+    /// `get_evaluated_schema_without_params` as JSON
+    EvaluatedSchemaWithoutParams,
+    /// `get_evaluated_schema_resolved` as JSON
+    EvaluatedSchemaResolved,
+    /// `get_evaluated_schema_resolved` as MessagePack
+    EvaluatedSchemaResolvedMsgpack,
+    /// `get_resolved_layout` as JSON
+    ResolvedLayout,
+    /// `get_schema_value` as JSON
+    SchemaValue,
+    /// `get_schema_value_array` as JSON
+    SchemaValueArray,
+    /// `get_schema_value_object` as JSON
+    SchemaValueObject,
+}
+
+#[derive(Debug, Default)]
+pub(crate) struct OutputCache {
+    generation: u64,
+    entries: HashMap<OutputKind, (u64, Arc<[u8]>)>,
+}
+
+impl OutputCache {
+    /// Record that evaluation state changed; cached outputs become stale
+    pub(crate) fn bump(&mut self) {
+        self.generation = self.generation.wrapping_add(1);
+        self.entries.clear();
+    }
+
+    fn get(&self, kind: OutputKind) -> Option<Arc<[u8]>> {
+        self.entries
+            .get(&kind)
+            .filter(|(generation, _)| *generation == self.generation)
+            .map(|(_, bytes)| Arc::clone(bytes))
+    }
+
+    fn insert(&mut self, kind: OutputKind, bytes: Vec<u8>) -> Arc<[u8]> {
+        let bytes: Arc<[u8]> = bytes.into();
+        self.entries
+            .insert(kind, (self.generation, Arc::clone(&bytes)));
+        bytes
+    }
+}
+
+fn to_json(value: &impl serde::Serialize) -> Result<Vec<u8>, String> {
+    serde_json::to_vec(value).map_err(|e| format!("JSON serialization failed: {}", e))
+}
+
+impl JSONEval {
+    /// Current output generation. It changes whenever an operation may have changed
+    /// what the getters return, so callers can skip fetching unchanged outputs.
+    pub fn output_generation(&self) -> u64 {
+        self.output_cache.generation
+    }
+
+    /// Mark every cached getter output stale
+    pub(crate) fn invalidate_outputs(&mut self) {
+        self.output_cache.bump();
+    }
+
+    /// Serialized result of a getter, shared with every other call made at the same
+    /// output generation. Only the first call after a state change serializes.
+    pub fn get_output_bytes(&mut self, kind: OutputKind) -> Result<Arc<[u8]>, String> {
+        if let Some(bytes) = self.output_cache.get(kind) {
+            return Ok(bytes);
+        }
+        let bytes = match kind {
+            OutputKind::EvaluatedSchema => self.get_evaluated_schema_json(false)?,
+            OutputKind::EvaluatedSchemaMsgpack => self.get_evaluated_schema_msgpack()?,
+            OutputKind::EvaluatedSchemaWithoutParams => self.get_evaluated_schema_json(true)?,
+            OutputKind::EvaluatedSchemaResolved => to_json(&self.get_evaluated_schema_resolved())?,
+            OutputKind::EvaluatedSchemaResolvedMsgpack => {
+                self.get_evaluated_schema_resolved_msgpack()?
+            }
+            OutputKind::ResolvedLayout => to_json(&self.get_resolved_layout())?,
+            OutputKind::SchemaValue => to_json(&self.get_schema_value())?,
+            OutputKind::SchemaValueArray => to_json(&self.get_schema_value_array())?,
+            OutputKind::SchemaValueObject => to_json(&self.get_schema_value_object())?,
+        };
+        Ok(self.output_cache.insert(kind, bytes))
+    }
+}
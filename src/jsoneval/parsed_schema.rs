@@ -3,6 +3,8 @@
 //! This module separates the parsing results from the evaluation state, allowing
 //! schemas to be parsed once and reused across multiple evaluations with different data/context.
 
+use crate::jsoneval::path_id::{DependencyIds, PathId, PathTable};
+use crate::jsoneval::rule_patterns::RulePatterns;
 use crate::{DependentItem, LogicId, RLogic, RLogicConfig, TableMetadata};
 use indexmap::{IndexMap, IndexSet};
 use serde_json::Value;
@@ -46,6 +48,13 @@ pub struct ParsedSchema {
     /// Dependencies map (evaluation key -> set of dependency paths) (wrapped in Arc for zero-copy sharing)
     pub dependencies: Arc<IndexMap<String, IndexSet<String>>>,
 
+    /// `dependencies` interned into `paths`, so cache checks compare ids only
+    pub dependency_ids: Arc<DependencyIds>,
+
+    /// Interned data paths of this schema, shared with its subforms and with the
+    /// caches of every instance built from them
+    pub paths: Arc<PathTable>,
+
     /// Evaluations grouped into batches (wrapped in Arc for zero-copy sharing)
     /// Each inner Vec contains evaluations that can run concurrently
     pub sorted_evaluations: Arc<Vec<Vec<String>>>,
@@ -73,6 +82,10 @@ pub struct ParsedSchema {
     /// schema-value extraction can distinguish editable layout fields in O(1).
     pub layout_field_refs: Arc<IndexSet<String>>,
 
+    /// Root layout paths mapped to the schema pointers their resolution reads, so
+    /// only layouts whose referenced nodes changed are resolved again
+    pub layout_dependencies: Arc<IndexMap<String, Vec<String>>>,
+
     /// Options URL templates (url_path, template_str, params_path) (wrapped in Arc for zero-copy sharing)
     pub options_templates: Arc<Vec<(String, String, String)>>,
 
@@ -100,6 +113,9 @@ pub struct ParsedSchema {
 
     /// Extracted large static arrays from $params to avoid massive cloning (wrapped in Arc for zero-copy sharing)
     pub static_arrays: Arc<IndexMap<String, Arc<Value>>>,
+
+    /// Literal `pattern` rules compiled at parse time (wrapped in Arc for zero-copy sharing)
+    pub rule_patterns: Arc<RulePatterns>,
 }
 
 impl ParsedSchema {
@@ -127,7 +143,16 @@ impl ParsedSchema {
     /// # Returns
     ///
     /// A Result containing the ParsedSchema or an error
-    pub fn parse_value(mut schema_val: Value) -> Result<Self, String> {
+    pub fn parse_value(schema_val: Value) -> Result<Self, String> {
+        Self::parse_value_in(schema_val, Arc::default())
+    }
+
+    /// Parse a schema Value whose paths are interned into `paths` (a subform
+    /// shares its parent's table)
+    pub(crate) fn parse_value_in(
+        mut schema_val: Value,
+        paths: Arc<PathTable>,
+    ) -> Result<Self, String> {
         let engine_config = RLogicConfig::default();
 
         // Pre-process: extract large static arrays from $params to prevent massive cloning
@@ -152,6 +177,8 @@ impl ParsedSchema {
             tables: Arc::new(IndexMap::new()),
             table_metadata: Arc::new(IndexMap::new()),
             dependencies: Arc::new(IndexMap::new()),
+            dependency_ids: Arc::default(),
+            paths,
             sorted_evaluations: Arc::new(Vec::new()),
             dependents_evaluations: Arc::new(IndexMap::new()),
             rules_evaluations: Arc::new(Vec::new()),
@@ -160,6 +187,7 @@ impl ParsedSchema {
             value_evaluations: Arc::new(Vec::new()),
             layout_paths: Arc::new(Vec::new()),
             layout_field_refs: Arc::new(IndexSet::new()),
+            layout_dependencies: Arc::new(IndexMap::new()),
             options_templates: Arc::new(Vec::new()),
             subforms: IndexMap::new(),
             reffed_by: Arc::new(IndexMap::new()),
@@ -167,6 +195,7 @@ impl ParsedSchema {
             conditional_hidden_fields: Arc::new(Vec::new()),
             conditional_readonly_fields: Arc::new(Vec::new()),
             static_arrays,
+            rule_patterns: Arc::new(RulePatterns::default()),
         };
 
         // Parse the schema to populate all fields.
@@ -222,3 +251,74 @@ impl ParsedSchema {
         &*self.schema
     }
 }
+
+/// Rough heap footprint of a JSON value: node headers plus string and key bytes
+fn value_size(value: &Value) -> usize {
+    let node = std::mem::size_of::<Value>();
+    match value {
+        Value::String(s) => node + s.len(),
+        Value::Array(items) => node + items.iter().map(value_size).sum::<usize>(),
+        Value::Object(map) => {
+            node + map
+                .iter()
+                .map(|(k, v)| std::mem::size_of::<String>() + k.len() + value_size(v))
+                .sum::<usize>()
+        }
+        _ => node,
+    }
+}
+
+fn strings<'a>(paths: impl IntoIterator<Item = &'a String>) -> usize {
+    paths
+        .into_iter()
+        .map(|p| std::mem::size_of::<String>() + p.len())
+        .sum()
+}
+
+/// Per-formula estimate for compiled logic held by the engine
+const COMPILED_LOGIC_SIZE: usize = 256;
+
+impl ParsedSchema {
+    /// Estimated memory footprint in bytes, used to weigh entries of a bounded
+    /// [`ParsedSchemaCache`](crate::ParsedSchemaCache). Walks the schema, tables and
+    /// static arrays; compiled logic and path lists are counted per entry.
+    pub fn estimated_size(&self) -> usize {
+        let mut size = std::mem::size_of::<Self>() + value_size(&self.schema);
+        size += self.tables.values().map(value_size).sum::<usize>();
+        size += self
+            .static_arrays
+            .values()
+            .map(|v| value_size(v))
+            .sum::<usize>();
+        size += self.evaluations.len() * COMPILED_LOGIC_SIZE;
+        size += self
+            .dependencies
+            .iter()
+            .map(|(key, deps)| {
+                // Counted twice: `dependency_ids` holds the key again and an id per dependency
+                2 * key.len() + strings(deps) + deps.len() * std::mem::size_of::<PathId>()
+            })
+            .sum::<usize>();
+        size += strings(self.rules_evaluations.iter())
+            + strings(self.fields_with_rules.iter())
+            + strings(self.others_evaluations.iter())
+            + strings(self.value_evaluations.iter())
+            + strings(self.layout_paths.iter());
+        size += self
+            .layout_dependencies
+            .iter()
+            .map(|(path, deps)| path.len() + strings(deps))
+            .sum::<usize>();
+        size += self
+            .sorted_evaluations
+            .iter()
+            .map(|b| strings(b))
+            .sum::<usize>();
+        size += self
+            .subforms
+            .values()
+            .map(|subform| subform.estimated_size())
+            .sum::<usize>();
+        size
+    }
+}
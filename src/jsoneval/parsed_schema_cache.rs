@@ -1,5 +1,8 @@
 use crate::ParsedSchema;
 use indexmap::IndexMap;
+use rapidhash::{HashMapExt, RapidHashMap};
+use smallvec::SmallVec;
+use std::cell::RefCell;
 /// Built-in cache store for Arc<ParsedSchema> instances
 ///
 /// Provides thread-safe caching of parsed schemas with caller-controlled lifecycle:
@@ -7,7 +10,239 @@ use indexmap::IndexMap;
 /// - Caller decides when to re-parse
 /// - Caller controls cache clearing
 /// - Caller manages memory release
-use std::sync::{Arc, RwLock};
+///
+/// A cache may also be bounded by entry count and/or estimated bytes (see
+/// [`ParsedSchema::estimated_size`]). Inserting past a limit evicts the least
+/// recently used entries that are not pinned.
+///
+/// The cache is read-mostly. Writers serialize on a lock and publish an immutable
+/// snapshot of the entries; each reader thread keeps the snapshot it last saw and
+/// only re-fetches it when the cache generation moves, so `get` takes no lock and
+/// writes no shared counter.
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, RwLock, Weak};
+
+/// Optional limits of a [`ParsedSchemaCache`]; `None` means unbounded
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct ParsedSchemaCacheCapacity {
+    /// Maximum number of entries
+    pub max_entries: Option<usize>,
+    /// Maximum total estimated size in bytes
+    pub max_bytes: Option<usize>,
+}
+
+struct CacheEntry {
+    schema: Arc<ParsedSchema>,
+    /// `ParsedSchema::estimated_size` at insertion
+    weight: usize,
+    /// Generation of the last hit, shared with the published snapshots
+    last_used: Arc<AtomicU64>,
+    pinned: bool,
+}
+
+#[derive(Default)]
+struct CacheState {
+    entries: IndexMap<String, CacheEntry>,
+    total_bytes: usize,
+    capacity: ParsedSchemaCacheCapacity,
+}
+
+impl CacheState {
+    fn over_capacity(&self) -> bool {
+        self.capacity
+            .max_entries
+            .is_some_and(|max| self.entries.len() > max)
+            || self
+                .capacity
+                .max_bytes
+                .is_some_and(|max| self.total_bytes > max)
+    }
+
+    fn insert(&mut self, key: String, entry: CacheEntry) -> Option<Arc<ParsedSchema>> {
+        self.total_bytes += entry.weight;
+        let previous = self.entries.insert(key, entry)?;
+        self.total_bytes -= previous.weight;
+        Some(previous.schema)
+    }
+
+    fn remove(&mut self, key: &str) -> Option<Arc<ParsedSchema>> {
+        let entry = self.entries.shift_remove(key)?;
+        self.total_bytes -= entry.weight;
+        Some(entry.schema)
+    }
+
+    /// Evict least recently used unpinned entries until within capacity.
+    /// Returns the number evicted; pinned entries may keep the cache over its limit.
+    fn evict(&mut self) -> u64 {
+        let mut evicted = 0;
+        while self.over_capacity() {
+            let victim = self
+                .entries
+                .iter()
+                .filter(|(_, entry)| !entry.pinned)
+                .min_by_key(|(_, entry)| entry.last_used.load(Ordering::Relaxed))
+                .map(|(key, _)| key.clone());
+            match victim {
+                Some(key) => {
+                    self.remove(&key);
+                    evicted += 1;
+                }
+                None => break,
+            }
+        }
+        evicted
+    }
+}
+
+/// Entry as seen by readers. Schemas are held weakly so a snapshot kept by an idle
+/// thread never delays releasing a removed schema.
+struct SnapshotEntry {
+    schema: Weak<ParsedSchema>,
+    last_used: Arc<AtomicU64>,
+}
+
+type Snapshot = RapidHashMap<String, SnapshotEntry>;
+
+const COUNTER_STRIPES: usize = 16;
+
+/// Counter split over cache lines so threads increment their own stripe
+#[derive(Default)]
+struct StripedCounter {
+    stripes: [PaddedCounter; COUNTER_STRIPES],
+}
+
+#[derive(Default)]
+#[repr(align(64))]
+struct PaddedCounter(AtomicU64);
+
+static NEXT_STRIPE: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    static STRIPE: usize = NEXT_STRIPE.fetch_add(1, Ordering::Relaxed) % COUNTER_STRIPES;
+    /// Snapshot last read by this thread, per cache
+    static READER_SNAPSHOTS: RefCell<SmallVec<[ReaderSnapshot; 2]>> =
+        RefCell::new(SmallVec::new());
+}
+
+struct ReaderSnapshot {
+    /// Keeps the owner's allocation alive, so its address is never reused
+    owner: Weak<CacheShared>,
+    generation: u64,
+    snapshot: Arc<Snapshot>,
+}
+
+impl StripedCounter {
+    fn increment(&self) {
+        let stripe = STRIPE.try_with(|s| *s).unwrap_or(0);
+        self.stripes[stripe].0.fetch_add(1, Ordering::Relaxed);
+    }
+
+    fn sum(&self) -> u64 {
+        self.stripes
+            .iter()
+            .map(|s| s.0.load(Ordering::Relaxed))
+            .sum()
+    }
+}
+
+#[derive(Default)]
+struct CacheShared {
+    /// Authoritative entries; held by writers and by non-lookup queries
+    state: RwLock<CacheState>,
+    /// Snapshot published by the last write
+    published: RwLock<Arc<Snapshot>>,
+    /// Bumped after each publish; also the recency clock of `last_used`
+    generation: AtomicU64,
+    hits: StripedCounter,
+    misses: StripedCounter,
+    evictions: AtomicU64,
+}
+
+impl CacheShared {
+    fn entry(&self, schema: Arc<ParsedSchema>, pinned: bool) -> CacheEntry {
+        CacheEntry {
+            weight: schema.estimated_size(),
+            schema,
+            last_used: Arc::new(AtomicU64::new(self.generation.load(Ordering::Relaxed))),
+            pinned,
+        }
+    }
+
+    /// Run a mutation under the write lock, evict down to capacity and publish
+    fn write<R>(&self, f: impl FnOnce(&mut CacheState, &Self) -> R) -> R {
+        let mut state = self.state.write().unwrap();
+        let result = f(&mut state, self);
+        let evicted = state.evict();
+        if evicted > 0 {
+            self.evictions.fetch_add(evicted, Ordering::Relaxed);
+        }
+
+        let mut snapshot = Snapshot::with_capacity(state.entries.len());
+        for (key, entry) in &state.entries {
+            snapshot.insert(
+                key.clone(),
+                SnapshotEntry {
+                    schema: Arc::downgrade(&entry.schema),
+                    last_used: Arc::clone(&entry.last_used),
+                },
+            );
+        }
+        *self.published.write().unwrap() = Arc::new(snapshot);
+        // Readers that see the new generation also see the snapshot stored before it
+        self.generation.fetch_add(1, Ordering::Release);
+        result
+    }
+
+    /// Run `f` against this thread's copy of the published snapshot
+    fn read<R>(self: &Arc<Self>, f: impl Fn(&Snapshot) -> R) -> R {
+        let generation = self.generation.load(Ordering::Acquire);
+        let local = READER_SNAPSHOTS.try_with(|readers| {
+            let mut readers = readers.borrow_mut();
+            let slot = match readers
+                .iter()
+                .position(|r| std::ptr::eq(r.owner.as_ptr(), Arc::as_ptr(self)))
+            {
+                Some(idx) => idx,
+                None => {
+                    readers.retain(|r| r.owner.strong_count() > 0);
+                    readers.push(ReaderSnapshot {
+                        owner: Arc::downgrade(self),
+                        generation: u64::MAX,
+                        snapshot: Arc::default(),
+                    });
+                    readers.len() - 1
+                }
+            };
+            let reader = &mut readers[slot];
+            if reader.generation != generation {
+                reader.snapshot = Arc::clone(&self.published.read().unwrap());
+                reader.generation = generation;
+            }
+            f(&reader.snapshot)
+        });
+        // Thread-local storage is gone while the thread shuts down
+        local.unwrap_or_else(|_| f(&self.published.read().unwrap()))
+    }
+
+    fn lookup(self: &Arc<Self>, key: &str) -> Option<Arc<ParsedSchema>> {
+        let found = self.read(|snapshot| {
+            let entry = snapshot.get(key)?;
+            let schema = entry.schema.upgrade()?;
+            // Store only when stale, so concurrent hits on one entry stay read-only
+            let now = self.generation.load(Ordering::Relaxed);
+            if entry.last_used.load(Ordering::Relaxed) < now {
+                entry.last_used.store(now, Ordering::Relaxed);
+            }
+            Some(schema)
+        });
+        if found.is_some() {
+            self.hits.increment();
+        } else {
+            self.misses.increment();
+        }
+        found
+    }
+}
 
 /// Thread-safe cache for storing and reusing ParsedSchema instances
 ///
@@ -36,57 +271,130 @@ use std::sync::{Arc, RwLock};
 /// ```
 #[derive(Clone)]
 pub struct ParsedSchemaCache {
-    cache: Arc<RwLock<IndexMap<String, Arc<ParsedSchema>>>>,
+    shared: Arc<CacheShared>,
 }
 
 impl ParsedSchemaCache {
     /// Create a new empty cache
     pub fn new() -> Self {
         Self {
-            cache: Arc::new(RwLock::new(IndexMap::new())),
+            shared: Arc::new(CacheShared::default()),
         }
     }
 
+    /// Create a new empty cache bounded by `capacity`
+    pub fn with_capacity(capacity: ParsedSchemaCacheCapacity) -> Self {
+        let cache = Self::new();
+        cache.set_capacity(capacity);
+        cache
+    }
+
+    /// Change the cache limits, evicting entries if it is now over them
+    pub fn set_capacity(&self, capacity: ParsedSchemaCacheCapacity) {
+        self.write(|state, _| state.capacity = capacity);
+    }
+
+    /// Current cache limits
+    pub fn capacity(&self) -> ParsedSchemaCacheCapacity {
+        self.shared.state.read().unwrap().capacity
+    }
+
     /// Insert or update a parsed schema with the given key
     ///
-    /// Returns the previous value if the key already existed
+    /// Returns the previous value if the key already existed. Replacing an entry
+    /// keeps its pinned state. If the cache is bounded, least recently used
+    /// unpinned entries (possibly this one) are evicted to stay within capacity.
     pub fn insert(&self, key: String, schema: Arc<ParsedSchema>) -> Option<Arc<ParsedSchema>> {
-        let mut cache = self.cache.write().unwrap();
-        cache.insert(key, schema)
+        self.write(|state, shared| {
+            let pinned = state.entries.get(&key).is_some_and(|entry| entry.pinned);
+            state.insert(key, shared.entry(schema, pinned))
+        })
+    }
+
+    /// Insert a schema that is never evicted until unpinned or removed
+    pub fn insert_pinned(
+        &self,
+        key: String,
+        schema: Arc<ParsedSchema>,
+    ) -> Option<Arc<ParsedSchema>> {
+        self.write(|state, shared| state.insert(key, shared.entry(schema, true)))
+    }
+
+    /// Pin or unpin an existing entry
+    ///
+    /// Returns false if the key doesn't exist. Unpinning may evict entries if the
+    /// cache is over capacity.
+    pub fn set_pinned(&self, key: &str, pinned: bool) -> bool {
+        self.write(|state, _| match state.entries.get_mut(key) {
+            Some(entry) => {
+                entry.pinned = pinned;
+                true
+            }
+            None => false,
+        })
+    }
+
+    /// Whether `key` currently maps to `schema`. Unlike [`get`](Self::get), this
+    /// counts no hit or miss and does not mark the entry as used.
+    pub(crate) fn holds(&self, key: &str, schema: &Arc<ParsedSchema>) -> bool {
+        self.shared.read(|snapshot| {
+            snapshot
+                .get(key)
+                .is_some_and(|entry| std::ptr::eq(entry.schema.as_ptr(), Arc::as_ptr(schema)))
+        })
+    }
+
+    /// Write generation; moves on every insert, removal and eviction
+    pub(crate) fn generation(&self) -> u64 {
+        self.shared.generation.load(Ordering::Acquire)
+    }
+
+    /// Run a write and, on the global cache, drop pooled instances of schemas it
+    /// removed or evicted
+    fn write<R>(&self, f: impl FnOnce(&mut CacheState, &CacheShared) -> R) -> R {
+        let result = self.shared.write(f);
+        let is_global = Lazy::get(&PARSED_SCHEMA_CACHE)
+            .is_some_and(|global| Arc::ptr_eq(&global.shared, &self.shared));
+        if is_global {
+            if let Some(pool) = Lazy::get(&crate::JSON_EVAL_POOL) {
+                pool.prune();
+            }
+        }
+        result
     }
 
     /// Get a cloned Arc reference to the cached schema
     ///
-    /// Returns None if the key doesn't exist
+    /// Returns None if the key doesn't exist. Takes no lock unless the cache
+    /// changed since this thread's previous lookup.
     pub fn get(&self, key: &str) -> Option<Arc<ParsedSchema>> {
-        let cache = self.cache.read().unwrap();
-        cache.get(key).cloned()
+        self.shared.lookup(key)
     }
 
     /// Remove and return the schema for the given key
     ///
     /// Returns None if the key doesn't exist
     pub fn remove(&self, key: &str) -> Option<Arc<ParsedSchema>> {
-        let mut cache = self.cache.write().unwrap();
-        cache.shift_remove(key)
+        self.write(|state, _| state.remove(key))
     }
 
-    /// Clear all cached schemas
+    /// Clear all cached schemas, pinned ones included
     pub fn clear(&self) {
-        let mut cache = self.cache.write().unwrap();
-        cache.clear();
+        self.write(|state, _| {
+            state.entries.clear();
+            state.total_bytes = 0;
+        });
     }
 
     /// Check if a key exists in the cache
     pub fn contains_key(&self, key: &str) -> bool {
-        let cache = self.cache.read().unwrap();
-        cache.contains_key(key)
+        self.shared.read(|snapshot| snapshot.contains_key(key))
     }
 
     /// Get the number of cached schemas
     pub fn len(&self) -> usize {
-        let cache = self.cache.read().unwrap();
-        cache.len()
+        let state = self.shared.state.read().unwrap();
+        state.entries.len()
     }
 
     /// Check if the cache is empty
@@ -96,16 +404,23 @@ impl ParsedSchemaCache {
 
     /// Get all keys currently in the cache
     pub fn keys(&self) -> Vec<String> {
-        let cache = self.cache.read().unwrap();
-        cache.keys().cloned().collect()
+        let state = self.shared.state.read().unwrap();
+        state.entries.keys().cloned().collect()
     }
 
     /// Get cache statistics
     pub fn stats(&self) -> ParsedSchemaCacheStats {
-        let cache = self.cache.read().unwrap();
+        let state = self.shared.state.read().unwrap();
         ParsedSchemaCacheStats {
-            entry_count: cache.len(),
-            keys: cache.keys().cloned().collect(),
+            entry_count: state.entries.len(),
+            keys: state.entries.keys().cloned().collect(),
+            total_bytes: state.total_bytes,
+            pinned_count: state.entries.values().filter(|e| e.pinned).count(),
+            max_entries: state.capacity.max_entries,
+            max_bytes: state.capacity.max_bytes,
+            hits: self.shared.hits.sum(),
+            misses: self.shared.misses.sum(),
+            evictions: self.shared.evictions.load(Ordering::Relaxed),
         }
     }
 
@@ -130,44 +445,45 @@ impl ParsedSchemaCache {
     where
         F: FnOnce() -> Arc<ParsedSchema>,
     {
-        // Try read first (fast path)
-        {
-            let cache = self.cache.read().unwrap();
-            if let Some(schema) = cache.get(key) {
-                return schema.clone();
-            }
+        // Lock-free lookup first (fast path)
+        if let Some(schema) = self.get(key) {
+            return schema;
         }
 
         // Need to insert (slow path)
-        let mut cache = self.cache.write().unwrap();
-        // Double-check in case another thread inserted while we waited for write lock
-        if let Some(schema) = cache.get(key) {
-            return schema.clone();
-        }
+        self.write(|state, shared| {
+            // Double-check in case another thread inserted while we waited for write lock
+            if let Some(entry) = state.entries.get(key) {
+                return entry.schema.clone();
+            }
 
-        let schema = factory();
-        cache.insert(key.to_string(), schema.clone());
-        schema
+            let schema = factory();
+            state.insert(key.to_string(), shared.entry(schema.clone(), false));
+            schema
+        })
     }
 
-    /// Batch insert multiple schemas at once
+    /// Batch insert multiple schemas at once, publishing them to readers together
     pub fn insert_batch(&self, entries: Vec<(String, Arc<ParsedSchema>)>) {
-        let mut cache = self.cache.write().unwrap();
-        for (key, schema) in entries {
-            cache.insert(key, schema);
-        }
+        self.write(|state, shared| {
+            for (key, schema) in entries {
+                let pinned = state.entries.get(&key).is_some_and(|entry| entry.pinned);
+                state.insert(key, shared.entry(schema, pinned));
+            }
+        });
     }
 
     /// Remove multiple keys at once
     pub fn remove_batch(&self, keys: &[String]) -> Vec<(String, Arc<ParsedSchema>)> {
-        let mut cache = self.cache.write().unwrap();
-        let mut removed = Vec::new();
-        for key in keys {
-            if let Some(schema) = cache.shift_remove(key) {
-                removed.push((key.clone(), schema));
+        self.write(|state, _| {
+            let mut removed = Vec::new();
+            for key in keys {
+                if let Some(schema) = state.remove(key) {
+                    removed.push((key.clone(), schema));
+                }
             }
-        }
-        removed
+            removed
+        })
     }
 }
 
@@ -184,11 +500,29 @@ pub struct ParsedSchemaCacheStats {
     pub entry_count: usize,
     /// List of all keys
     pub keys: Vec<String>,
+    /// Sum of the entries' estimated sizes in bytes
+    pub total_bytes: usize,
+    /// Number of pinned entries
+    pub pinned_count: usize,
+    /// Entry limit, if bounded
+    pub max_entries: Option<usize>,
+    /// Byte limit, if bounded
+    pub max_bytes: Option<usize>,
+    /// Lookups that found their key
+    pub hits: u64,
+    /// Lookups that did not
+    pub misses: u64,
+    /// Entries dropped to stay within capacity
+    pub evictions: u64,
 }
 
 impl std::fmt::Display for ParsedSchemaCacheStats {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        write!(f, "ParsedSchemaCache: {} entries", self.entry_count)?;
+        write!(
+            f,
+            "ParsedSchemaCache: {} entries, {} bytes ({} hits, {} misses, {} evictions)",
+            self.entry_count, self.total_bytes, self.hits, self.misses, self.evictions
+        )?;
         if !self.keys.is_empty() {
             write!(f, " (keys: {})", self.keys.join(", "))?;
         }
@@ -240,4 +574,84 @@ mod tests {
         // Both should share the same underlying cache
         assert_eq!(cache1.len(), cache2.len());
     }
+
+    fn schema() -> Arc<ParsedSchema> {
+        Arc::new(ParsedSchema::parse(r#"{"type": "object"}"#).unwrap())
+    }
+
+    #[test]
+    fn test_cache_evicts_least_recently_used() {
+        let cache = ParsedSchemaCache::with_capacity(ParsedSchemaCacheCapacity {
+            max_entries: Some(2),
+            max_bytes: None,
+        });
+        cache.insert("a".to_string(), schema());
+        cache.insert("b".to_string(), schema());
+        assert!(cache.get("a").is_some());
+        cache.insert("c".to_string(), schema());
+
+        assert_eq!(cache.keys(), vec!["a".to_string(), "c".to_string()]);
+        assert!(cache.get("b").is_none());
+        let stats = cache.stats();
+        assert_eq!((stats.hits, stats.misses, stats.evictions), (1, 1, 1));
+    }
+
+    #[test]
+    fn test_cache_byte_capacity_spares_pinned() {
+        let weight = schema().estimated_size();
+        let cache = ParsedSchemaCache::new();
+        cache.insert_pinned("pinned".to_string(), schema());
+        cache.insert("a".to_string(), schema());
+        cache.set_capacity(ParsedSchemaCacheCapacity {
+            max_entries: None,
+            max_bytes: Some(weight),
+        });
+        assert_eq!(cache.keys(), vec!["pinned".to_string()]);
+
+        // Pinned entries may hold the cache over its limit
+        cache.insert("b".to_string(), schema());
+        assert_eq!(cache.keys(), vec!["pinned".to_string()]);
+        assert_eq!(cache.stats().total_bytes, weight);
+
+        assert!(cache.set_pinned("pinned", false));
+        cache.insert("c".to_string(), schema());
+        assert_eq!(cache.keys(), vec!["c".to_string()]);
+        assert_eq!(cache.stats().evictions, 3);
+    }
+
+    #[test]
+    fn test_cache_snapshot_does_not_retain_removed_schema() {
+        let cache = ParsedSchemaCache::new();
+        let schema = schema();
+        cache.insert("a".to_string(), schema.clone());
+        // This thread now holds the published snapshot
+        assert!(cache.get("a").is_some());
+
+        cache.remove("a");
+        assert_eq!(Arc::strong_count(&schema), 1);
+        assert!(cache.get("a").is_none());
+    }
+
+    #[test]
+    fn test_cache_readers_observe_concurrent_inserts() {
+        let cache = ParsedSchemaCache::new();
+        cache.insert("a".to_string(), schema());
+
+        let readers: Vec<_> = (0..4)
+            .map(|_| {
+                let cache = cache.clone();
+                std::thread::spawn(move || {
+                    while cache.get("b").is_none() {
+                        assert!(cache.get("a").is_some());
+                        std::hint::spin_loop();
+                    }
+                })
+            })
+            .collect();
+        cache.insert("b".to_string(), schema());
+        for reader in readers {
+            reader.join().unwrap();
+        }
+        assert!(cache.stats().hits >= 4);
+    }
 }
@@ -0,0 +1,252 @@
+//! Binary snapshot of a fully parsed [`ParsedSchema`].
+//!
+//! Parsing walks the schema, compiles every formula, topo-sorts the evaluation
+//! batches, builds table metadata and extracts static arrays. A snapshot stores all
+//! of those results, so [`ParsedSchema::from_snapshot`] restores a schema with a
+//! single decode and none of that work. Write it once with
+//! [`ParsedSchema::to_snapshot`] (at build time, or after the first parse) and load
+//! it from any byte slice, including a memory-mapped file.
+//!
+//! Layout: magic, format version (u32 LE), the writing crate version (u8 length +
+//! bytes), then the MessagePack body. Compiled logic has no encoding that is stable
+//! across releases, so a snapshot only loads in the crate version that wrote it.
+
+use std::sync::Arc;
+
+use indexmap::{IndexMap, IndexSet};
+use serde::{Deserialize, Serialize};
+use serde_json::Value;
+
+use crate::jsoneval::parsed_schema::ParsedSchema;
+use crate::jsoneval::path_id::PathTable;
+use crate::jsoneval::rule_patterns::RulePatterns;
+use crate::jsoneval::table_metadata::TableMetadata;
+use crate::jsoneval::types::DependentItem;
+use crate::parse_schema::common::collect_layout_dependencies;
+use crate::rlogic::{CompiledLogic, CompiledLogicStore, LogicId, RLogic, RLogicConfig};
+
+const MAGIC: &[u8; 8] = b"JEVSNAP\0";
+const FORMAT_VERSION: u32 = 1;
+const CRATE_VERSION: &str = env!("CARGO_PKG_VERSION");
+
+/// Borrowed view of one schema level, written by `to_snapshot`.
+/// Field order must match [`SchemaData`].
+#[derive(Serialize)]
+struct SchemaRef<'a> {
+    schema: &'a Value,
+    logic: Vec<(LogicId, &'a CompiledLogic, &'a [String])>,
+    evaluations: &'a IndexMap<String, LogicId>,
+    tables: &'a IndexMap<String, Value>,
+    table_metadata: &'a IndexMap<String, TableMetadata>,
+    dependencies: &'a IndexMap<String, IndexSet<String>>,
+    sorted_evaluations: &'a Vec<Vec<String>>,
+    dependents_evaluations: &'a IndexMap<String, Vec<DependentItem>>,
+    rules_evaluations: &'a Vec<String>,
+    fields_with_rules: &'a Vec<String>,
+    others_evaluations: &'a Vec<String>,
+    value_evaluations: &'a Vec<String>,
+    layout_paths: &'a Vec<String>,
+    layout_field_refs: &'a IndexSet<String>,
+    options_templates: &'a Vec<(String, String, String)>,
+    reffed_by: &'a IndexMap<String, Vec<String>>,
+    dep_formula_triggers: &'a IndexMap<String, Vec<(String, usize)>>,
+    conditional_hidden_fields: &'a Vec<String>,
+    conditional_readonly_fields: &'a Vec<String>,
+    subforms: Vec<(&'a str, SchemaRef<'a>)>,
+}
+
+/// Owned counterpart of [`SchemaRef`], read by `from_snapshot`
+#[derive(Deserialize)]
+struct SchemaData {
+    schema: Value,
+    logic: Vec<(LogicId, CompiledLogic, Vec<String>)>,
+    evaluations: IndexMap<String, LogicId>,
+    tables: IndexMap<String, Value>,
+    table_metadata: IndexMap<String, TableMetadata>,
+    dependencies: IndexMap<String, IndexSet<String>>,
+    sorted_evaluations: Vec<Vec<String>>,
+    dependents_evaluations: IndexMap<String, Vec<DependentItem>>,
+    rules_evaluations: Vec<String>,
+    fields_with_rules: Vec<String>,
+    others_evaluations: Vec<String>,
+    value_evaluations: Vec<String>,
+    layout_paths: Vec<String>,
+    layout_field_refs: IndexSet<String>,
+    options_templates: Vec<(String, String, String)>,
+    reffed_by: IndexMap<String, Vec<String>>,
+    dep_formula_triggers: IndexMap<String, Vec<(String, usize)>>,
+    conditional_hidden_fields: Vec<String>,
+    conditional_readonly_fields: Vec<String>,
+    subforms: Vec<(String, SchemaData)>,
+}
+
+impl<'a> SchemaRef<'a> {
+    fn new(parsed: &'a ParsedSchema) -> Self {
+        Self {
+            schema: &parsed.schema,
+            logic: parsed.engine.store().entries(),
+            evaluations: &parsed.evaluations,
+            tables: &parsed.tables,
+            table_metadata: &parsed.table_metadata,
+            dependencies: &parsed.dependencies,
+            sorted_evaluations: &parsed.sorted_evaluations,
+            dependents_evaluations: &parsed.dependents_evaluations,
+            rules_evaluations: &parsed.rules_evaluations,
+            fields_with_rules: &parsed.fields_with_rules,
+            others_evaluations: &parsed.others_evaluations,
+            value_evaluations: &parsed.value_evaluations,
+            layout_paths: &parsed.layout_paths,
+            layout_field_refs: &parsed.layout_field_refs,
+            options_templates: &parsed.options_templates,
+            reffed_by: &parsed.reffed_by,
+            dep_formula_triggers: &parsed.dep_formula_triggers,
+            conditional_hidden_fields: &parsed.conditional_hidden_fields,
+            conditional_readonly_fields: &parsed.conditional_readonly_fields,
+            subforms: parsed
+                .subforms
+                .iter()
+                .map(|(path, subform)| (path.as_str(), SchemaRef::new(subform)))
+                .collect(),
+        }
+    }
+}
+
+impl SchemaData {
+    /// Rebuild the parsed schema; every level shares the root's static arrays and
+    /// path table
+    fn restore(
+        self,
+        static_arrays: &Arc<IndexMap<String, Arc<Value>>>,
+        paths: &Arc<PathTable>,
+    ) -> ParsedSchema {
+        let mut engine = RLogic::with_store(
+            CompiledLogicStore::from_entries(self.logic),
+            RLogicConfig::default(),
+        );
+        engine.set_static_arrays(Arc::clone(static_arrays));
+
+        // Regexes are not serializable; only the literal patterns are recompiled
+        let rule_patterns = RulePatterns::compile(&self.schema, &self.fields_with_rules);
+        // Derived from the schema as well, so it is not stored either
+        let layout_dependencies = collect_layout_dependencies(&self.schema, &self.layout_paths);
+        let dependency_ids = paths.intern_dependencies(&self.dependencies);
+
+        ParsedSchema {
+            schema: Arc::new(self.schema),
+            engine: Arc::new(engine),
+            evaluations: Arc::new(self.evaluations),
+            tables: Arc::new(self.tables),
+            table_metadata: Arc::new(self.table_metadata),
+            dependencies: Arc::new(self.dependencies),
+            dependency_ids: Arc::new(dependency_ids),
+            paths: Arc::clone(paths),
+            sorted_evaluations: Arc::new(self.sorted_evaluations),
+            dependents_evaluations: Arc::new(self.dependents_evaluations),
+            rules_evaluations: Arc::new(self.rules_evaluations),
+            fields_with_rules: Arc::new(self.fields_with_rules),
+            others_evaluations: Arc::new(self.others_evaluations),
+            value_evaluations: Arc::new(self.value_evaluations),
+            layout_paths: Arc::new(self.layout_paths),
+            layout_field_refs: Arc::new(self.layout_field_refs),
+            layout_dependencies: Arc::new(layout_dependencies),
+            options_templates: Arc::new(self.options_templates),
+            subforms: self
+                .subforms
+                .into_iter()
+                .map(|(path, subform)| (path, Arc::new(subform.restore(static_arrays, paths))))
+                .collect(),
+            reffed_by: Arc::new(self.reffed_by),
+            dep_formula_triggers: Arc::new(self.dep_formula_triggers),
+            conditional_hidden_fields: Arc::new(self.conditional_hidden_fields),
+            conditional_readonly_fields: Arc::new(self.conditional_readonly_fields),
+            static_arrays: Arc::clone(static_arrays),
+            rule_patterns: Arc::new(rule_patterns),
+        }
+    }
+}
+
+/// Split off and check the header, returning the body
+fn read_header(bytes: &[u8]) -> Result<&[u8], String> {
+    let rest = bytes
+        .strip_prefix(MAGIC.as_slice())
+        .ok_or("Not a ParsedSchema snapshot")?;
+    if rest.len() < 4 {
+        return Err("Truncated ParsedSchema snapshot".to_string());
+    }
+    let (format, rest) = rest.split_at(4);
+    let format = u32::from_le_bytes([format[0], format[1], format[2], format[3]]);
+    if format != FORMAT_VERSION {
+        return Err(format!(
+            "Unsupported ParsedSchema snapshot format {} (expected {})",
+            format, FORMAT_VERSION
+        ));
+    }
+    let (&len, rest) = rest
+        .split_first()
+        .ok_or("Truncated ParsedSchema snapshot")?;
+    if rest.len() < len as usize {
+        return Err("Truncated ParsedSchema snapshot".to_string());
+    }
+    let (version, body) = rest.split_at(len as usize);
+    if version != CRATE_VERSION.as_bytes() {
+        return Err(format!(
+            "ParsedSchema snapshot was written by version {}, this is {}",
+            String::from_utf8_lossy(version),
+            CRATE_VERSION
+        ));
+    }
+    Ok(body)
+}
+
+impl ParsedSchema {
+    /// Serialize this parsed schema into a snapshot for [`from_snapshot`](Self::from_snapshot)
+    pub fn to_snapshot(&self) -> Result<Vec<u8>, String> {
+        let mut bytes = Vec::new();
+        bytes.extend_from_slice(MAGIC);
+        bytes.extend_from_slice(&FORMAT_VERSION.to_le_bytes());
+        bytes.push(CRATE_VERSION.len() as u8);
+        bytes.extend_from_slice(CRATE_VERSION.as_bytes());
+
+        let body = (&*self.static_arrays, SchemaRef::new(self));
+        rmp_serde::encode::write(&mut bytes, &body)
+            .map_err(|e| format!("Failed to serialize ParsedSchema snapshot: {}", e))?;
+        Ok(bytes)
+    }
+
+    /// Restore a parsed schema from a snapshot written by [`to_snapshot`](Self::to_snapshot)
+    /// with the same crate version. No schema walking or formula compilation runs.
+    ///
+    /// # Arguments
+    ///
+    /// * `bytes` - Snapshot bytes (e.g. read or memory-mapped from a file)
+    ///
+    /// # Returns
+    ///
+    /// A Result containing the ParsedSchema or an error
+    pub fn from_snapshot(bytes: &[u8]) -> Result<Self, String> {
+        let body = read_header(bytes)?;
+        let (static_arrays, root): (IndexMap<String, Arc<Value>>, SchemaData) =
+            rmp_serde::from_slice(body)
+                .map_err(|e| format!("Failed to deserialize ParsedSchema snapshot: {}", e))?;
+        Ok(root.restore(&Arc::new(static_arrays), &Arc::default()))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn rejects_foreign_and_mismatched_snapshots() {
+        assert!(ParsedSchema::from_snapshot(b"{}").is_err());
+
+        let parsed = ParsedSchema::parse(r#"{"type": "object"}"#).unwrap();
+        let mut bytes = parsed.to_snapshot().unwrap();
+        assert!(ParsedSchema::from_snapshot(&bytes).is_ok());
+
+        // Version string starts after magic, format and its length byte
+        bytes[MAGIC.len() + 5] ^= 0xff;
+        let err = ParsedSchema::from_snapshot(&bytes).err().unwrap();
+        assert!(err.contains("written by version"), "{}", err);
+    }
+}
@@ -0,0 +1,203 @@
+//! Compiled selective-evaluation filters.
+//!
+//! `evaluate(paths)` and `validate(paths)` keep an evaluation key when it lies under
+//! a filter path or a filter path lies under it (plain string prefixes in both
+//! directions). Testing every key against every filter costs O(keys × filters);
+//! `PathFilter` compiles the filters into a byte trie once per call so each key is
+//! decided by a single walk over its own bytes, however many filters were passed.
+
+use smallvec::SmallVec;
+
+use crate::jsoneval::path_utils;
+
+#[derive(Default)]
+struct Node {
+    /// (byte, child node index); filter paths share long prefixes, so fan-out is small
+    children: SmallVec<[(u8, u32); 2]>,
+    /// A filter path ends here
+    terminal: bool,
+}
+
+/// Prefix trie over normalized filter paths
+pub struct PathFilter {
+    nodes: Vec<Node>,
+}
+
+impl PathFilter {
+    fn empty() -> Self {
+        PathFilter {
+            nodes: vec![Node::default()],
+        }
+    }
+
+    /// Compile filter paths used verbatim (schema pointers)
+    pub fn from_paths(paths: &[String]) -> Option<Self> {
+        if paths.is_empty() {
+            return None;
+        }
+        let mut filter = Self::empty();
+        for p in paths {
+            filter.insert(p.bytes());
+        }
+        Some(filter)
+    }
+
+    /// Compile `evaluate()` selectors: `#/` pointers as-is, `/a/b` as `#/a/b`,
+    /// dotted `a.b` as `#/a/b`
+    pub fn from_selectors(paths: &[String]) -> Option<Self> {
+        if paths.is_empty() {
+            return None;
+        }
+        let mut filter = Self::empty();
+        for p in paths {
+            if p.starts_with("#/") {
+                filter.insert(p.bytes());
+            } else if p.starts_with('/') {
+                filter.insert(b"#".iter().copied().chain(p.bytes()));
+            } else {
+                let dotted = p.bytes().map(|b| if b == b'.' { b'/' } else { b });
+                filter.insert(b"#/".iter().copied().chain(dotted));
+            }
+        }
+        Some(filter)
+    }
+
+    /// Compile dotted field paths as schema pointers (`a.b` → `#/a/properties/b`),
+    /// also accepting the root-level `#/properties/...` spelling
+    pub fn from_field_paths(paths: &[String]) -> Option<Self> {
+        if paths.is_empty() {
+            return None;
+        }
+        let mut filter = Self::empty();
+        for p in paths {
+            let ptr = path_utils::dot_notation_to_schema_pointer(p);
+            if let Some(rest) = ptr.strip_prefix("#/") {
+                filter.insert(b"#/properties/".iter().copied().chain(rest.bytes()));
+            }
+            filter.insert(ptr.bytes());
+        }
+        Some(filter)
+    }
+
+    fn insert(&mut self, path: impl Iterator<Item = u8>) {
+        let mut node = 0usize;
+        for b in path {
+            node = match self.child(node, b) {
+                Some(next) => next,
+                None => {
+                    let next = self.nodes.len();
+                    self.nodes.push(Node::default());
+                    self.nodes[node].children.push((b, next as u32));
+                    next
+                }
+            };
+        }
+        self.nodes[node].terminal = true;
+    }
+
+    #[inline]
+    fn child(&self, node: usize, byte: u8) -> Option<usize> {
+        self.nodes[node]
+            .children
+            .iter()
+            .find(|(b, _)| *b == byte)
+            .map(|&(_, next)| next as usize)
+    }
+
+    /// Walk `key` through the trie.
+    /// `Some(true)`: some filter is a prefix of `key`.
+    /// `Some(false)`: `key` is a strict prefix of some filter.
+    /// `None`: neither.
+    #[inline]
+    fn walk(&self, key: &str) -> Option<bool> {
+        let mut node = 0usize;
+        for &b in key.as_bytes() {
+            if self.nodes[node].terminal {
+                return Some(true);
+            }
+            node = self.child(node, b)?;
+        }
+        // Every node lies on the way to a terminal, so a fully consumed key is
+        // either a filter itself or the prefix of a longer one
+        Some(self.nodes[node].terminal)
+    }
+
+    /// `key` lies under a filter path, or a filter path lies under `key`
+    #[inline]
+    pub fn matches(&self, key: &str) -> bool {
+        self.walk(key).is_some()
+    }
+
+    /// Like [`matches`](Self::matches), but a `$params` key is not pulled in just
+    /// because a filter path lies under it
+    #[inline]
+    pub fn matches_key(&self, key: &str) -> bool {
+        match self.walk(key) {
+            Some(true) => true,
+            Some(false) => !key.contains("/$params/"),
+            None => false,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::PathFilter;
+
+    fn naive(filters: &[&str], key: &str) -> bool {
+        filters
+            .iter()
+            .any(|p| key.starts_with(p) || p.starts_with(key))
+    }
+
+    fn naive_key(filters: &[&str], key: &str) -> bool {
+        filters
+            .iter()
+            .any(|p| key.starts_with(p) || (p.starts_with(key) && !key.contains("/$params/")))
+    }
+
+    #[test]
+    fn agrees_with_bidirectional_prefix_checks() {
+        let filters = [
+            "#/illustration/properties/insured",
+            "#/illustration/properties/ins",
+            "#/$params/properties/rate",
+        ];
+        let keys = [
+            "#/illustration/properties/insured/properties/age/value",
+            "#/illustration/properties/insured",
+            "#/illustration/properties/in",
+            "#/illustration",
+            "#/illustration/properties/policy/value",
+            "#/$params/properties",
+            "#/$params/properties/rate/value",
+            "#/$params/",
+            "#/other",
+            "",
+        ];
+        let owned: Vec<String> = filters.iter().map(|s| s.to_string()).collect();
+        let filter = PathFilter::from_paths(&owned).unwrap();
+        for key in keys {
+            assert_eq!(filter.matches(key), naive(&filters, key), "{}", key);
+            assert_eq!(filter.matches_key(key), naive_key(&filters, key), "{}", key);
+        }
+    }
+
+    #[test]
+    fn normalizes_selectors() {
+        let selectors = vec!["a.b".to_string(), "/c/d".to_string(), "#/e".to_string()];
+        let filter = PathFilter::from_selectors(&selectors).unwrap();
+        assert!(filter.matches("#/a/b/value"));
+        assert!(filter.matches("#/c/d"));
+        assert!(filter.matches("#/e/properties/f"));
+        assert!(!filter.matches("#/a/c"));
+        assert!(PathFilter::from_selectors(&[]).is_none());
+    }
+
+    #[test]
+    fn empty_filter_path_matches_everything() {
+        let filter = PathFilter::from_paths(&[String::new()]).unwrap();
+        assert!(filter.matches("#/anything"));
+        assert!(filter.matches_key("#/$params/x"));
+    }
+}
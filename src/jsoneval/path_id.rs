@@ -0,0 +1,226 @@
+//! Interning of normalized data paths into dense [`PathId`]s.
+//!
+//! Version trackers and cache entries key their counters by `PathId`, so
+//! validating a cached result is a few integer comparisons instead of hashing
+//! path strings. `$params` paths get their own index space (a flag bit in the
+//! id), which makes params-only checks and merges free of string prefix tests.
+//!
+//! Each root schema owns one [`PathTable`], shared by its subforms and by every
+//! instance built from it, and freed with the last of them. Formula
+//! dependencies are interned once when the schema is parsed
+//! ([`PathTable::intern_dependencies`]); at run time the table only grows by
+//! paths the data brings in, such as the fields of array items.
+//!
+//! A path is interned after its parent and records the parent's id, so asking
+//! whether a path lies under `/riders` follows a few integers instead of
+//! comparing strings.
+
+use indexmap::{IndexMap, IndexSet};
+use rapidhash::RapidHashMap;
+use smallvec::SmallVec;
+use std::sync::{Arc, RwLock, RwLockReadGuard};
+
+use crate::jsoneval::path_utils;
+
+const PARAMS_FLAG: u32 = 1 << 31;
+
+/// Interned id of a normalized data pointer (e.g. `/illustration/insured/age`)
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, PartialOrd, Ord)]
+pub struct PathId(u32);
+
+/// Ids for the dependency list of one formula
+pub type PathIds = SmallVec<[PathId; 16]>;
+
+/// Interned data paths of one schema and its subforms
+#[derive(Default)]
+pub struct PathTable {
+    paths: RwLock<Paths>,
+}
+
+#[derive(Default)]
+pub struct Paths {
+    ids: RapidHashMap<Arc<str>, PathId>,
+    data_paths: Vec<PathNode>,
+    params_paths: Vec<PathNode>,
+}
+
+struct PathNode {
+    path: Arc<str>,
+    parent: Option<PathId>,
+}
+
+/// Dependency ids of every formula, in the order of its dependency set
+#[derive(Default)]
+pub struct DependencyIds(IndexMap<String, Box<[PathId]>>);
+
+impl DependencyIds {
+    /// Dependency ids of `eval_key`; empty for a key without dependencies
+    #[inline]
+    pub fn of(&self, eval_key: &str) -> &[PathId] {
+        self.0.get(eval_key).map_or(&[], |ids| ids)
+    }
+}
+
+impl Paths {
+    /// Path string of an interned id
+    #[inline]
+    pub fn path(&self, id: PathId) -> &str {
+        &self.node(id).path
+    }
+
+    /// Shared copy of the path string of an interned id
+    #[inline]
+    pub fn shared_path(&self, id: PathId) -> Arc<str> {
+        Arc::clone(&self.node(id).path)
+    }
+
+    /// Id of an already-interned data pointer
+    #[inline]
+    pub fn lookup(&self, path: &str) -> Option<PathId> {
+        self.ids.get(path).copied()
+    }
+
+    /// Whether `id` names a path strictly below `ancestor`
+    #[inline]
+    pub fn is_within(&self, id: PathId, ancestor: PathId) -> bool {
+        let mut current = self.node(id).parent;
+        while let Some(parent) = current {
+            if parent == ancestor {
+                return true;
+            }
+            current = self.node(parent).parent;
+        }
+        false
+    }
+
+    #[inline]
+    fn node(&self, id: PathId) -> &PathNode {
+        if id.is_params() {
+            &self.params_paths[id.index()]
+        } else {
+            &self.data_paths[id.index()]
+        }
+    }
+
+    fn intern(&mut self, path: &str) -> PathId {
+        if let Some(&id) = self.ids.get(path) {
+            return id;
+        }
+        let parent = match path.rfind('/') {
+            Some(at) if at > 0 => Some(self.intern(&path[..at])),
+            _ => None,
+        };
+        let path: Arc<str> = Arc::from(path);
+        let node = PathNode {
+            path: Arc::clone(&path),
+            parent,
+        };
+        let id = if path.starts_with("/$params") {
+            self.params_paths.push(node);
+            PathId::from_parts(true, self.params_paths.len() - 1)
+        } else {
+            self.data_paths.push(node);
+            PathId::from_parts(false, self.data_paths.len() - 1)
+        };
+        self.ids.insert(path, id);
+        id
+    }
+}
+
+impl PathTable {
+    /// Intern a normalized data pointer
+    pub fn id(&self, path: &str) -> PathId {
+        if let Some(id) = self.lookup(path) {
+            return id;
+        }
+        self.paths.write().unwrap().intern(path)
+    }
+
+    /// Id of an already-interned data pointer; a path never interned has no versions
+    #[inline]
+    pub fn lookup(&self, path: &str) -> Option<PathId> {
+        self.read().lookup(path)
+    }
+
+    /// The interned path string
+    pub fn path(&self, id: PathId) -> Arc<str> {
+        self.read().shared_path(id)
+    }
+
+    /// Read access for scans that resolve many ids. Interning while the guard
+    /// is held deadlocks.
+    pub fn read(&self) -> RwLockReadGuard<'_, Paths> {
+        self.paths.read().unwrap()
+    }
+
+    /// Intern the data pointers of every formula's schema dependency paths
+    pub fn intern_dependencies(
+        &self,
+        dependencies: &IndexMap<String, IndexSet<String>>,
+    ) -> DependencyIds {
+        let mut paths = self.paths.write().unwrap();
+        let ids = dependencies
+            .iter()
+            .map(|(eval_key, deps)| {
+                let ids = deps
+                    .iter()
+                    .map(|dep| paths.intern(&path_utils::schema_path_to_data_pointer(dep)))
+                    .collect();
+                (eval_key.clone(), ids)
+            })
+            .collect();
+        DependencyIds(ids)
+    }
+}
+
+impl PathId {
+    /// Whether this is a `/$params` path
+    #[inline(always)]
+    pub fn is_params(self) -> bool {
+        self.0 & PARAMS_FLAG != 0
+    }
+
+    /// Position within its index space (`$params` or data)
+    #[inline(always)]
+    pub fn index(self) -> usize {
+        (self.0 & !PARAMS_FLAG) as usize
+    }
+
+    #[inline(always)]
+    pub(crate) fn from_parts(is_params: bool, index: usize) -> PathId {
+        assert!(index < PARAMS_FLAG as usize, "path table overflow");
+        PathId(index as u32 | if is_params { PARAMS_FLAG } else { 0 })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn paths_know_their_ancestors() {
+        let table = PathTable::default();
+        let leaf = table.id("/riders/0/sa");
+        let riders = table.lookup("/riders").unwrap();
+        let item = table.lookup("/riders/0").unwrap();
+        let other = table.id("/ridersx/sa");
+
+        let paths = table.read();
+        assert!(paths.is_within(leaf, riders));
+        assert!(paths.is_within(leaf, item));
+        assert!(!paths.is_within(riders, riders));
+        assert!(!paths.is_within(other, riders));
+        assert_eq!(paths.path(leaf), "/riders/0/sa");
+    }
+
+    #[test]
+    fn params_paths_have_their_own_ids() {
+        let table = PathTable::default();
+        let rate = table.id("/$params/rate");
+        assert!(rate.is_params());
+        assert!(!table.id("/rate").is_params());
+        assert_eq!(table.id("/$params/rate"), rate);
+        let params = table.lookup("/$params").unwrap();
+        assert!(table.read().is_within(rate, params));
+    }
+}
@@ -0,0 +1,160 @@
+//! Compiled regexes for `pattern` validation rules.
+//!
+//! Literal patterns are compiled once while the schema is parsed and kept in
+//! [`RulePatterns`], which a `ParsedSchema` shares with every instance created from
+//! it: validating against them is a plain map read, with no lock and no
+//! compilation. Patterns produced by a formula are only known at validation time;
+//! they are compiled on first use into a bounded process-wide LRU shared by all
+//! instances.
+
+use std::collections::HashMap;
+use std::sync::Mutex;
+
+use indexmap::IndexMap;
+use once_cell::sync::Lazy;
+use regex::Regex;
+use serde_json::Value;
+
+use crate::jsoneval::path_utils;
+
+/// Formula-produced patterns kept compiled across calls and instances
+const DYNAMIC_CAPACITY: usize = 256;
+
+static DYNAMIC_PATTERNS: Lazy<Mutex<PatternLru>> = Lazy::new(|| {
+    Mutex::new(PatternLru {
+        entries: HashMap::new(),
+        tick: 0,
+    })
+});
+
+/// An invalid pattern validates nothing (matches every value), as it always has
+fn compile(pattern: &str) -> Regex {
+    Regex::new(pattern).unwrap_or_else(|_| Regex::new("(?:)").unwrap())
+}
+
+/// Regexes for the literal `pattern` rules of one schema, keyed by pattern
+#[derive(Debug, Default)]
+pub struct RulePatterns {
+    compiled: IndexMap<String, Regex>,
+}
+
+impl RulePatterns {
+    /// Compile the literal `pattern` rule of every field in `fields_with_rules`.
+    /// Rules whose pattern is a `$evaluation` are left to the dynamic cache.
+    pub fn compile(schema: &Value, fields_with_rules: &[String]) -> Self {
+        let mut compiled = IndexMap::new();
+        for field_path in fields_with_rules {
+            let schema_path = path_utils::dot_notation_to_schema_pointer(field_path);
+            let pointer = schema_path.trim_start_matches('#');
+            let field_schema = schema
+                .pointer(pointer)
+                .or_else(|| schema.pointer(&format!("/properties{}", pointer)));
+            let pattern = match field_schema.and_then(|s| s.pointer("/rules/pattern")) {
+                Some(Value::String(p)) => p,
+                Some(Value::Object(rule)) => match rule.get("value") {
+                    Some(Value::String(p)) => p,
+                    _ => continue,
+                },
+                _ => continue,
+            };
+            if !compiled.contains_key(pattern) {
+                compiled.insert(pattern.clone(), compile(pattern));
+            }
+        }
+        RulePatterns { compiled }
+    }
+
+    /// Whether `text` matches `pattern`, compiling it only if it was not a literal
+    /// pattern of this schema and is not in the shared dynamic cache
+    pub fn is_match(&self, pattern: &str, text: &str) -> bool {
+        if let Some(regex) = self.compiled.get(pattern) {
+            return regex.is_match(text);
+        }
+        // Regex clones share the compiled program; match outside the lock
+        let regex = DYNAMIC_PATTERNS.lock().unwrap().get_or_compile(pattern);
+        regex.is_match(text)
+    }
+
+    /// Number of precompiled literal patterns
+    pub fn len(&self) -> usize {
+        self.compiled.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.compiled.is_empty()
+    }
+}
+
+/// Least-recently-used cache of compiled patterns
+struct PatternLru {
+    /// pattern -> (regex, tick of last use)
+    entries: HashMap<String, (Regex, u64)>,
+    tick: u64,
+}
+
+impl PatternLru {
+    fn get_or_compile(&mut self, pattern: &str) -> Regex {
+        self.tick += 1;
+        let tick = self.tick;
+        if let Some((regex, last_used)) = self.entries.get_mut(pattern) {
+            *last_used = tick;
+            return regex.clone();
+        }
+        if self.entries.len() >= DYNAMIC_CAPACITY {
+            // Eviction scans the entries; it only runs on a miss at capacity
+            if let Some(oldest) = self
+                .entries
+                .iter()
+                .min_by_key(|(_, (_, last_used))| *last_used)
+                .map(|(p, _)| p.clone())
+            {
+                self.entries.remove(&oldest);
+            }
+        }
+        let regex = compile(pattern);
+        self.entries
+            .insert(pattern.to_string(), (regex.clone(), tick));
+        regex
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde_json::json;
+
+    #[test]
+    fn compiles_literal_patterns_only() {
+        let schema = json!({
+            "properties": {
+                "code": { "rules": { "pattern": { "value": "^[A-Z]+$" } } },
+                "zip": { "rules": { "pattern": "^\\d{5}$" } },
+                "dynamic": { "rules": { "pattern": { "value": { "$evaluation": { "var": "p" } } } } }
+            }
+        });
+        let fields = vec!["code".to_string(), "zip".to_string(), "dynamic".to_string()];
+        let patterns = RulePatterns::compile(&schema, &fields);
+        assert_eq!(patterns.len(), 2);
+        assert!(patterns.is_match("^[A-Z]+$", "ABC"));
+        assert!(!patterns.is_match("^\\d{5}$", "123"));
+        // Not precompiled: served by the dynamic cache
+        assert!(patterns.is_match("^a", "abc"));
+        // Invalid patterns match everything
+        assert!(patterns.is_match("(", "anything"));
+    }
+
+    #[test]
+    fn dynamic_cache_is_bounded() {
+        let mut lru = PatternLru {
+            entries: HashMap::new(),
+            tick: 0,
+        };
+        lru.get_or_compile("^keep$");
+        for i in 0..DYNAMIC_CAPACITY * 2 {
+            lru.get_or_compile("^keep$");
+            lru.get_or_compile(&format!("^p{}$", i));
+        }
+        assert_eq!(lru.entries.len(), DYNAMIC_CAPACITY);
+        assert!(lru.entries.contains_key("^keep$"));
+    }
+}
@@ -0,0 +1,238 @@
+//! Borrowed view of the evaluated schema for the schema getters.
+//!
+//! The evaluated schema keeps large static arrays out of line, leaving
+//! `{"$static_array": ...}` markers in their place. [`EvaluatedSchemaView`] writes
+//! the schema straight from `&evaluated_schema`, swapping each marker for its
+//! array and optionally skipping the root `$params`, so JSON and MessagePack
+//! output need no intermediate copy of the schema. [`EvaluatedSchemaView::to_value`]
+//! does the same while building an owned `Value`, in a single pass.
+
+use std::collections::HashMap;
+
+use indexmap::IndexMap;
+use serde::ser::{SerializeMap, SerializeSeq};
+use serde::{Serialize, Serializer};
+use serde_json::Value;
+use std::sync::Arc;
+
+/// Static-array replacements arranged by JSON pointer segment
+#[derive(Default)]
+struct MarkerTree<'a> {
+    /// Array that replaces the node at this path
+    array: Option<&'a Value>,
+    children: HashMap<String, MarkerTree<'a>>,
+}
+
+impl<'a> MarkerTree<'a> {
+    fn new(static_arrays: &'a IndexMap<String, Arc<Value>>) -> Self {
+        let mut root = MarkerTree::default();
+        for (static_key, array) in static_arrays {
+            // `/$table` keys point at a marker under the table's schema path
+            let schema_path = static_key
+                .strip_prefix("/$table")
+                .unwrap_or(static_key.as_str());
+            let mut node = &mut root;
+            if !schema_path.is_empty() {
+                for segment in schema_path.trim_start_matches('/').split('/') {
+                    let segment = segment.replace("~1", "/").replace("~0", "~");
+                    node = node.children.entry(segment).or_default();
+                }
+            }
+            node.array = Some(array);
+        }
+        root
+    }
+
+    /// Replacements below the child at `key`, if any
+    #[inline]
+    fn child(&self, key: &str) -> Option<&MarkerTree<'a>> {
+        self.children.get(key)
+    }
+}
+
+/// The evaluated schema with `$static_array` markers resolved, serialized or
+/// copied on demand. Created by [`crate::JSONEval::evaluated_schema_view`].
+pub struct EvaluatedSchemaView<'a> {
+    schema: &'a Value,
+    markers: MarkerTree<'a>,
+    without_params: bool,
+}
+
+impl<'a> EvaluatedSchemaView<'a> {
+    pub(crate) fn new(
+        schema: &'a Value,
+        static_arrays: &'a IndexMap<String, Arc<Value>>,
+        without_params: bool,
+    ) -> Self {
+        Self {
+            schema,
+            markers: MarkerTree::new(static_arrays),
+            without_params,
+        }
+    }
+
+    fn root(&self) -> Node<'_> {
+        Node {
+            value: self.schema,
+            markers: Some(&self.markers),
+            skip_params: self.without_params,
+        }
+    }
+
+    /// Build the resolved schema as an owned value
+    pub fn to_value(&self) -> Value {
+        self.root().to_value()
+    }
+}
+
+impl Serialize for EvaluatedSchemaView<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        self.root().serialize(serializer)
+    }
+}
+
+/// One schema node and the marker replacements beneath it
+struct Node<'a> {
+    value: &'a Value,
+    markers: Option<&'a MarkerTree<'a>>,
+    /// Omit `$params` from this (root) object
+    skip_params: bool,
+}
+
+impl<'a> Node<'a> {
+    #[inline]
+    fn child(&self, value: &'a Value, key: &str) -> Node<'a> {
+        Node {
+            value,
+            markers: self.markers.and_then(|markers| markers.child(key)),
+            skip_params: false,
+        }
+    }
+
+    /// Marker subtree, when something below this node is replaced
+    #[inline]
+    fn nested_markers(&self) -> Option<&'a MarkerTree<'a>> {
+        self.markers.filter(|markers| !markers.children.is_empty())
+    }
+
+    fn to_value(&self) -> Value {
+        if let Some(array) = self.markers.and_then(|markers| markers.array) {
+            return array.clone();
+        }
+        if self.nested_markers().is_none() && !self.skip_params {
+            return self.value.clone();
+        }
+        match self.value {
+            Value::Object(map) => Value::Object(
+                map.iter()
+                    .filter(|(key, _)| !(self.skip_params && key.as_str() == "$params"))
+                    .map(|(key, value)| (key.clone(), self.child(value, key).to_value()))
+                    .collect(),
+            ),
+            Value::Array(items) => Value::Array(
+                items
+                    .iter()
+                    .enumerate()
+                    .map(|(index, item)| self.child(item, &index.to_string()).to_value())
+                    .collect(),
+            ),
+            other => other.clone(),
+        }
+    }
+}
+
+impl Serialize for Node<'_> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        if let Some(array) = self.markers.and_then(|markers| markers.array) {
+            return array.serialize(serializer);
+        }
+        if self.nested_markers().is_none() && !self.skip_params {
+            return self.value.serialize(serializer);
+        }
+        // Same calls as `Value::serialize`, so the output bytes match a resolved copy
+        match self.value {
+            Value::Object(map) => {
+                let skipped = self.skip_params && map.contains_key("$params");
+                let mut out = serializer.serialize_map(Some(map.len() - skipped as usize))?;
+                for (key, value) in map {
+                    if self.skip_params && key == "$params" {
+                        continue;
+                    }
+                    out.serialize_entry(key, &self.child(value, key))?;
+                }
+                out.end()
+            }
+            Value::Array(items) => {
+                let mut out = serializer.serialize_seq(Some(items.len()))?;
+                for (index, item) in items.iter().enumerate() {
+                    out.serialize_element(&self.child(item, &index.to_string()))?;
+                }
+                out.end()
+            }
+            other => other.serialize(serializer),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde_json::json;
+
+    fn resolved_copy(
+        schema: &Value,
+        static_arrays: &IndexMap<String, Arc<Value>>,
+        without_params: bool,
+    ) -> Value {
+        let mut copy = schema.clone();
+        for (key, array) in static_arrays {
+            let path = key.strip_prefix("/$table").unwrap_or(key);
+            if let Some(target) = copy.pointer_mut(path) {
+                *target = (**array).clone();
+            }
+        }
+        if without_params {
+            copy.as_object_mut().unwrap().remove("$params");
+        }
+        copy
+    }
+
+    #[test]
+    fn matches_resolved_copy() {
+        let schema = json!({
+            "$params": { "rates": { "$static_array": "/$params/rates" } },
+            "properties": {
+                "plan": {
+                    "value": { "$static_array": "/$table/properties/plan/value" },
+                    "rows": [{ "a": 1 }, { "b": { "$static_array": "/$table/properties/plan/rows/1/b" } }]
+                },
+                "name": { "type": "string", "value": 1.5 }
+            }
+        });
+        let mut static_arrays = IndexMap::new();
+        static_arrays.insert("/$params/rates".to_string(), Arc::new(json!([1, 2, 3])));
+        static_arrays.insert(
+            "/$table/properties/plan/value".to_string(),
+            Arc::new(json!([[1, "x"], [2, "y"]])),
+        );
+        static_arrays.insert(
+            "/$table/properties/plan/rows/1/b".to_string(),
+            Arc::new(json!([true])),
+        );
+        static_arrays.insert("/$params/missing".to_string(), Arc::new(json!([0])));
+
+        for without_params in [false, true] {
+            let view = EvaluatedSchemaView::new(&schema, &static_arrays, without_params);
+            let expected = resolved_copy(&schema, &static_arrays, without_params);
+            assert_eq!(view.to_value(), expected);
+            assert_eq!(
+                serde_json::to_vec(&view).unwrap(),
+                serde_json::to_vec(&expected).unwrap()
+            );
+            assert_eq!(
+                rmp_serde::to_vec(&view).unwrap(),
+                rmp_serde::to_vec(&expected).unwrap()
+            );
+        }
+    }
+}
@@ -0,0 +1,195 @@
+//! Incremental data updates.
+//!
+//! `set_values` applies field patches (data path → value) to the current form data
+//! in place. Only the patched subtrees are compared and version-bumped, so a single
+//! keystroke costs O(change) instead of the parse + clone + whole-tree diff that a
+//! full `evaluate(data)` call performs.
+
+use super::JSONEval;
+use crate::jsoneval::cancellation::CancellationToken;
+use crate::jsoneval::eval_data::EvalData;
+use crate::jsoneval::json_parser;
+use crate::jsoneval::path_utils;
+use crate::time_block;
+
+use serde_json::Value;
+
+/// Decode patches given either as an object `{ "path": value, ... }` or as an
+/// array of `[path, value]` pairs (applied in order).
+pub fn patches_from_value(value: Value) -> Result<Vec<(String, Value)>, String> {
+    match value {
+        Value::Object(map) => Ok(map.into_iter().collect()),
+        Value::Array(items) => items
+            .into_iter()
+            .map(|item| match item {
+                Value::Array(pair) if pair.len() == 2 => {
+                    let mut pair = pair.into_iter();
+                    match (pair.next(), pair.next()) {
+                        (Some(Value::String(path)), Some(value)) => Ok((path, value)),
+                        _ => Err("Patch path must be a string".to_string()),
+                    }
+                }
+                _ => Err("Patch array entries must be [path, value] pairs".to_string()),
+            })
+            .collect(),
+        _ => Err(
+            "Patches must be an object of path -> value or an array of [path, value] pairs"
+                .to_string(),
+        ),
+    }
+}
+
+/// Whether `pointer` equals `ancestor` or lies below it
+#[inline]
+fn pointer_within(pointer: &str, ancestor: &str) -> bool {
+    pointer
+        .strip_prefix(ancestor)
+        .is_some_and(|rest| rest.is_empty() || rest.starts_with('/'))
+}
+
+impl JSONEval {
+    /// Apply field patches to the current data and re-evaluate.
+    ///
+    /// Paths accept dotted notation or JSON pointers (`user.name`, `/user/name`);
+    /// `$context` paths update the context. `$params` cannot be patched.
+    /// Patches whose value is unchanged are skipped; if nothing changed, no
+    /// evaluation runs.
+    ///
+    /// # Arguments
+    ///
+    /// * `patches` - `(path, value)` pairs applied in order.
+    /// * `token` - Optional cancellation token.
+    pub fn set_values(
+        &mut self,
+        patches: Vec<(String, Value)>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        if let Some(t) = token {
+            if t.is_cancelled() {
+                return Err("Cancelled".to_string());
+            }
+        }
+        self.invalidate_outputs();
+        time_block!("set_values() [total]", {
+            let pointers = patches
+                .iter()
+                .map(|(path, _)| {
+                    let pointer = path_utils::normalize_to_json_pointer(path).into_owned();
+                    if pointer.is_empty() || pointer_within(&pointer, "/$params") {
+                        Err(format!("set_values cannot patch '{}'", path))
+                    } else {
+                        Ok(pointer)
+                    }
+                })
+                .collect::<Result<Vec<_>, String>>()?;
+
+            // Old values come from the last diffed payload. Afterwards the snapshot is
+            // re-taken from the patched data, so a later full `evaluate()` diffs against
+            // the patched state rather than re-bumping these paths.
+            let snapshot = self
+                .eval_cache
+                .main_form_snapshot
+                .take()
+                .unwrap_or_else(|| self.eval_data.snapshot_data());
+
+            // Subform arrays touched by a patch: (schema path, data pointer, items before patching)
+            let mut touched: Vec<(String, String, Option<Vec<Value>>)> = Vec::new();
+            let mut changed = false;
+
+            for (i, ((_, value), pointer)) in patches.into_iter().zip(&pointers).enumerate() {
+                // A path already patched in this batch diffs against its patched value
+                let patched_before = pointers[..i]
+                    .iter()
+                    .any(|p| pointer_within(pointer, p) || pointer_within(p, pointer));
+                let base = if patched_before {
+                    self.eval_data.data()
+                } else {
+                    &*snapshot
+                };
+                let old = base.pointer(pointer).cloned().unwrap_or(Value::Null);
+                if old == value {
+                    continue;
+                }
+
+                for subform_path in self.subforms.keys() {
+                    let subform_ptr = path_utils::schema_path_to_data_pointer(subform_path);
+                    let overlaps = pointer_within(pointer, &subform_ptr)
+                        || pointer_within(&subform_ptr, pointer);
+                    if overlaps && !touched.iter().any(|(path, _, _)| path == subform_path) {
+                        let items = base
+                            .pointer(&subform_ptr)
+                            .and_then(Value::as_array)
+                            .cloned();
+                        touched.push((subform_path.clone(), subform_ptr.into_owned(), items));
+                    }
+                }
+
+                // Replacing a container drops whatever earlier passes wrote below it
+                if self
+                    .eval_data
+                    .data()
+                    .pointer(pointer)
+                    .is_some_and(|current| current.is_object() || current.is_array())
+                {
+                    self.eval_cache.invalidate_clean_baseline();
+                }
+
+                self.eval_cache.diff_versions_at(pointer, &old, &value);
+                match pointer.strip_prefix("/$context") {
+                    Some("") => self.context = value.clone(),
+                    Some(rest) if rest.starts_with('/') => {
+                        EvalData::set_by_pointer(&mut self.context, rest, value.clone())
+                    }
+                    _ => EvalData::set_by_pointer(&mut self.data, pointer, value.clone()),
+                }
+                self.eval_data.set(pointer, value);
+                changed = true;
+            }
+
+            if !changed {
+                self.eval_cache.main_form_snapshot = Some(snapshot);
+                return Ok(());
+            }
+
+            drop(snapshot);
+            let new_data = self.eval_data.snapshot_data();
+            for (subform_path, subform_ptr, old_items) in &touched {
+                let new_items = new_data.pointer(subform_ptr).and_then(Value::as_array);
+
+                // Seed per-item snapshots the same way `evaluate()` does for loaded data
+                for (idx, item_val) in new_items.into_iter().flatten().enumerate() {
+                    self.eval_cache.seed_item_snapshot(idx, item_val);
+                    if let Some(subform) = self.subforms.get_mut(subform_path) {
+                        subform.eval_cache.seed_item_snapshot(idx, item_val);
+                    }
+                }
+
+                self.invalidate_subform_items(subform_ptr, old_items.as_ref(), new_items);
+            }
+
+            self.eval_cache.main_form_snapshot = Some(new_data);
+            self.evaluate_after_data_change(None, token)
+        })
+    }
+
+    /// `set_values` with patches encoded as JSON (see [`patches_from_value`])
+    pub fn set_values_json(
+        &mut self,
+        patches: &str,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        let value = time_block!("  parse patches", { json_parser::parse_json_str(patches)? });
+        self.set_values(patches_from_value(value)?, token)
+    }
+
+    /// `set_values` with patches encoded as MessagePack (see [`patches_from_value`])
+    pub fn set_values_msgpack(
+        &mut self,
+        patches: &[u8],
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        let value: Value = rmp_serde::from_slice(patches)
+            .map_err(|e| format!("Failed to deserialize MessagePack patches: {}", e))?;
+        self.set_values(patches_from_value(value)?, token)
+    }
+}
@@ -2,6 +2,7 @@
 
 use super::JSONEval;
 use crate::jsoneval::cancellation::CancellationToken;
+use crate::jsoneval::eval_cache::EvalCache;
 use crate::jsoneval::eval_data::EvalData;
 use crate::jsoneval::types::{ResolvedLayoutResult, ReturnFormat};
 use serde_json::Value;
@@ -133,17 +134,56 @@ impl JSONEval {
     ///
     /// This ensures all three operations (evaluate / validate / evaluate_dependents)
     /// share parent-form Tier-2 cache entries, without duplicating the swap boilerplate.
-    fn with_item_cache_swap<F, T>(
+    pub(crate) fn with_item_cache_swap<F, T>(
         &mut self,
         base_path: &str,
         idx: usize,
-        data_value: Value,
-        context_value: Value,
+        data_value: &Value,
+        context_value: &Value,
         f: F,
     ) -> Result<T, String>
     where
         F: FnOnce(&mut JSONEval) -> Result<T, String>,
     {
+        let mut parent_cache = self.begin_item_scope(base_path, idx, data_value, context_value)?;
+
+        // Step 3: swap parent cache into subform so Tier 1 + Tier 2 entries are visible.
+        {
+            let subform = self.subforms.get_mut(base_path).unwrap();
+            std::mem::swap(&mut subform.eval_cache, &mut parent_cache);
+        }
+
+        // Step 4: run the caller-supplied operation.
+        let result = {
+            let subform = self.subforms.get_mut(base_path).unwrap();
+            f(subform)
+        };
+
+        // Step 5: restore parent cache.
+        {
+            let subform = self.subforms.get_mut(base_path).unwrap();
+            std::mem::swap(&mut subform.eval_cache, &mut parent_cache);
+        }
+        parent_cache.active_item_index = None;
+        self.eval_cache = parent_cache;
+
+        self.finish_item_scope(base_path, idx);
+
+        result
+    }
+
+    /// Steps 1–2 of [`with_item_cache_swap`](Self::with_item_cache_swap): scope the
+    /// subform's data to item `idx` and prepare the parent cache for it.
+    ///
+    /// On success the parent cache is returned with `active_item_index = Some(idx)`;
+    /// `self.eval_cache` stays empty until the caller puts it back.
+    pub(crate) fn begin_item_scope(
+        &mut self,
+        base_path: &str,
+        idx: usize,
+        data_value: &Value,
+        context_value: &Value,
+    ) -> Result<EvalCache, String> {
         let original_field_key = base_path
             .split('/')
             .next_back()
@@ -207,12 +247,12 @@ impl JSONEval {
 
             // Retain parent evaluator's schema-owned `$params`, then merge a full
             // payload's parent fields over it. Item wrappers supply only active item.
-            let mut scoped_data = EvalData::new(self.eval_data.snapshot_data_clone());
+            let mut scoped_data = EvalData::from_arc(self.eval_data.snapshot_data());
             if full_parent_payload || payload_has_parent_context {
                 scoped_data.replace_data_and_context(data_value.clone(), context_value.clone());
             }
             scoped_data.set(&item_path, normalized_item.clone());
-            let canonical_parent = scoped_data.snapshot_data_clone();
+            let canonical_parent = scoped_data.snapshot_data();
             let scope = crate::jsoneval::subform_scope::SubformScope::new(
                 base_path,
                 &array_path,
@@ -252,10 +292,12 @@ impl JSONEval {
 
         let mut parent_cache = std::mem::take(&mut self.eval_cache);
         if full_parent_payload {
-            let old_parent_data = self.eval_data.snapshot_data_clone();
+            // Parent getters read eval_data, so their cached outputs go stale here
+            self.invalidate_outputs();
+            let old_parent_data = self.eval_data.snapshot_data();
             self.eval_data
                 .replace_data_and_context(data_value.clone(), context_value.clone());
-            let new_parent_data = self.eval_data.snapshot_data_clone();
+            let new_parent_data = self.eval_data.snapshot_data();
             crate::jsoneval::eval_cache::diff_and_update_versions(
                 &mut parent_cache.data_versions,
                 "",
@@ -271,7 +313,7 @@ impl JSONEval {
             // `/riders/...`; merging parent versions invalidates parent-driven conditions without
             // cross-item contamination. Item-local bumps remain isolated under `/riders/...`.
             c.data_versions
-                .merge_excluding_prefix(&parent_cache.data_versions, &format!("/{root_key}/"));
+                .merge_excluding_subtree(&parent_cache.data_versions, &format!("/{root_key}"));
             c.data_versions
                 .merge_from_params(&parent_cache.params_versions);
 
@@ -285,7 +327,7 @@ impl JSONEval {
         }
 
         // Snapshot item versions BEFORE the diff so we can detect only NEW bumps below.
-        // `any_bumped_with_prefix(v > 0)` would return true for historical bumps from prior
+        // `any_bumped_under(v > 0)` would return true for historical bumps from prior
         // calls, causing invalidate_params_tables_for_item to fire on every evaluate_subform
         // even when no rider data actually changed.
         let pre_diff_item_versions = parent_cache
@@ -318,22 +360,18 @@ impl JSONEval {
         // This prevents the regression where run_subform_pass sees stale per-rider bumps
         // and erroneously re-evaluates expensive tables (RIDER_ZLOB_TABLE etc.) for every rider.
         {
-            let item_field_prefix = format!("/{}/", root_key);
             if let (Some(ref pre), Some(c)) = (
                 &pre_diff_item_versions,
                 parent_cache.subform_caches.get(&idx),
             ) {
-                let newly_bumped: Vec<String> = c
+                let newly_bumped = c
                     .data_versions
-                    .versions()
-                    .filter(|(k, &v)| k.starts_with(&item_field_prefix) && v > pre.get(k))
-                    .map(|(k, _)| k.to_string())
-                    .collect();
+                    .newly_bumped_under(&format!("/{}", root_key), pre);
                 if !newly_bumped.is_empty() {
-                    for k in newly_bumped {
+                    for (id, _) in newly_bumped {
                         parent_cache
                             .data_versions
-                            .bump(&k, "propagate_newly_bumped");
+                            .bump_id(id, "propagate_newly_bumped");
                     }
                     parent_cache.eval_generation += 1;
                 }
@@ -364,11 +402,11 @@ impl JSONEval {
                         continue;
                     }
                     // Validate all dep versions against the current item data_versions.
-                    let still_valid = v.dep_versions.iter().all(|(dep_path, &cached_ver)| {
-                        let current_ver = if dep_path.starts_with("/$params") {
-                            parent_cache.params_versions.get(dep_path)
+                    let still_valid = v.dep_versions.iter().all(|&(dep, cached_ver)| {
+                        let current_ver = if dep.is_params() {
+                            parent_cache.params_versions.get_id(dep)
                         } else {
-                            current_dv.get(dep_path)
+                            current_dv.get_id(dep)
                         };
                         current_ver == cached_ver
                     });
@@ -384,6 +422,7 @@ impl JSONEval {
         // version increments on repeated evaluate_subform calls where the rider data is unchanged.
         let current_at_item_path = self.eval_data.get(&item_path).cloned();
         if current_at_item_path.as_ref() != Some(&new_item_val) {
+            self.invalidate_outputs();
             self.eval_data.set(&item_path, new_item_val.clone());
             if is_new_item {
                 parent_cache.bump_data_version(&array_path);
@@ -397,16 +436,16 @@ impl JSONEval {
         // formula evaluation runs (otherwise cached old rows are reused).
         //
         // Gate: only re-evaluate tables when at least one item-level path was NEWLY bumped
-        // in this diff pass. Using any_bumped_with_prefix(v > 0) would return true for
+        // in this diff pass. Using any_bumped_under(v > 0) would return true for
         // historical bumps from prior calls, causing spurious table invalidation every time.
-        let field_prefix = format!("/{}/", root_key);
+        let item_root = format!("/{}", root_key);
         let item_paths_bumped = match &pre_diff_item_versions {
             None => {
                 // No pre-diff snapshot = cache slot was just created, treat as new
                 parent_cache
                     .subform_caches
                     .get(&idx)
-                    .map(|c| c.data_versions.any_bumped_with_prefix(&field_prefix))
+                    .map(|c| c.data_versions.any_bumped_under(&item_root))
                     .unwrap_or(false)
             }
             Some(pre) => {
@@ -414,10 +453,7 @@ impl JSONEval {
                 parent_cache
                     .subform_caches
                     .get(&idx)
-                    .map(|c| {
-                        c.data_versions
-                            .any_newly_bumped_with_prefix(&field_prefix, pre)
-                    })
+                    .map(|c| c.data_versions.any_newly_bumped_under(&item_root, pre))
                     .unwrap_or(false)
             }
         };
@@ -433,12 +469,12 @@ impl JSONEval {
                 let paths = pre_diff_item_versions.as_ref().and_then(|pre| {
                     parent_cache.subform_caches.get(&idx).map(|c| {
                         c.data_versions
-                            .versions()
-                            .filter(|(k, &v)| k.starts_with(&field_prefix) && v > pre.get(k))
-                            .map(|(k, _)| {
+                            .newly_bumped_under(&item_root, pre)
+                            .into_iter()
+                            .map(|(_, k)| {
                                 // Convert data-version path (e.g. /riders/wop_rider_premi) to schema dep
                                 // format (e.g. #/riders/properties/wop_rider_premi) for dep matching.
-                                let sub = k.trim_start_matches(&field_prefix);
+                                let sub = &k[item_root.len() + 1..];
                                 format!("#/{}/properties/{}", root_key, sub)
                             })
                             .collect::<Vec<_>>()
@@ -535,26 +571,12 @@ impl JSONEval {
             }
         }
 
-        // Step 3: swap parent cache into subform so Tier 1 + Tier 2 entries are visible.
-        {
-            let subform = self.subforms.get_mut(base_path).unwrap();
-            std::mem::swap(&mut subform.eval_cache, &mut parent_cache);
-        }
-
-        // Step 4: run the caller-supplied operation.
-        let result = {
-            let subform = self.subforms.get_mut(base_path).unwrap();
-            f(subform)
-        };
-
-        // Step 5: restore parent cache.
-        {
-            let subform = self.subforms.get_mut(base_path).unwrap();
-            std::mem::swap(&mut subform.eval_cache, &mut parent_cache);
-        }
-        parent_cache.active_item_index = None;
-        self.eval_cache = parent_cache;
+        Ok(parent_cache)
+    }
 
+    /// Step 6 of [`with_item_cache_swap`](Self::with_item_cache_swap), run once the
+    /// parent cache is back in `self.eval_cache`.
+    pub(crate) fn finish_item_scope(&mut self, base_path: &str, idx: usize) {
         // Step 6: persist the updated T1 item cache (snapshot + entries) back into the subform's
         // own per-item cache. Without this, the next evaluate_subform call for the same idx reads
         // old_item_snapshot = Null from the subform cache (it was removed at line 183) and treats
@@ -571,8 +593,6 @@ impl JSONEval {
                     .insert(idx, item_cache.clone());
             }
         }
-
-        result
     }
 
     /// Evaluate a subform identified by `subform_path`.
@@ -625,17 +645,26 @@ impl JSONEval {
             Value::Object(serde_json::Map::new())
         };
 
-        self.with_item_cache_swap(base_path, idx, data_value, context_value, |sf| {
-            // Match main-form lifecycle: resolve visibility, hydrate missing visible static
-            // defaults and their dependents, then re-evaluate only when data was written.
-            sf.evaluate_internal_pre_diffed(paths, token)?;
-            if sf.apply_visible_static_defaults_with_dependents(token)? {
-                sf.evaluate_internal_pre_diffed(paths, token)?;
-            }
-            Ok(())
+        self.with_item_cache_swap(base_path, idx, &data_value, &context_value, |sf| {
+            sf.evaluate_scoped_item(paths, token)
         })
     }
 
+    /// Evaluate a subform already scoped to one item (data set, cache swapped in).
+    pub(crate) fn evaluate_scoped_item(
+        &mut self,
+        paths: Option<&[String]>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        // Match main-form lifecycle: resolve visibility, hydrate missing visible static
+        // defaults and their dependents, then re-evaluate only when data was written.
+        self.evaluate_internal_pre_diffed(paths, token)?;
+        if self.apply_visible_static_defaults_with_dependents(token)? {
+            self.evaluate_internal_pre_diffed(paths, token)?;
+        }
+        Ok(())
+    }
+
     /// Validate subform data against its schema rules.
     ///
     /// Supports the same trailing-index path syntax as `evaluate_subform`. When an index
@@ -663,8 +692,8 @@ impl JSONEval {
             self.with_item_cache_swap(
                 base_path.as_ref(),
                 idx,
-                data_value,
-                context_value,
+                &data_value,
+                &context_value,
                 move |sf| {
                     // Warm the evaluation cache before running rule checks.
                     sf.evaluate_internal_pre_diffed(paths, token)?;
@@ -721,8 +750,8 @@ impl JSONEval {
             let changes = self.with_item_cache_swap(
                 base_path.as_ref(),
                 idx,
-                data_value,
-                context_value,
+                &data_value,
+                &context_value,
                 |sf| {
                     // Data is already set by with_item_cache_swap; pass None to avoid re-parsing.
                     sf.evaluate_dependents(
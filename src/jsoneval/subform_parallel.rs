@@ -0,0 +1,226 @@
+//! Parallel evaluation of subform items.
+//!
+//! `evaluate_subform("riders.N", ...)` evaluates one item on the shared subform
+//! evaluator, swapping the item's cache state in and out of it.
+//! [`JSONEval::evaluate_subform_items`] evaluates every item of a subform array,
+//! each on its own item evaluator. Schema, compiled logic and tables are shared
+//! through their `Arc`s, and the item's scoped data is shared copy-on-write. What
+//! each item does own is a fresh `evaluated_schema`: one copy of the subform
+//! schema per item, the same copy a newly built subform starts from. Nested
+//! subforms, payload fields and the subform's own caches are not copied.
+//!
+//! 1. Item scopes are set up on the parent one after another, exactly as for a
+//!    single item, and each item takes a fork of the parent cache. Forks share
+//!    the parent's Tier-2 entries and version counters instead of copying them.
+//! 2. Items evaluate on worker threads.
+//! 3. Forks are joined back in item order, so per-item caches and Tier-2
+//!    `$params` entries end up as a serial pass over the items would leave them.
+//!    Version counters add up every item's bumps, which can leave them ahead of a
+//!    serial pass (a later miss) but never on a version that meant another value.
+
+use std::cell::Cell;
+
+use once_cell::sync::Lazy;
+use serde_json::Value;
+
+use super::JSONEval;
+use crate::jsoneval::cancellation::CancellationToken;
+use crate::jsoneval::eval_cache::EvalCache;
+use crate::jsoneval::worker_guard;
+use crate::jsoneval::{json_parser, path_utils};
+use crate::time_block;
+
+/// Upper bound on worker threads for subform items.
+///
+/// Defaults to the available parallelism; `JSONEVAL_SUBFORM_THREADS` overrides it
+/// (`1` evaluates items one after another).
+static SUBFORM_WORKER_LIMIT: Lazy<usize> = Lazy::new(|| {
+    std::env::var("JSONEVAL_SUBFORM_THREADS")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .filter(|&n| n > 0)
+        .unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+});
+
+thread_local! {
+    /// Worker limit forced on this thread by [`with_subform_workers`]
+    static SUBFORM_WORKER_OVERRIDE: Cell<Option<usize>> = const { Cell::new(None) };
+}
+
+/// Run `f` with subform items limited to `workers` threads on this thread,
+/// regardless of `JSONEVAL_SUBFORM_THREADS` and the host core count. `1`
+/// evaluates items one after another. Lets tests compare both paths.
+#[doc(hidden)]
+pub fn with_subform_workers<R>(workers: usize, f: impl FnOnce() -> R) -> R {
+    let previous = SUBFORM_WORKER_OVERRIDE.with(|limit| limit.replace(Some(workers.max(1))));
+    let result = f();
+    SUBFORM_WORKER_OVERRIDE.with(|limit| limit.set(previous));
+    result
+}
+
+/// Number of workers for `items` subform items. Each item is a full evaluation,
+/// so one item is enough work for a thread. Items of a subform evaluated on a
+/// worker thread run serially.
+#[inline]
+fn parallel_item_workers(items: usize) -> usize {
+    if cfg!(target_arch = "wasm32") || worker_guard::in_eval_worker() {
+        return 1;
+    }
+    let limit = SUBFORM_WORKER_OVERRIDE
+        .with(Cell::get)
+        .unwrap_or(*SUBFORM_WORKER_LIMIT);
+    items.min(limit)
+}
+
+impl JSONEval {
+    /// Evaluate every item of the subform array at `subform_path`, on worker threads
+    /// when there is more than one item and more than one core.
+    ///
+    /// `data` is the full parent payload holding the array. The outcome matches
+    /// calling [`evaluate_subform`](Self::evaluate_subform) with `"<path>.<i>"` for
+    /// each item in order, and the subform is left scoped to the last item.
+    ///
+    /// The subform cascade in `evaluate_dependents` still walks items one at a
+    /// time: it diffs each item against its previous values and collects the
+    /// changes per item, which this entry point does not report.
+    pub fn evaluate_subform_items(
+        &mut self,
+        subform_path: &str,
+        data: &str,
+        context: Option<&str>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(), String> {
+        if let Some(t) = token {
+            if t.is_cancelled() {
+                return Err("Cancelled".to_string());
+            }
+        }
+        let (base_path, _) = self.resolve_subform_path_alias(subform_path);
+        if !self.subforms.contains_key(&base_path) {
+            return Err(format!("Subform not found: {}", base_path));
+        }
+
+        let data_value = json_parser::parse_json_str(data)
+            .map_err(|e| format!("Failed to parse subform data: {}", e))?;
+        let context_value = if let Some(ctx) = context {
+            json_parser::parse_json_str(ctx)
+                .map_err(|e| format!("Failed to parse subform context: {}", e))?
+        } else {
+            Value::Object(serde_json::Map::new())
+        };
+
+        let array_path = path_utils::schema_path_to_data_pointer(&base_path).into_owned();
+        let item_count = data_value
+            .pointer(&array_path)
+            .and_then(Value::as_array)
+            .map_or(0, Vec::len);
+
+        let workers = parallel_item_workers(item_count);
+        if workers <= 1 {
+            for idx in 0..item_count {
+                self.with_item_cache_swap(&base_path, idx, &data_value, &context_value, |sf| {
+                    sf.evaluate_scoped_item(None, token)
+                })?;
+            }
+            return Ok(());
+        }
+
+        time_block!("evaluate_subform_items() [parallel]", {
+            // Phase 1: scope each item on the parent and fork its cache
+            let mut items: Vec<(usize, JSONEval)> = Vec::with_capacity(item_count);
+            for idx in 0..item_count {
+                let mut parent_cache =
+                    self.begin_item_scope(&base_path, idx, &data_value, &context_value)?;
+                let fork = parent_cache.fork_item(idx);
+                parent_cache.active_item_index = None;
+                self.eval_cache = parent_cache;
+                items.push((idx, self.item_worker(&base_path, fork)));
+            }
+
+            // Phase 2: evaluate the items on worker threads
+            let chunk_size = item_count.div_ceil(workers);
+            let results: Vec<Result<(), String>> = std::thread::scope(|s| {
+                let handles: Vec<_> = items
+                    .chunks_mut(chunk_size)
+                    .map(|chunk| {
+                        let len = chunk.len();
+                        let handle = s.spawn(move || {
+                            worker_guard::enter_eval_worker();
+                            chunk
+                                .iter_mut()
+                                .map(|(_, worker)| worker.evaluate_scoped_item(None, token))
+                                .collect::<Vec<_>>()
+                        });
+                        (handle, len)
+                    })
+                    .collect();
+                handles
+                    .into_iter()
+                    .flat_map(|(handle, len)| {
+                        handle.join().unwrap_or_else(|_| {
+                            vec![Err("Subform item worker panicked".to_string()); len]
+                        })
+                    })
+                    .collect()
+            });
+
+            // Phase 3: join in item order, stopping at the first failed item as a
+            // serial pass would. Every fork lets go of the parent's global entries
+            // first, so joining updates them in place.
+            for (_, worker) in items.iter_mut() {
+                worker.eval_cache.release_fork_base();
+            }
+            for ((idx, mut worker), result) in items.into_iter().zip(results) {
+                self.eval_cache
+                    .join_item(idx, std::mem::take(&mut worker.eval_cache));
+
+                // The worker holds the item's evaluated state and takes the shared
+                // subform's place, keeping the subform's own cache, generation,
+                // nested subforms and payload fields
+                let subform = self.subforms.get_mut(&base_path).unwrap();
+                worker.eval_cache = std::mem::take(&mut subform.eval_cache);
+                worker.output_cache = std::mem::take(&mut subform.output_cache);
+                worker.subforms = std::mem::take(&mut subform.subforms);
+                worker.data = std::mem::take(&mut subform.data);
+                worker.context = std::mem::take(&mut subform.context);
+                worker.invalidate_outputs();
+                **subform = worker;
+
+                self.finish_item_scope(&base_path, idx);
+                result?;
+            }
+            Ok(())
+        })
+    }
+
+    /// Evaluator for one item of the subform at `base_path`, with `cache` as its
+    /// cache. It shares the subform's compiled parts and item-scoped data and
+    /// starts from a fresh copy of the schema. Parts the item evaluation does not
+    /// use are moved aside while the subform is cloned, so they are not copied.
+    fn item_worker(&mut self, base_path: &str, cache: EvalCache) -> JSONEval {
+        let subform = self.subforms.get_mut(base_path).unwrap();
+        let own_cache = std::mem::take(&mut subform.eval_cache);
+        let nested = std::mem::take(&mut subform.subforms);
+        let evaluated_schema = std::mem::take(&mut subform.evaluated_schema);
+        let cached_msgpack_schema = subform.cached_msgpack_schema.take();
+        let data = std::mem::take(&mut subform.data);
+        let context = std::mem::take(&mut subform.context);
+
+        let mut worker = (**subform).clone();
+
+        subform.eval_cache = own_cache;
+        subform.subforms = nested;
+        subform.evaluated_schema = evaluated_schema;
+        subform.cached_msgpack_schema = cached_msgpack_schema;
+        subform.data = data;
+        subform.context = context;
+
+        worker.eval_cache = cache;
+        worker.evaluated_schema = (*worker.schema).clone();
+        worker
+    }
+}
@@ -1,13 +1,130 @@
 use crate::jsoneval::eval_data::EvalData;
+use crate::jsoneval::path_id::PathIds;
 use crate::jsoneval::path_utils;
-use crate::jsoneval::table_metadata::RowMetadata;
+use crate::jsoneval::table_metadata::{ColumnMetadata, RowMetadata};
+use crate::jsoneval::worker_guard;
 use crate::time_block;
 use crate::JSONEval;
+use crate::RLogic;
+use once_cell::sync::Lazy;
 use serde_json::{Map, Value};
+use std::cell::Cell;
 use std::collections::{HashMap, HashSet};
 
 use crate::jsoneval::cancellation::CancellationToken;
 
+/// Minimum number of rows each worker must receive before a row-independent
+/// `$repeat` block is split across threads. Smaller blocks stay sequential —
+/// thread spawn cost outweighs the per-row evaluation work.
+const PARALLEL_ROWS_PER_WORKER: usize = 128;
+
+/// Upper bound on worker threads for the parallel row pass.
+///
+/// Defaults to the available parallelism; `JSONEVAL_TABLE_THREADS` overrides it
+/// (`1` disables the parallel pass).
+static TABLE_WORKER_LIMIT: Lazy<usize> = Lazy::new(|| {
+    std::env::var("JSONEVAL_TABLE_THREADS")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .filter(|&n| n > 0)
+        .unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+});
+
+thread_local! {
+    /// Worker limit forced on this thread by [`with_table_workers`]
+    static TABLE_WORKER_OVERRIDE: Cell<Option<usize>> = const { Cell::new(None) };
+}
+
+/// Run `f` with the parallel row pass limited to `workers` threads on this
+/// thread, regardless of `JSONEVAL_TABLE_THREADS` and the host core count.
+/// `1` forces the sequential pass. Lets tests compare both paths.
+#[doc(hidden)]
+pub fn with_table_workers<R>(workers: usize, f: impl FnOnce() -> R) -> R {
+    let previous = TABLE_WORKER_OVERRIDE.with(|limit| limit.replace(Some(workers.max(1))));
+    let result = f();
+    TABLE_WORKER_OVERRIDE.with(|limit| limit.set(previous));
+    result
+}
+
+/// Number of workers to use for a row-independent block of `total_rows` rows.
+/// Tables evaluated on a worker thread run sequentially.
+#[inline]
+fn parallel_row_workers(total_rows: usize) -> usize {
+    if cfg!(target_arch = "wasm32") || worker_guard::in_eval_worker() {
+        return 1;
+    }
+    let limit = TABLE_WORKER_OVERRIDE
+        .with(Cell::get)
+        .unwrap_or(*TABLE_WORKER_LIMIT);
+    (total_rows / PARALLEL_ROWS_PER_WORKER).min(limit)
+}
+
+/// Evaluate `normal_cols` for one contiguous chunk of `$repeat` rows.
+///
+/// Used by the parallel row pass: each worker owns its `rows` chunk and enters
+/// its own (thread-local) table scope, so `$column` lookups resolve against the
+/// row currently being evaluated exactly as in the sequential forward pass.
+#[allow(clippy::too_many_arguments)]
+fn evaluate_repeat_chunk(
+    engine: &RLogic,
+    table_pointer_path: &str,
+    columns: &[ColumnMetadata],
+    normal_cols: &[usize],
+    user_data: &Value,
+    base_ctx: &Map<String, Value>,
+    first_iteration: i64,
+    rows: &mut Vec<Value>,
+    token: Option<&CancellationToken>,
+) -> Result<(), String> {
+    let _scope_guard = engine.enter_table_scope(table_pointer_path.to_string(), rows);
+    let key_iteration = "$iteration";
+    let mut ctx_value = Value::Object(base_ctx.clone());
+
+    for row_idx in 0..rows.len() {
+        if let Some(t) = token {
+            if t.is_cancelled() {
+                return Err("Cancelled".to_string());
+            }
+        }
+
+        if let Value::Object(ref mut map) = ctx_value {
+            if let Some(slot) = map.get_mut(key_iteration) {
+                *slot = Value::from(first_iteration + row_idx as i64);
+            }
+        }
+
+        engine.update_table_scope_rows(rows);
+        engine.set_table_scope_row(Some(row_idx));
+
+        for &col_idx in normal_cols.iter() {
+            let column = &columns[col_idx];
+            let value = match column.logic {
+                Some(logic_id) => engine
+                    .run_with_context(&logic_id, user_data, &ctx_value)
+                    .unwrap_or(Value::Null),
+                None => column
+                    .literal
+                    .as_ref()
+                    .map(|arc_val| Value::clone(arc_val))
+                    .unwrap_or(Value::Null),
+            };
+
+            if let Value::Object(ref mut row) = rows[row_idx] {
+                if let Some(cell) = row.get_mut(column.name.as_ref()) {
+                    *cell = value;
+                }
+            }
+        }
+        engine.set_table_scope_row(None);
+    }
+
+    Ok(())
+}
+
 /// Zero-sandbox table evaluation
 ///
 /// Eliminates the full `EvalData` clone (sandbox) by:
@@ -26,7 +143,7 @@ pub fn evaluate_table(
     eval_key: &str,
     scope_data: &EvalData,
     token: Option<&CancellationToken>,
-) -> Result<(Vec<Value>, Option<indexmap::IndexSet<String>>), String> {
+) -> Result<(Vec<Value>, Option<PathIds>), String> {
     let _total_start: Option<std::time::Instant> = if crate::utils::is_timing_enabled() {
         Some(std::time::Instant::now())
     } else {
@@ -44,7 +161,7 @@ fn evaluate_table_inner(
     eval_key: &str,
     scope_data: &EvalData,
     token: Option<&CancellationToken>,
-) -> Result<(Vec<Value>, Option<indexmap::IndexSet<String>>), String> {
+) -> Result<(Vec<Value>, Option<PathIds>), String> {
     let metadata = lib
         .table_metadata
         .get(eval_key)
@@ -91,12 +208,13 @@ fn evaluate_table_inner(
         }
     });
 
-    let mut external_deps = indexmap::IndexSet::new();
+    let mut external_deps = PathIds::new();
     let pointer_data_prefix =
         crate::jsoneval::path_utils::schema_path_to_data_pointer(&table_pointer_path).into_owned();
     let pointer_data_prefix_slash = format!("{}/", pointer_data_prefix);
     if let Some(deps) = lib.dependencies.get(eval_key) {
-        for dep in deps {
+        let dep_ids = lib.dependency_ids.of(eval_key);
+        for (dep, &dep_id) in deps.iter().zip(dep_ids) {
             let is_params_dep = dep.contains("$params");
             let is_other_system_dep = !is_params_dep
                 && !dep.contains("$context")
@@ -110,7 +228,7 @@ fn evaluate_table_inner(
             if dep_data_path != pointer_data_prefix
                 && !dep_data_path.starts_with(&pointer_data_prefix_slash)
             {
-                external_deps.insert(dep.clone());
+                external_deps.push(dep_id);
             }
         }
     }
@@ -201,7 +319,11 @@ fn evaluate_table_inner(
 
     if should_clear || should_skip || requirement_not_filled {
         if crate::utils::is_debug_cache_enabled() {
-            println!("Table Cache MISS [table::{}] should_clear={}, should_skip={}, requirement_not_filled={} (external_deps={:?})", eval_key, should_clear, should_skip, requirement_not_filled, external_deps);
+            let external_paths: Vec<_> = external_deps
+                .iter()
+                .map(|&dep| lib.eval_cache.paths().path(dep))
+                .collect();
+            println!("Table Cache MISS [table::{}] should_clear={}, should_skip={}, requirement_not_filled={} (external_deps={:?})", eval_key, should_clear, should_skip, requirement_not_filled, external_paths);
         }
         return Ok((Vec::new(), Some(external_deps)));
     }
@@ -256,6 +378,7 @@ fn evaluate_table_inner(
                 columns,
                 forward_cols,
                 normal_cols,
+                row_independent,
             } => {
                 let empty_ctx = Value::Object(data_ctx.clone());
 
@@ -321,6 +444,78 @@ fn evaluate_table_inner(
                     local_rows.push(Value::Object(row));
                 }
 
+                // PHASE 4 (parallel): rows only read their own cells, so the block
+                // is split into contiguous chunks evaluated on scoped worker threads.
+                let workers = if *row_independent {
+                    parallel_row_workers(total_rows)
+                } else {
+                    1
+                };
+                if workers > 1 {
+                    time_block!(
+                        &format!(
+                            "[table::{}] parallel-pass rows={} workers={}",
+                            eval_key, total_rows, workers
+                        ),
+                        {
+                            let chunk_len = total_rows.div_ceil(workers);
+                            let mut tail = local_rows.split_off(existing_row_count);
+                            let mut chunks: Vec<Vec<Value>> = Vec::with_capacity(workers);
+                            while tail.len() > chunk_len {
+                                let rest = tail.split_off(chunk_len);
+                                chunks.push(std::mem::replace(&mut tail, rest));
+                            }
+                            chunks.push(tail);
+
+                            let mut base_ctx = data_ctx.clone();
+                            base_ctx.insert("$threshold".to_string(), Value::from(end_idx));
+                            base_ctx.insert("$iteration".to_string(), Value::Null);
+
+                            let engine: &RLogic = &lib.engine;
+                            let user_data = scope_data.data();
+                            let results: Vec<Result<(), String>> = std::thread::scope(|s| {
+                                let mut handles = Vec::with_capacity(chunks.len());
+                                let mut first_iteration = start_idx;
+                                for chunk in chunks.iter_mut() {
+                                    let chunk_start = first_iteration;
+                                    first_iteration += chunk.len() as i64;
+                                    let base_ctx = &base_ctx;
+                                    let table_pointer_path = table_pointer_path.as_str();
+                                    handles.push(s.spawn(move || {
+                                        worker_guard::enter_eval_worker();
+                                        evaluate_repeat_chunk(
+                                            engine,
+                                            table_pointer_path,
+                                            columns,
+                                            normal_cols,
+                                            user_data,
+                                            base_ctx,
+                                            chunk_start,
+                                            chunk,
+                                            token,
+                                        )
+                                    }));
+                                }
+                                handles
+                                    .into_iter()
+                                    .map(|h| {
+                                        h.join().unwrap_or_else(|_| {
+                                            Err("Table row worker panicked".to_string())
+                                        })
+                                    })
+                                    .collect()
+                            });
+                            for result in results {
+                                result?;
+                            }
+                            for chunk in chunks {
+                                local_rows.extend(chunk);
+                            }
+                        }
+                    );
+                    continue;
+                }
+
                 // Register this table's scope on the evaluator so self-table
                 // Var/Ref/ValueAt lookups resolve from local_rows.
                 // The guard is dropped at end of this block, clearing the scope.
@@ -1,9 +1,10 @@
 use crate::LogicId;
+use serde::{Deserialize, Serialize};
 use serde_json::Value;
 use std::sync::Arc;
 
 /// Pre-compiled column metadata computed at parse time (zero-copy design)
-#[derive(Clone, Debug)]
+#[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct ColumnMetadata {
     /// Column name (Arc to avoid clones)
     pub name: Arc<str>,
@@ -41,7 +42,7 @@ impl ColumnMetadata {
 }
 
 /// Pre-compiled repeat bound metadata
-#[derive(Clone, Debug)]
+#[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct RepeatBoundMetadata {
     pub logic: Option<LogicId>,
     /// Literal value (Arc to share)
@@ -49,7 +50,7 @@ pub struct RepeatBoundMetadata {
 }
 
 /// Pre-compiled row metadata (computed at parse time)
-#[derive(Clone, Debug)]
+#[derive(Clone, Debug, Serialize, Deserialize)]
 pub enum RowMetadata {
     Static {
         columns: Arc<[ColumnMetadata]>,
@@ -62,11 +63,14 @@ pub enum RowMetadata {
         forward_cols: Arc<[usize]>, // indices into columns array
         /// Pre-computed normal columns in schema order
         normal_cols: Arc<[usize]>, // indices into columns array
+        /// No forward columns and no column reads the table itself, so each row
+        /// depends only on its own cells and rows may be evaluated in parallel
+        row_independent: bool,
     },
 }
 
 /// Pre-compiled table metadata (computed once at parse time)
-#[derive(Clone, Debug)]
+#[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct TableMetadata {
     /// Data columns to evaluate before skip/clear
     pub data_plans: Arc<[(Arc<str>, Option<LogicId>, Option<Arc<Value>>)]>,
@@ -49,6 +49,17 @@ pub struct ValidationResult {
     pub errors: IndexMap<String, ValidationError>,
 }
 
+/// Change in validation errors since the previous validation of the same fields
+#[derive(Debug, Clone, Default, Serialize, Deserialize, PartialEq)]
+pub struct ValidationDelta {
+    /// Whether any validated field currently has an error
+    pub has_error: bool,
+    /// Fields whose error is new or differs from the previous validation
+    pub changed: IndexMap<String, ValidationError>,
+    /// Fields that had an error in the previous validation and now pass
+    pub cleared: Vec<String>,
+}
+
 /// One resolved element overlay produced by the layout resolver.
 /// Each entry describes properties to apply on top of the compact schema.
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -1,8 +1,10 @@
 use super::JSONEval;
 use crate::jsoneval::cancellation::CancellationToken;
 use crate::jsoneval::json_parser;
+use crate::jsoneval::path_filter::PathFilter;
 use crate::jsoneval::path_utils;
-use crate::jsoneval::types::{ValidationError, ValidationResult};
+use crate::jsoneval::types::{ValidationDelta, ValidationError, ValidationResult};
+use crate::jsoneval::validation_cache::ValidationCache;
 
 use crate::time_block;
 
@@ -11,6 +13,9 @@ use serde_json::Value;
 
 impl JSONEval {
     /// Validate data against schema rules
+    ///
+    /// Field outcomes are cached with the versions of their rule inputs, so only
+    /// fields whose data, visibility or rule formulas changed are re-checked.
     pub fn validate(
         &mut self,
         data: &str,
@@ -24,63 +29,179 @@ impl JSONEval {
             }
         }
         time_block!("validate() [total]", {
-            // Acquire lock for synchronous execution
-            let _lock = self.eval_lock.lock().unwrap();
+            let (result, _) = self.validate_incremental(data, context, paths, token)?;
+            Ok(result)
+        })
+    }
 
-            // Parse and update data
-            let data_value = json_parser::parse_json_str(data)?;
-            let context_value = if let Some(ctx) = context {
-                json_parser::parse_json_str(ctx)?
-            } else {
-                Value::Object(serde_json::Map::new())
-            };
+    /// Validate like [`validate`](Self::validate), returning only what changed since
+    /// the previous validation of the same fields: new or different errors, and
+    /// fields whose error cleared. Fields outside `paths` are not reported.
+    pub fn validate_delta(
+        &mut self,
+        data: &str,
+        context: Option<&str>,
+        paths: Option<&[String]>,
+        token: Option<&CancellationToken>,
+    ) -> Result<ValidationDelta, String> {
+        if let Some(t) = token {
+            if t.is_cancelled() {
+                return Err("Cancelled".to_string());
+            }
+        }
+        time_block!("validate_delta() [total]", {
+            let (_, delta) = self.validate_incremental(data, context, paths, token)?;
+            Ok(delta)
+        })
+    }
+
+    fn validate_incremental(
+        &mut self,
+        data: &str,
+        context: Option<&str>,
+        paths: Option<&[String]>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(ValidationResult, ValidationDelta), String> {
+        // Acquire lock for synchronous execution
+        let _lock = self.eval_lock.lock().unwrap();
+
+        // Parse and update data
+        let data_value = time_block!("  parse data", { json_parser::parse_json_str(data)? });
+        let context_value = if let Some(ctx) = context {
+            json_parser::parse_json_str(ctx)?
+        } else {
+            Value::Object(serde_json::Map::new())
+        };
+
+        // Update context
+        self.context = context_value.clone();
+
+        // Validating the payload that is already loaded (validate-on-blur after
+        // evaluate) keeps eval_data and every version as they are. Otherwise replace
+        // it and bump the versions of what changed, so rule formulas and cached field
+        // outcomes that read those paths are re-checked.
+        if !self.payload_matches(&data_value, &context_value) {
+            time_block!("  replace_data_and_context", {
+                let old_data = self.eval_data.snapshot_data();
+                self.eval_data
+                    .replace_data_and_context(data_value.clone(), context_value);
+                let new_data = self.eval_data.snapshot_data();
+                self.eval_cache
+                    .store_snapshot_and_diff_versions(&old_data, &new_data);
+            });
+        }
 
-            // Update context
-            self.context = context_value.clone();
+        // Drop lock before calling evaluate_others which needs mutable access
+        drop(_lock);
 
-            // Update eval_data with new data/context
-            self.eval_data
-                .replace_data_and_context(data_value.clone(), context_value);
+        // Re-evaluate rule evaluations to ensure fresh values
+        // This ensures all rule.$evaluation expressions are re-computed
+        self.evaluate_others(paths, token);
 
-            // Drop lock before calling evaluate_others which needs mutable access
-            drop(_lock);
+        // Resolve static markers in place (same result as get_evaluated_schema without the clone)
+        let mut evaluated_schema = std::mem::take(&mut self.evaluated_schema);
+        self.resolve_static_markers_in_value(&mut evaluated_schema);
+        self.evaluated_schema = evaluated_schema;
 
-            // Re-evaluate rule evaluations to ensure fresh values
-            // This ensures all rule.$evaluation expressions are re-computed
-            self.evaluate_others(paths, token);
+        let filter = paths.and_then(PathFilter::from_paths);
 
-            // Update evaluated_schema with fresh evaluations
-            self.evaluated_schema = self.get_evaluated_schema();
+        // Work on the validation cache outside eval_cache so dependency versions can be
+        // read while outcomes are stored
+        let mut cache = std::mem::take(&mut self.eval_cache.validation);
+        cache.prepare(
+            &self.fields_with_rules,
+            &self.evaluations,
+            &self.dependency_ids,
+        );
+        let result = self.validate_fields_cached(&mut cache, &data_value, filter.as_ref(), token);
+        self.eval_cache.validation = cache;
+        result
+    }
 
-            let mut errors: IndexMap<String, ValidationError> = IndexMap::new();
+    /// Whether `data` and `context` equal what eval_data already holds
+    fn payload_matches(&self, data: &Value, context: &Value) -> bool {
+        let (Value::Object(input), Value::Object(root)) = (data, self.eval_data.data()) else {
+            return false;
+        };
+        root.get("$context") == Some(context)
+            && input
+                .iter()
+                .all(|(key, value)| root.get(key) == Some(value))
+    }
 
-            // Use pre-parsed fields_with_rules from schema parsing (no runtime collection needed)
-            // This list was collected during schema parse and contains all fields with rules
-            for field_path in self.fields_with_rules.iter() {
-                // Check if we should validate this path (path filtering)
-                if let Some(filter_paths) = paths {
-                    if !filter_paths.is_empty()
-                        && !filter_paths.iter().any(|p| {
-                            field_path.starts_with(p.as_str()) || p.starts_with(field_path.as_str())
-                        })
-                    {
-                        continue;
-                    }
+    /// Validate every field in `fields_with_rules` (optionally filtered), reusing the
+    /// cached outcome of fields whose inputs did not change
+    fn validate_fields_cached(
+        &self,
+        cache: &mut ValidationCache,
+        data_value: &Value,
+        filter: Option<&PathFilter>,
+        token: Option<&CancellationToken>,
+    ) -> Result<(ValidationResult, ValidationDelta), String> {
+        let mut errors: IndexMap<String, ValidationError> = IndexMap::new();
+        let mut delta = ValidationDelta::default();
+        let mut rechecked = 0usize;
+
+        // Use pre-parsed fields_with_rules from schema parsing (no runtime collection needed)
+        // This list was collected during schema parse and contains all fields with rules
+        for (idx, field_path) in self.fields_with_rules.iter().enumerate() {
+            // Check if we should validate this path (path filtering)
+            if let Some(filter) = filter {
+                if !filter.matches(field_path) {
+                    continue;
                 }
+            }
 
-                self.validate_field(field_path, &data_value, &mut errors);
+            let field_data = self.get_field_data(field_path, data_value);
+            let hidden = self
+                .resolve_field_schema(field_path)
+                .map(|(_, resolved_path)| self.is_effective_hidden(&resolved_path));
+
+            let outcome = match cache.lookup(idx, &self.eval_cache, hidden, &field_data) {
+                Some(outcome) => outcome,
+                None => {
+                    rechecked += 1;
+                    self.validate_field(field_path, data_value, &mut errors);
+                    let outcome = errors.get(field_path).cloned();
+                    cache.store(idx, &self.eval_cache, hidden, field_data, outcome.clone());
+                    outcome
+                }
+            };
 
-                if let Some(t) = token {
-                    if t.is_cancelled() {
-                        return Err("Cancelled".to_string());
-                    }
+            match (cache.published.get(field_path), outcome) {
+                (Some(previous), Some(error)) if *previous == error => {
+                    errors.insert(field_path.clone(), error);
+                }
+                (_, Some(error)) => {
+                    cache.published.insert(field_path.clone(), error.clone());
+                    delta.changed.insert(field_path.clone(), error.clone());
+                    errors.insert(field_path.clone(), error);
+                }
+                (Some(_), None) => {
+                    cache.published.shift_remove(field_path);
+                    delta.cleared.push(field_path.clone());
+                }
+                (None, None) => {}
+            }
+
+            if let Some(t) = token {
+                if t.is_cancelled() {
+                    return Err("Cancelled".to_string());
                 }
             }
+        }
 
-            let has_error = !errors.is_empty();
+        if crate::utils::is_debug_cache_enabled() {
+            println!(
+                "[validate] re-checked {} of {} fields with rules",
+                rechecked,
+                self.fields_with_rules.len()
+            );
+        }
 
-            Ok(ValidationResult { has_error, errors })
-        })
+        let has_error = !errors.is_empty();
+        delta.has_error = has_error;
+        Ok((ValidationResult { has_error, errors }, delta))
     }
 
     /// Validate using the data already present in `eval_data` (set by `with_item_cache_swap`).
@@ -95,18 +216,17 @@ impl JSONEval {
     ) -> Result<crate::ValidationResult, String> {
         // Re-evaluate rule evaluations with the current (already-set) data.
         self.evaluate_others(paths, token);
-        self.evaluated_schema = self.get_evaluated_schema();
+        let mut evaluated_schema = std::mem::take(&mut self.evaluated_schema);
+        self.resolve_static_markers_in_value(&mut evaluated_schema);
+        self.evaluated_schema = evaluated_schema;
 
         let mut errors: IndexMap<String, ValidationError> = IndexMap::new();
+        let filter = paths.and_then(PathFilter::from_paths);
 
         let fields: Vec<String> = self.fields_with_rules.iter().cloned().collect();
         for field_path in &fields {
-            if let Some(filter_paths) = paths {
-                if !filter_paths.is_empty()
-                    && !filter_paths.iter().any(|p| {
-                        field_path.starts_with(p.as_str()) || p.starts_with(field_path.as_str())
-                    })
-                {
+            if let Some(filter) = &filter {
+                if !filter.matches(field_path) {
                     continue;
                 }
             }
@@ -134,20 +254,8 @@ impl JSONEval {
             return;
         }
 
-        // Resolve schema for this field
-        let schema_path = path_utils::dot_notation_to_schema_pointer(field_path);
-        let pointer_path = schema_path.trim_start_matches('#');
-
-        // Try to get schema, if not found, try with /properties/ prefix for standard JSON Schema
-        let (field_schema, resolved_path) = match self.evaluated_schema.pointer(pointer_path) {
-            Some(s) => (s, pointer_path.to_string()),
-            None => {
-                let alt_path = format!("/properties{}", pointer_path);
-                match self.evaluated_schema.pointer(&alt_path) {
-                    Some(s) => (s, alt_path),
-                    None => return,
-                }
-            }
+        let Some((field_schema, resolved_path)) = self.resolve_field_schema(field_path) else {
+            return;
         };
 
         // Skip hidden fields
@@ -180,6 +288,22 @@ impl JSONEval {
         }
     }
 
+    /// Evaluated schema of a field and the pointer it was found at
+    fn resolve_field_schema(&self, field_path: &str) -> Option<(&Value, String)> {
+        let schema_path = path_utils::dot_notation_to_schema_pointer(field_path);
+        let pointer_path = schema_path.trim_start_matches('#');
+
+        // Try to get schema, if not found, try with /properties/ prefix for standard JSON Schema
+        match self.evaluated_schema.pointer(pointer_path) {
+            Some(s) => Some((s, pointer_path.to_string())),
+            None => {
+                let alt_path = format!("/properties{}", pointer_path);
+                let s = self.evaluated_schema.pointer(&alt_path)?;
+                Some((s, alt_path))
+            }
+        }
+    }
+
     /// Get data value for a field path
     pub(crate) fn get_field_data(&self, field_path: &str, data: &Value) -> Value {
         let parts: Vec<&str> = field_path.split('.').collect();
@@ -344,12 +468,7 @@ impl JSONEval {
                 if !is_empty {
                     if let Some(pattern) = rule_active.as_str() {
                         if let Some(text) = field_data.as_str() {
-                            let mut cache = self.regex_cache.write().unwrap();
-                            let regex = cache.entry(pattern.to_string()).or_insert_with(|| {
-                                regex::Regex::new(pattern)
-                                    .unwrap_or_else(|_| regex::Regex::new("(?:)").unwrap())
-                            });
-                            if !regex.is_match(text) {
+                            if !self.rule_patterns.is_match(pattern, text) {
                                 errors.insert(
                                     field_path.to_string(),
                                     ValidationError {
@@ -0,0 +1,127 @@
+//! Per-field memo of validation outcomes.
+//!
+//! A field's outcome depends on its data value, whether it is effectively hidden,
+//! and the evaluated `rules` / `condition` entries of its schema. Those entries are
+//! formula results that only change when one of the formulas' dependencies moves,
+//! so each outcome is stored with the versions of those dependencies (read from the
+//! [`EvalCache`] trackers) and reused while the versions, the data value and the
+//! hidden state all match. `validate` then only re-checks fields whose inputs or
+//! rule formulas changed.
+
+use std::sync::Arc;
+
+use indexmap::IndexMap;
+use rapidhash::{HashMapExt, RapidHashMap};
+use serde_json::Value;
+use smallvec::SmallVec;
+
+use crate::jsoneval::eval_cache::EvalCache;
+use crate::jsoneval::path_id::{DependencyIds, PathIds};
+use crate::jsoneval::path_utils;
+use crate::jsoneval::types::ValidationError;
+use crate::rlogic::LogicId;
+
+/// Schema segments whose formulas feed a field's validation
+const RULE_INPUT_SEGMENTS: [&str; 2] = ["/rules/", "/condition/"];
+
+#[derive(Clone)]
+struct FieldOutcome {
+    dep_versions: SmallVec<[u64; 8]>,
+    /// `None` when the field is missing from the evaluated schema
+    hidden: Option<bool>,
+    field_data: Value,
+    error: Option<ValidationError>,
+}
+
+#[derive(Clone, Default)]
+pub(crate) struct ValidationCache {
+    /// `fields_with_rules` the dependency lists were built for
+    fields: Option<Arc<Vec<String>>>,
+    /// Dependencies of each field's rule and condition formulas, by field index
+    deps: Vec<PathIds>,
+    outcomes: Vec<Option<FieldOutcome>>,
+    /// Errors as of the last validation of each field (see `validate_delta`)
+    pub published: IndexMap<String, ValidationError>,
+}
+
+impl ValidationCache {
+    /// Build the per-field dependency lists, once per `fields_with_rules`
+    pub fn prepare(
+        &mut self,
+        fields: &Arc<Vec<String>>,
+        evaluations: &IndexMap<String, LogicId>,
+        dependency_ids: &DependencyIds,
+    ) {
+        if self.fields.as_ref().is_some_and(|f| Arc::ptr_eq(f, fields)) {
+            return;
+        }
+
+        // Both spellings `validate_field` resolves: `#/a/properties/b` and `#/properties/a/...`
+        let mut field_index: RapidHashMap<String, usize> = RapidHashMap::new();
+        for (idx, field_path) in fields.iter().enumerate() {
+            let pointer = path_utils::dot_notation_to_schema_pointer(field_path);
+            let pointer = pointer.trim_start_matches('#');
+            field_index.insert(format!("#/properties{}", pointer), idx);
+            field_index.insert(format!("#{}", pointer), idx);
+        }
+
+        let mut deps: Vec<PathIds> = vec![PathIds::new(); fields.len()];
+        for eval_key in evaluations.keys() {
+            let owner = RULE_INPUT_SEGMENTS
+                .iter()
+                .flat_map(|segment| eval_key.match_indices(segment))
+                .find_map(|(at, _)| field_index.get(&eval_key[..at]));
+            let Some(&idx) = owner else {
+                continue;
+            };
+            deps[idx].extend_from_slice(dependency_ids.of(eval_key));
+        }
+        for field_deps in &mut deps {
+            field_deps.sort_unstable();
+            field_deps.dedup();
+        }
+
+        self.fields = Some(Arc::clone(fields));
+        self.outcomes = vec![None; fields.len()];
+        self.deps = deps;
+    }
+
+    /// Cached outcome of field `idx`, if none of its inputs changed since it was stored
+    pub fn lookup(
+        &self,
+        idx: usize,
+        cache: &EvalCache,
+        hidden: Option<bool>,
+        field_data: &Value,
+    ) -> Option<Option<ValidationError>> {
+        let outcome = self.outcomes.get(idx)?.as_ref()?;
+        let unchanged = outcome.hidden == hidden
+            && outcome
+                .dep_versions
+                .iter()
+                .zip(&self.deps[idx])
+                .all(|(&version, &dep)| cache.dep_version(dep) == version)
+            && outcome.field_data == *field_data;
+        unchanged.then(|| outcome.error.clone())
+    }
+
+    pub fn store(
+        &mut self,
+        idx: usize,
+        cache: &EvalCache,
+        hidden: Option<bool>,
+        field_data: Value,
+        error: Option<ValidationError>,
+    ) {
+        let dep_versions = self.deps[idx]
+            .iter()
+            .map(|&dep| cache.dep_version(dep))
+            .collect();
+        self.outcomes[idx] = Some(FieldOutcome {
+            dep_versions,
+            hidden,
+            field_data,
+            error,
+        });
+    }
+}
@@ -0,0 +1,26 @@
+//! Nesting guard shared by the evaluation fan-outs.
+//!
+//! Table rows, subform items and batch records each spread their work over up
+//! to core-count threads. A fan-out started from one of those worker threads
+//! runs serially instead, so nested evaluations (tables inside subform items,
+//! subforms inside batch records) do not multiply the thread count.
+
+use std::cell::Cell;
+
+thread_local! {
+    /// Set on evaluation worker threads to keep nested fan-outs serial
+    static IN_EVAL_WORKER: Cell<bool> = const { Cell::new(false) };
+}
+
+/// Whether the current thread is an evaluation worker
+#[inline]
+pub(crate) fn in_eval_worker() -> bool {
+    IN_EVAL_WORKER.with(Cell::get)
+}
+
+/// Mark the current thread as an evaluation worker. Called first thing on every
+/// spawned worker; the flag dies with the scoped thread.
+#[inline]
+pub(crate) fn enter_eval_worker() {
+    IN_EVAL_WORKER.with(|flag| flag.set(true));
+}
@@ -34,10 +34,12 @@ pub mod ffi;
 pub mod wasm;
 
 // Re-export stable public Rust API from focused internal modules.
+pub use jsoneval::batch::{evaluate_batch, BatchWorker};
 pub use jsoneval::eval_data::EvalData;
+pub use jsoneval::instance_pool::{JSONEvalPool, JSON_EVAL_POOL};
 pub use jsoneval::parsed_schema::ParsedSchema;
 pub use jsoneval::parsed_schema_cache::{
-    ParsedSchemaCache, ParsedSchemaCacheStats, PARSED_SCHEMA_CACHE,
+    ParsedSchemaCache, ParsedSchemaCacheCapacity, ParsedSchemaCacheStats, PARSED_SCHEMA_CACHE,
 };
 pub use jsoneval::path_utils::ArrayMetadata;
 pub use jsoneval::table_metadata::TableMetadata;
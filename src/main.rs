@@ -1,11 +1,28 @@
+use json_eval_rs::jsoneval::batch::batch_workers;
 use json_eval_rs::jsoneval::json_parser;
-use json_eval_rs::{JSONEval, ParsedSchema};
+use json_eval_rs::{BatchWorker, JSONEval, ParsedSchema};
 use rmp_serde;
 use serde_json::Value;
+use std::any::Any;
+use std::collections::BTreeMap;
 use std::fs;
-use std::path::PathBuf;
-use std::sync::Arc;
-use std::time::Instant;
+use std::io::{self, BufRead, BufReader, BufWriter, Read, Write};
+use std::panic::{self, AssertUnwindSafe};
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::mpsc::sync_channel;
+use std::sync::{Arc, Condvar, Mutex};
+use std::time::{Duration, Instant};
+
+/// Records allowed between the batch reader and writer, per worker
+const BATCH_WINDOW_PER_WORKER: usize = 16;
+
+/// Interval between batch progress reports on stderr
+const BATCH_PROGRESS_INTERVAL: Duration = Duration::from_secs(5);
+
+/// Largest batch record accepted, so a corrupt length prefix or a missing
+/// newline cannot make the reader allocate without bound
+const MAX_BATCH_RECORD_BYTES: usize = 64 << 20;
 
 fn print_parsed_schema_info(
     parsed_schema: &ParsedSchema,
@@ -83,6 +100,342 @@ fn print_parsed_schema_info(
     println!();
 }
 
+fn load_parsed_schema(schema_file: &Path, is_msgpack: bool) -> Arc<ParsedSchema> {
+    if is_msgpack {
+        let schema_bytes = fs::read(schema_file).unwrap_or_else(|e| {
+            eprintln!("Error: failed to read schema: {}", e);
+            std::process::exit(1);
+        });
+        Arc::new(
+            ParsedSchema::parse_msgpack(&schema_bytes).unwrap_or_else(|e| {
+                eprintln!("Error: failed to parse MessagePack schema: {}", e);
+                std::process::exit(1);
+            }),
+        )
+    } else {
+        let schema_str = fs::read_to_string(schema_file).unwrap_or_else(|e| {
+            eprintln!("Error: failed to read schema: {}", e);
+            std::process::exit(1);
+        });
+        Arc::new(ParsedSchema::parse(&schema_str).unwrap_or_else(|e| {
+            eprintln!("Error: failed to parse schema: {}", e);
+            std::process::exit(1);
+        }))
+    }
+}
+
+#[derive(Clone, Copy, PartialEq)]
+enum BatchFormat {
+    /// One JSON record per line
+    Ndjson,
+    /// Each record is a 4-byte big-endian length followed by MessagePack bytes
+    Msgpack,
+}
+
+struct BatchOptions {
+    input: Option<PathBuf>,
+    output: Option<PathBuf>,
+    no_output: bool,
+    format: BatchFormat,
+    workers: usize,
+    output_paths: Vec<String>,
+    unordered: bool,
+}
+
+/// Counting semaphore over the records read but not yet written, so memory
+/// stays bounded however far the reader could get ahead
+struct BatchWindow {
+    free: Mutex<usize>,
+    cond: Condvar,
+}
+
+impl BatchWindow {
+    fn new(size: usize) -> Self {
+        Self {
+            free: Mutex::new(size),
+            cond: Condvar::new(),
+        }
+    }
+
+    fn acquire(&self) {
+        let mut free = self.free.lock().unwrap();
+        while *free == 0 {
+            free = self.cond.wait(free).unwrap();
+        }
+        *free -= 1;
+    }
+
+    fn release(&self) {
+        *self.free.lock().unwrap() += 1;
+        self.cond.notify_one();
+    }
+}
+
+/// Read the next record into `buf`. Returns `false` at the end of the input.
+/// Records over [`MAX_BATCH_RECORD_BYTES`] are an `InvalidData` error.
+fn read_batch_record(
+    input: &mut dyn BufRead,
+    format: BatchFormat,
+    buf: &mut Vec<u8>,
+) -> io::Result<bool> {
+    let too_large = |len: usize| {
+        io::Error::new(
+            io::ErrorKind::InvalidData,
+            format!(
+                "record of {} bytes exceeds the {} byte limit",
+                len, MAX_BATCH_RECORD_BYTES
+            ),
+        )
+    };
+    buf.clear();
+    match format {
+        BatchFormat::Ndjson => loop {
+            let limit = MAX_BATCH_RECORD_BYTES as u64 + 1;
+            if Read::take(&mut *input, limit).read_until(b'\n', buf)? == 0 {
+                return Ok(false);
+            }
+            if buf.len() > MAX_BATCH_RECORD_BYTES {
+                return Err(too_large(buf.len()));
+            }
+            if !buf.iter().all(u8::is_ascii_whitespace) {
+                return Ok(true);
+            }
+            buf.clear();
+        },
+        BatchFormat::Msgpack => {
+            if input.fill_buf()?.is_empty() {
+                return Ok(false);
+            }
+            let mut len = [0u8; 4];
+            input.read_exact(&mut len)?;
+            let len = u32::from_be_bytes(len) as usize;
+            if len > MAX_BATCH_RECORD_BYTES {
+                return Err(too_large(len));
+            }
+            buf.resize(len, 0);
+            input.read_exact(buf)?;
+            Ok(true)
+        }
+    }
+}
+
+fn parse_batch_record(bytes: &[u8], format: BatchFormat) -> Result<Value, String> {
+    match format {
+        BatchFormat::Ndjson => {
+            let text = std::str::from_utf8(bytes).map_err(|e| format!("invalid UTF-8: {}", e))?;
+            json_parser::parse_json_str(text)
+        }
+        BatchFormat::Msgpack => {
+            rmp_serde::from_slice(bytes).map_err(|e| format!("invalid MessagePack: {}", e))
+        }
+    }
+}
+
+/// Error text for a record whose evaluation panicked
+fn panic_message(payload: &(dyn Any + Send)) -> String {
+    let detail = payload
+        .downcast_ref::<&str>()
+        .copied()
+        .or_else(|| payload.downcast_ref::<String>().map(String::as_str))
+        .unwrap_or("unknown cause");
+    format!("evaluation panicked: {}", detail)
+}
+
+/// One output line: `{"value": ...}` or `{"error": "..."}`, with the record id
+/// first when results are unordered
+fn batch_result_line(id: Option<usize>, result: Result<Value, String>) -> String {
+    let mut line = serde_json::Map::new();
+    if let Some(id) = id {
+        line.insert("id".to_string(), Value::from(id));
+    }
+    match result {
+        Ok(value) => line.insert("value".to_string(), value),
+        Err(e) => line.insert("error".to_string(), Value::String(e)),
+    };
+    serde_json::to_string(&Value::Object(line)).unwrap_or_else(|e| {
+        format!(
+            "{{\"error\":{}}}",
+            Value::String(format!("failed to serialize result: {}", e))
+        )
+    })
+}
+
+fn report_batch_progress(records: usize, errors: usize, elapsed: Duration, done: bool) {
+    let rate = records as f64 / elapsed.as_secs_f64().max(f64::EPSILON);
+    eprintln!(
+        "{} {} records ({} failed) in {:.2?} — {:.0} records/s",
+        if done { "✅" } else { "⏳" },
+        records,
+        errors,
+        elapsed,
+        rate
+    );
+}
+
+/// Stream records through `options.workers` threads, writing one result line per
+/// record. Returns the number of records and of failed records.
+fn run_batch(parsed: Arc<ParsedSchema>, options: BatchOptions) -> Result<(usize, usize), String> {
+    let input: Box<dyn BufRead + Send> = match &options.input {
+        Some(path) if path.as_os_str() != "-" => {
+            Box::new(BufReader::new(fs::File::open(path).map_err(|e| {
+                format!("failed to open '{}': {}", path.display(), e)
+            })?))
+        }
+        _ => Box::new(BufReader::new(io::stdin())),
+    };
+    let mut output: Box<dyn Write> = if options.no_output {
+        Box::new(io::sink())
+    } else if let Some(path) = &options.output {
+        Box::new(BufWriter::new(fs::File::create(path).map_err(|e| {
+            format!("failed to create '{}': {}", path.display(), e)
+        })?))
+    } else {
+        Box::new(BufWriter::new(io::stdout().lock()))
+    };
+
+    let mut workers = Vec::with_capacity(options.workers);
+    for _ in 0..options.workers {
+        workers.push(BatchWorker::new(
+            Arc::clone(&parsed),
+            &options.output_paths,
+        )?);
+    }
+
+    let format = options.format;
+    let unordered = options.unordered;
+    let window = BatchWindow::new(options.workers * BATCH_WINDOW_PER_WORKER);
+    let stop = AtomicBool::new(false);
+    let (job_tx, job_rx) = sync_channel::<(usize, Vec<u8>)>(options.workers * 2);
+    // Shared by the workers only, so the reader sees a closed channel if they all stop
+    let job_rx = Arc::new(Mutex::new(job_rx));
+    let (result_tx, result_rx) = sync_channel::<(usize, bool, String)>(options.workers * 2);
+    let start = Instant::now();
+
+    std::thread::scope(|s| -> Result<(usize, usize), String> {
+        let window = &window;
+        let stop = &stop;
+
+        let reader = s.spawn(move || -> Result<(), String> {
+            let mut input = input;
+            let mut id = 0usize;
+            loop {
+                window.acquire();
+                let mut buf = Vec::new();
+                let more = if stop.load(Ordering::Relaxed) {
+                    Ok(false)
+                } else {
+                    read_batch_record(&mut *input, format, &mut buf)
+                };
+                match more {
+                    Ok(true) => {
+                        if job_tx.send((id, buf)).is_err() {
+                            return Ok(());
+                        }
+                        id += 1;
+                    }
+                    Ok(false) => {
+                        window.release();
+                        return Ok(());
+                    }
+                    Err(e) => {
+                        window.release();
+                        return Err(format!("failed to read record {}: {}", id + 1, e));
+                    }
+                }
+            }
+        });
+
+        for mut worker in workers {
+            let job_rx = Arc::clone(&job_rx);
+            let result_tx = result_tx.clone();
+            let parsed = &parsed;
+            let output_paths = options.output_paths.as_slice();
+            s.spawn(move || loop {
+                let job = job_rx.lock().unwrap().recv();
+                let Ok((id, bytes)) = job else { break };
+                // A panicking record becomes an error line instead of a missing
+                // result, and the worker is rebuilt so later records still run
+                let result = match panic::catch_unwind(AssertUnwindSafe(|| {
+                    parse_batch_record(&bytes, format).and_then(|record| worker.evaluate(record))
+                })) {
+                    Ok(result) => result,
+                    Err(payload) => {
+                        if let Ok(fresh) = BatchWorker::new(Arc::clone(parsed), output_paths) {
+                            worker = fresh;
+                        }
+                        Err(panic_message(payload.as_ref()))
+                    }
+                };
+                let ok = result.is_ok();
+                let line = batch_result_line(unordered.then_some(id), result);
+                if result_tx.send((id, ok, line)).is_err() {
+                    break;
+                }
+            });
+        }
+        drop(job_rx);
+        drop(result_tx);
+
+        // Write results on this thread, in record order unless unordered
+        let mut records = 0usize;
+        let mut errors = 0usize;
+        let mut write_error: Option<String> = None;
+        let mut pending: BTreeMap<usize, (bool, String)> = BTreeMap::new();
+        let mut next_id = 0usize;
+        let mut last_report = Instant::now();
+        let mut write_line = |ok: bool, line: String| {
+            records += 1;
+            errors += usize::from(!ok);
+            if write_error.is_none() {
+                if let Err(e) = writeln!(output, "{}", line) {
+                    write_error = Some(format!("failed to write output: {}", e));
+                    stop.store(true, Ordering::Relaxed);
+                }
+            }
+            window.release();
+            if last_report.elapsed() >= BATCH_PROGRESS_INTERVAL {
+                report_batch_progress(records, errors, start.elapsed(), false);
+                last_report = Instant::now();
+            }
+        };
+
+        for (id, ok, line) in result_rx {
+            if unordered {
+                write_line(ok, line);
+                continue;
+            }
+            pending.insert(id, (ok, line));
+            while let Some((ok, line)) = pending.remove(&next_id) {
+                write_line(ok, line);
+                next_id += 1;
+            }
+        }
+        drop(write_line);
+
+        // Every worker is done; wake the reader if it is waiting for room
+        stop.store(true, Ordering::Relaxed);
+        window.release();
+        let flushed = output.flush();
+
+        reader
+            .join()
+            .unwrap_or_else(|_| Err("batch reader panicked".to_string()))?;
+        if let Some(e) = write_error {
+            return Err(e);
+        }
+        flushed.map_err(|e| format!("failed to write output: {}", e))?;
+        if !pending.is_empty() {
+            return Err(format!(
+                "a batch worker stopped early; {} results after record {} were not written",
+                pending.len(),
+                next_id
+            ));
+        }
+        report_batch_progress(records, errors, start.elapsed(), true);
+        Ok((records, errors))
+    })
+}
+
 fn print_help(program_name: &str) {
     println!("\n🚀 JSON Evaluation CLI\n");
     println!("USAGE:");
@@ -98,6 +451,16 @@ fn print_help(program_name: &str) {
     println!("    -i, --iterations <N>       Number of evaluation iterations (default: 1)");
     println!("    -o, --output <FILE>        Output file for evaluated schema (default: stdout)");
     println!("    --no-output                Suppress output (for benchmarking)");
+    println!("\nBATCH MODE:");
+    println!("    --batch                    Evaluate a stream of records (from --data, or stdin)");
+    println!("    --batch-format <FORMAT>    ndjson (default) or msgpack (u32 big-endian length + record)");
+    println!("    --threads <N>              Worker threads (default: available cores)");
+    println!(
+        "    --paths <P1,P2,...>        Schema paths to output per record (default: whole schema)"
+    );
+    println!(
+        "    --unordered                Write results as they finish, tagged with the record id"
+    );
     println!("\nPARSED SCHEMA INSPECTION:");
     println!("    --print-sorted-evaluations Print sorted evaluation batches");
     println!("    --print-dependencies       Print dependency graph");
@@ -117,6 +480,11 @@ fn print_help(program_name: &str) {
         "    {} schema.json -d data.json --parsed -i 100\n",
         program_name
     );
+    println!("    # Batch evaluation of NDJSON records from stdin");
+    println!(
+        "    cat records.ndjson | {} schema.json --batch --threads 8 --paths \"#/properties/premium/value\"\n",
+        program_name
+    );
     println!("    # Full benchmark with custom comparison path");
     println!("    {} schema.json -d data.json -c expected.json --compare-path \"$.result\" --parsed -i 100", program_name);
 }
@@ -138,6 +506,11 @@ fn main() {
     let mut print_dependencies = false;
     let mut print_tables = false;
     let mut print_evaluations = false;
+    let mut batch = false;
+    let mut batch_format = BatchFormat::Ndjson;
+    let mut threads: Option<usize> = None;
+    let mut output_paths: Vec<String> = Vec::new();
+    let mut unordered = false;
     let mut i = 1;
 
     while i < args.len() {
@@ -199,6 +572,58 @@ fn main() {
             output_file = Some(PathBuf::from(&args[i]));
         } else if arg == "--no-output" {
             no_output = true;
+        } else if arg == "--batch" {
+            batch = true;
+        } else if arg == "--batch-format" {
+            if i + 1 >= args.len() {
+                eprintln!("Error: {} requires a value", arg);
+                print_help(program_name);
+                std::process::exit(1);
+            }
+            i += 1;
+            batch_format = match args[i].as_str() {
+                "ndjson" => BatchFormat::Ndjson,
+                "msgpack" => BatchFormat::Msgpack,
+                other => {
+                    eprintln!(
+                        "Error: batch format must be 'ndjson' or 'msgpack', got '{}'",
+                        other
+                    );
+                    std::process::exit(1);
+                }
+            };
+        } else if arg == "--threads" {
+            if i + 1 >= args.len() {
+                eprintln!("Error: {} requires a value", arg);
+                print_help(program_name);
+                std::process::exit(1);
+            }
+            i += 1;
+            match args[i].parse::<usize>() {
+                Ok(n) if n > 0 => threads = Some(n),
+                _ => {
+                    eprintln!(
+                        "Error: threads must be a positive integer, got '{}'",
+                        args[i]
+                    );
+                    std::process::exit(1);
+                }
+            }
+        } else if arg == "--paths" {
+            if i + 1 >= args.len() {
+                eprintln!("Error: {} requires a value", arg);
+                print_help(program_name);
+                std::process::exit(1);
+            }
+            i += 1;
+            output_paths = args[i]
+                .split(',')
+                .map(str::trim)
+                .filter(|p| !p.is_empty())
+                .map(str::to_string)
+                .collect();
+        } else if arg == "--unordered" {
+            unordered = true;
         } else if arg == "--print-sorted-evaluations" {
             print_sorted_evaluations = true;
         } else if arg == "--print-dependencies" {
@@ -251,6 +676,48 @@ fn main() {
         .map(|e| e == "bform")
         .unwrap_or(false);
 
+    if batch {
+        // Batch output goes to stdout, so status goes to stderr
+        let workers = threads.unwrap_or_else(|| batch_workers(None));
+        eprintln!("\n🚀 JSON Evaluation CLI — batch mode\n");
+        eprintln!("📄 Schema: {}", schema_file.display());
+        eprintln!(
+            "📊 Records: {} ({})",
+            data_file
+                .as_ref()
+                .map_or("stdin".to_string(), |p| p.display().to_string()),
+            if batch_format == BatchFormat::Msgpack {
+                "length-prefixed MessagePack"
+            } else {
+                "NDJSON"
+            }
+        );
+        eprintln!(
+            "🧵 Workers: {}{}\n",
+            workers,
+            if unordered { ", unordered" } else { "" }
+        );
+
+        let parse_start = Instant::now();
+        let parsed_schema = load_parsed_schema(&schema_file, is_schema_msgpack);
+        eprintln!("⏱️  Schema parsing: {:?}", parse_start.elapsed());
+
+        let options = BatchOptions {
+            input: data_file,
+            output: output_file,
+            no_output,
+            format: batch_format,
+            workers,
+            output_paths,
+            unordered,
+        };
+        if let Err(e) = run_batch(parsed_schema, options) {
+            eprintln!("Error: {}", e);
+            std::process::exit(1);
+        }
+        return;
+    }
+
     // Load data file if provided, otherwise use empty object
     // Detect if data file is MessagePack based on extension
     let (data_str, is_data_msgpack) = if let Some(ref data_path) = data_file {
@@ -343,27 +810,7 @@ fn main() {
     let (evaluated_schema, _parse_time, eval_time) = if use_parsed {
         // ParsedSchema mode
         let parse_start = Instant::now();
-        let parsed_schema = if is_schema_msgpack {
-            let schema_bytes = fs::read(&schema_file).unwrap_or_else(|e| {
-                eprintln!("Error: failed to read schema: {}", e);
-                std::process::exit(1);
-            });
-            Arc::new(
-                ParsedSchema::parse_msgpack(&schema_bytes).unwrap_or_else(|e| {
-                    eprintln!("Error: failed to parse MessagePack schema: {}", e);
-                    std::process::exit(1);
-                }),
-            )
-        } else {
-            let schema_str = fs::read_to_string(&schema_file).unwrap_or_else(|e| {
-                eprintln!("Error: failed to read schema: {}", e);
-                std::process::exit(1);
-            });
-            Arc::new(ParsedSchema::parse(&schema_str).unwrap_or_else(|e| {
-                eprintln!("Error: failed to parse schema: {}", e);
-                std::process::exit(1);
-            }))
-        };
+        let parsed_schema = load_parsed_schema(&schema_file, is_schema_msgpack);
         let parse_time = parse_start.elapsed();
 
         println!("⏱️  Schema parsing: {:?}", parse_time);
@@ -54,6 +54,137 @@ pub fn collect_layout_field_refs(value: &Value, refs: &mut IndexSet<String>) {
     }
 }
 
+/// Schema pointer a layout element `$ref` resolves to.
+///
+/// Pointer refs (`#/...`, `/...`) are used as is. Dotted refs map to their
+/// `properties` pointer when it exists in `schema`, else to a plain
+/// `/properties/a/properties/b` chain.
+pub fn layout_ref_pointer(schema: &Value, reference: &str) -> String {
+    if reference.starts_with('#') || reference.starts_with('/') {
+        return path_utils::normalize_to_json_pointer(reference).into_owned();
+    }
+    let schema_pointer = path_utils::dot_notation_to_schema_pointer(reference);
+    let schema_path = path_utils::normalize_to_json_pointer(&schema_pointer).into_owned();
+    if schema.pointer(&schema_path).is_some() {
+        schema_path
+    } else {
+        format!("/properties/{}", reference.replace('.', "/properties/"))
+    }
+}
+
+/// Schema pointer owning `.../$layout/elements`; root layouts have no owner.
+pub fn layout_owner_pointer(layout_path: &str) -> String {
+    layout_path
+        .trim_end_matches("/$layout/elements")
+        .trim_start_matches('#')
+        .to_string()
+}
+
+/// Collect schema targets referenced from layout elements only. Formula `$ref`s are
+/// intentionally ignored: they do not attach a field to a visual layout parent.
+pub fn collect_layout_ref_targets(schema: &Value) -> IndexSet<String> {
+    fn collect_elements(elements: &Value, refs: &mut IndexSet<String>) {
+        let Some(elements) = elements.as_array() else {
+            return;
+        };
+        for element in elements {
+            let Some(map) = element.as_object() else {
+                continue;
+            };
+            if let Some(reference) = map.get("$ref").and_then(Value::as_str) {
+                let pointer = path_utils::normalize_to_json_pointer(
+                    &path_utils::dot_notation_to_schema_pointer(reference),
+                )
+                .trim_start_matches('#')
+                .to_string();
+                refs.insert(pointer);
+            }
+            if let Some(children) = map.get("elements") {
+                collect_elements(children, refs);
+            }
+        }
+    }
+
+    fn walk(value: &Value, refs: &mut IndexSet<String>) {
+        let Some(map) = value.as_object() else {
+            return;
+        };
+        if let Some(elements) = map
+            .get("$layout")
+            .and_then(Value::as_object)
+            .and_then(|layout| layout.get("elements"))
+        {
+            collect_elements(elements, refs);
+        }
+        for child in map.values() {
+            walk(child, refs);
+        }
+    }
+
+    let mut refs = IndexSet::new();
+    walk(schema, &mut refs);
+    refs
+}
+
+/// Map each root layout to the schema nodes its resolution reads.
+///
+/// A root layout is one not attached under another layout's `$ref` tree (attached
+/// layouts are expanded by their parent). Its dependencies are every `$ref` target
+/// reachable from its elements, including through a target's own `$layout` or
+/// `elements`. Resolving a root reads nothing else from the evaluated schema, so
+/// it only needs resolving again when one of these nodes changes.
+pub fn collect_layout_dependencies(
+    schema: &Value,
+    layout_paths: &[String],
+) -> IndexMap<String, Vec<String>> {
+    fn collect_elements(schema: &Value, elements: &Value, deps: &mut IndexSet<String>) {
+        let Some(elements) = elements.as_array() else {
+            return;
+        };
+        for element in elements {
+            let Some(map) = element.as_object() else {
+                continue;
+            };
+            if let Some(reference) = map.get("$ref").and_then(Value::as_str) {
+                let pointer = layout_ref_pointer(schema, reference);
+                // Each target is expanded once, which also stops reference cycles
+                if deps.insert(pointer.clone()) {
+                    if let Some(target) = schema.pointer(&pointer) {
+                        if let Some(nested) = target.get("$layout").and_then(|l| l.get("elements"))
+                        {
+                            collect_elements(schema, nested, deps);
+                        }
+                        if let Some(nested) = target.get("elements") {
+                            collect_elements(schema, nested, deps);
+                        }
+                    }
+                }
+            }
+            if let Some(children) = map.get("elements") {
+                collect_elements(schema, children, deps);
+            }
+        }
+    }
+
+    let attached = collect_layout_ref_targets(schema);
+    layout_paths
+        .iter()
+        .filter(|path| {
+            let owner = layout_owner_pointer(path);
+            owner.is_empty() || !attached.contains(&owner)
+        })
+        .map(|layout_path| {
+            let mut deps = IndexSet::new();
+            if let Some(elements) =
+                schema.pointer(&path_utils::normalize_to_json_pointer(layout_path))
+            {
+                collect_elements(schema, elements, &mut deps);
+            }
+            (layout_path.clone(), deps.into_iter().collect())
+        })
+        .collect()
+}
+
 /// Collect $ref dependencies from a JSON value recursively
 pub fn collect_refs(value: &Value, refs: &mut IndexSet<String>) {
     match value {
@@ -600,6 +731,30 @@ pub fn process_value_fields(
     value_evaluations
 }
 
+/// Whether any column logic reads the table being built (e.g. `VALUEAT` over
+/// earlier rows). Var paths are collected as JSON pointers and Ref paths in
+/// dotted form, so both are compared with `properties` segments stripped.
+fn columns_reference_table(engine: &RLogic, columns: &[ColumnMetadata], eval_key: &str) -> bool {
+    fn strip(path: &str) -> String {
+        path_utils::pointer_to_dot_notation(path)
+            .split('.')
+            .filter(|seg| *seg != "properties" && !seg.is_empty())
+            .collect::<Vec<_>>()
+            .join(".")
+    }
+
+    let table = strip(eval_key);
+    let table_prefix = format!("{}.", table);
+    columns.iter().filter_map(|col| col.logic).any(|logic_id| {
+        engine
+            .get_referenced_vars(&logic_id)
+            .unwrap_or_default()
+            .iter()
+            .map(|var| strip(var))
+            .any(|var| var == table || var.starts_with(&table_prefix))
+    })
+}
+
 pub fn compile_table_metadata(
     evaluations: &IndexMap<String, crate::LogicId>,
     engine: &crate::RLogic,
@@ -684,6 +839,8 @@ pub fn compile_table_metadata(
 
                     // Pre-compute forward column propagation (transitive closure)
                     let (forward_cols, normal_cols) = compute_column_partitions(&columns);
+                    let row_independent = forward_cols.is_empty()
+                        && !columns_reference_table(engine, &columns, eval_key);
 
                     row_plans.push(RowMetadata::Repeat {
                         start: RepeatBoundMetadata {
@@ -697,6 +854,7 @@ pub fn compile_table_metadata(
                         columns: columns.into(),
                         forward_cols: forward_cols.into(),
                         normal_cols: normal_cols.into(),
+                        row_independent,
                     });
                     continue;
                 }
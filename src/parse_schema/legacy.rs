@@ -3,6 +3,7 @@ use indexmap::IndexMap;
 use serde_json::Value;
 use std::sync::Arc;
 
+use crate::jsoneval::rule_patterns::RulePatterns;
 use crate::{topo_sort, JSONEval};
 
 pub fn parse_schema(lib: &mut JSONEval) -> Result<(), String> {
@@ -62,8 +63,13 @@ pub fn parse_schema(lib: &mut JSONEval) -> Result<(), String> {
     let mut layout_field_refs = indexmap::IndexSet::new();
     crate::parse_schema::common::collect_layout_field_refs(&lib.schema, &mut layout_field_refs);
     lib.layout_field_refs = Arc::new(layout_field_refs);
+    lib.layout_dependencies = Arc::new(crate::parse_schema::common::collect_layout_dependencies(
+        &lib.schema,
+        &lib.layout_paths,
+    ));
     lib.dependents_evaluations = Arc::new(dependents_evaluations);
     lib.options_templates = Arc::new(options_templates);
+    lib.rule_patterns = Arc::new(RulePatterns::compile(&lib.schema, &fields_with_rules));
     lib.fields_with_rules = Arc::new(fields_with_rules);
 
     // Build subforms from collected data (after walk completes)
@@ -73,6 +79,11 @@ pub fn parse_schema(lib: &mut JSONEval) -> Result<(), String> {
     let mut deps = (*lib.dependencies).clone();
     crate::parse_schema::common::collect_table_dependencies(&lib.tables, &mut deps);
     lib.dependencies = std::sync::Arc::new(deps);
+    lib.dependency_ids = Arc::new(
+        lib.eval_cache
+            .paths()
+            .intern_dependencies(&lib.dependencies),
+    );
 
     lib.sorted_evaluations = Arc::new(topo_sort::legacy::topological_sort(lib)?);
 
@@ -173,6 +184,7 @@ fn create_subform(
         Value::Object(subform_schema),
         parent.context.clone(),
         std::sync::Arc::clone(&parent.static_arrays),
+        std::sync::Arc::clone(parent.eval_cache.paths()),
     )
     .map_err(|e| format!("Failed to create subform for {}: {}", field_key, e))?;
 
@@ -2,10 +2,12 @@
 //!
 //! `legacy` keeps the original parser shape used by existing callers.
 //! `parsed` fills reusable [`crate::ParsedSchema`] structures. Public functions
-//! are re-exported here to preserve existing Rust imports.
+//! are re-exported here to preserve existing Rust imports. `parallel` holds the
+//! stages of `parsed` that run on worker threads.
 
 pub mod common;
 pub mod legacy;
+pub mod parallel;
 pub mod parsed;
 
 pub use legacy::parse_schema;
@@ -0,0 +1,252 @@
+//! Parallel stages of `parse_schema_into`.
+//!
+//! Parsing stays a single ordered walk, so the parsed output is identical to a
+//! serial parse; only the independent, expensive work is spread over threads:
+//!
+//! 1. [`precompile_formulas`] collects every formula in one cheap walk and compiles
+//!    them on worker threads into the process-wide compiled-logic store. The walk
+//!    that follows then finds each formula already compiled and assigns local
+//!    `LogicId`s in schema order, exactly as before.
+//! 2. [`map_ordered`] parses subforms on worker threads and hands the results back
+//!    in input order, so they are merged into the subform map in schema order.
+//!
+//! Work started from a worker thread runs serially, so nested subform parses do
+//! not multiply the thread count.
+
+use std::cell::Cell;
+
+use once_cell::sync::Lazy;
+use serde_json::Value;
+
+use crate::parse_schema::common::has_actionable_keys;
+use crate::rlogic::compiled_logic_store::compile_logic_value;
+
+/// Minimum number of formulas each worker must receive before compilation is
+/// split across threads. Smaller schemas compile faster than threads spawn.
+const PARALLEL_FORMULAS_PER_WORKER: usize = 64;
+
+/// Upper bound on worker threads while parsing.
+///
+/// Defaults to the available parallelism; `JSONEVAL_PARSE_THREADS` overrides it
+/// (`1` disables parallel parsing).
+static PARSE_WORKER_LIMIT: Lazy<usize> = Lazy::new(|| {
+    std::env::var("JSONEVAL_PARSE_THREADS")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .filter(|&n| n > 0)
+        .unwrap_or_else(|| {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        })
+});
+
+thread_local! {
+    /// Set on parse worker threads to keep nested parses serial
+    static IN_PARSE_WORKER: Cell<bool> = const { Cell::new(false) };
+}
+
+/// Number of workers for `items` units of work, each worth at least `per_worker`
+#[inline]
+fn parallel_workers(items: usize, per_worker: usize) -> usize {
+    if cfg!(target_arch = "wasm32") || IN_PARSE_WORKER.with(Cell::get) {
+        return 1;
+    }
+    (items / per_worker.max(1)).min(*PARSE_WORKER_LIMIT)
+}
+
+/// Run `f` with parallel parsing disabled on this thread
+#[cfg(test)]
+pub(crate) fn serial<R>(f: impl FnOnce() -> R) -> R {
+    let previous = IN_PARSE_WORKER.with(|flag| flag.replace(true));
+    let result = f();
+    IN_PARSE_WORKER.with(|flag| flag.set(previous));
+    result
+}
+
+/// Apply `f` to every item, on worker threads when there are at least
+/// `per_worker` items per worker, and return the results in input order.
+pub(crate) fn map_ordered<T, R, F>(items: Vec<T>, per_worker: usize, f: F) -> Vec<R>
+where
+    T: Send,
+    R: Send,
+    F: Fn(T) -> R + Sync,
+{
+    let workers = parallel_workers(items.len(), per_worker);
+    if workers <= 1 {
+        return items.into_iter().map(f).collect();
+    }
+
+    let chunk_size = items.len().div_ceil(workers);
+    let mut chunks: Vec<Vec<T>> = Vec::with_capacity(workers);
+    let mut items = items.into_iter();
+    loop {
+        let chunk: Vec<T> = items.by_ref().take(chunk_size).collect();
+        if chunk.is_empty() {
+            break;
+        }
+        chunks.push(chunk);
+    }
+
+    let f = &f;
+    std::thread::scope(|s| {
+        let handles: Vec<_> = chunks
+            .into_iter()
+            .map(|chunk| {
+                s.spawn(move || {
+                    IN_PARSE_WORKER.with(|flag| flag.set(true));
+                    chunk.into_iter().map(f).collect::<Vec<R>>()
+                })
+            })
+            .collect();
+        handles
+            .into_iter()
+            .flat_map(|handle| {
+                // Re-raise a worker panic on the caller, as the serial path would
+                handle
+                    .join()
+                    .unwrap_or_else(|panic| std::panic::resume_unwind(panic))
+            })
+            .collect()
+    })
+}
+
+/// Compile every formula in `schema` into the global compiled-logic store, in
+/// parallel when there are enough of them.
+///
+/// Compile errors are ignored here: the schema walk compiles the same formula
+/// again and reports the error with its path, exactly as a serial parse does.
+pub fn precompile_formulas(schema: &Value) {
+    let mut formulas = Vec::new();
+    collect_formulas(schema, false, &mut formulas);
+    if parallel_workers(formulas.len(), PARALLEL_FORMULAS_PER_WORKER) <= 1 {
+        return;
+    }
+    map_ordered(formulas, PARALLEL_FORMULAS_PER_WORKER, |logic| {
+        let _ = compile_logic_value(logic);
+    });
+}
+
+/// Collect the logic `walk_schema` compiles, following the same traversal. Subform
+/// `items` are included so their formulas are compiled in the same batch.
+/// Anything missed here is simply compiled by the walk itself.
+fn collect_formulas<'a>(value: &'a Value, in_layout: bool, out: &mut Vec<&'a Value>) {
+    match value {
+        Value::Object(map) => {
+            if let Some(evaluation) = map.get("$evaluation") {
+                out.push(evaluation.get("logic").unwrap_or(evaluation));
+            }
+
+            if let Some(Value::Array(dependents)) = map.get("dependents") {
+                for dep_obj in dependents.iter().filter_map(Value::as_object) {
+                    if !dep_obj.get("$ref").is_some_and(Value::is_string) {
+                        continue;
+                    }
+                    for key in ["clear", "value"] {
+                        if let Some(logic) = dep_obj.get(key).and_then(|v| v.get("$evaluation")) {
+                            out.push(logic);
+                        }
+                    }
+                }
+            }
+
+            for (key, val) in map {
+                if key == "$evaluation" || key == "dependents" {
+                    continue;
+                }
+                let in_layout = in_layout || key.contains("$layout") || key.contains("elements");
+                collect_formulas(val, in_layout, out);
+            }
+        }
+        Value::Array(arr) => {
+            if !in_layout && arr.len() > 10 && !has_actionable_keys(value) {
+                return;
+            }
+            for item in arr {
+                collect_formulas(item, in_layout, out);
+            }
+        }
+        _ => {}
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::ParsedSchema;
+    use serde_json::json;
+
+    fn large_schema() -> Value {
+        let mut properties = serde_json::Map::new();
+        properties.insert("base".to_string(), json!({ "type": "number" }));
+        for i in 0..400 {
+            properties.insert(
+                format!("f{}", i),
+                json!({
+                    "type": "number",
+                    "value": { "$evaluation": { "+": [{ "$ref": "#/properties/base" }, i] } }
+                }),
+            );
+        }
+        for i in 0..6 {
+            properties.insert(
+                format!("list{}", i),
+                json!({
+                    "type": "array",
+                    "items": {
+                        "properties": {
+                            "qty": { "type": "number" },
+                            "amount": {
+                                "type": "number",
+                                "value": { "$evaluation": { "*": [{ "$ref": "#/list/properties/qty" }, i] } }
+                            }
+                        }
+                    }
+                }),
+            );
+        }
+        json!({ "type": "object", "properties": properties })
+    }
+
+    #[test]
+    fn map_ordered_keeps_input_order() {
+        let items: Vec<usize> = (0..1000).collect();
+        let doubled = map_ordered(items, 1, |i| i * 2);
+        assert_eq!(doubled, (0..1000).map(|i| i * 2).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn parallel_parse_matches_serial_parse() {
+        let schema = large_schema();
+        let serial = serial(|| ParsedSchema::parse_value(schema.clone())).unwrap();
+        let parallel = ParsedSchema::parse_value(schema).unwrap();
+        assert_eq!(parallel.subforms.len(), 6);
+        assert_eq!(
+            parallel.to_snapshot().unwrap(),
+            serial.to_snapshot().unwrap()
+        );
+    }
+
+    #[test]
+    fn collects_field_and_dependent_formulas() {
+        let schema = json!({
+            "a": {
+                "value": { "$evaluation": { "logic": { "var": "x" } } },
+                "dependents": [
+                    { "$ref": "#/b", "clear": { "$evaluation": { "var": "y" } } },
+                    { "$ref": "#/c", "value": { "$evaluation": { "var": "z" } } }
+                ]
+            }
+        });
+        let mut formulas = Vec::new();
+        collect_formulas(&schema, false, &mut formulas);
+        assert_eq!(
+            formulas,
+            vec![
+                &json!({ "var": "y" }),
+                &json!({ "var": "z" }),
+                &json!({ "var": "x" })
+            ]
+        );
+    }
+}
@@ -3,6 +3,8 @@ use indexmap::{IndexMap, IndexSet};
 use serde_json::Value;
 use std::sync::Arc;
 
+use crate::jsoneval::rule_patterns::RulePatterns;
+use crate::parse_schema::parallel;
 use crate::topo_sort;
 use crate::ParsedSchema;
 
@@ -25,6 +27,10 @@ pub fn parse_schema_into(parsed: &mut ParsedSchema) -> Result<(), String> {
     let mut conditional_hidden_fields = Vec::new();
     let mut conditional_readonly_fields = Vec::new();
 
+    // Compile formulas (including subform formulas) on worker threads first; the
+    // walk below then only assigns local ids, in the same order as a serial parse
+    parallel::precompile_formulas(&parsed.schema);
+
     crate::parse_schema::common::walk_schema(
         &parsed.schema,
         "#",
@@ -60,8 +66,14 @@ pub fn parse_schema_into(parsed: &mut ParsedSchema) -> Result<(), String> {
     let mut layout_field_refs = IndexSet::new();
     crate::parse_schema::common::collect_layout_field_refs(&parsed.schema, &mut layout_field_refs);
     parsed.layout_field_refs = Arc::new(layout_field_refs);
+    parsed.layout_dependencies =
+        Arc::new(crate::parse_schema::common::collect_layout_dependencies(
+            &parsed.schema,
+            &parsed.layout_paths,
+        ));
     parsed.dependents_evaluations = Arc::new(dependents_evaluations);
     parsed.options_templates = Arc::new(options_templates);
+    parsed.rule_patterns = Arc::new(RulePatterns::compile(&parsed.schema, &fields_with_rules));
     parsed.fields_with_rules = Arc::new(fields_with_rules);
 
     // Build subforms from collected data (after walk completes)
@@ -71,6 +83,7 @@ pub fn parse_schema_into(parsed: &mut ParsedSchema) -> Result<(), String> {
     let mut deps = (*parsed.dependencies).clone();
     crate::parse_schema::common::collect_table_dependencies(&parsed.tables, &mut deps);
     parsed.dependencies = std::sync::Arc::new(deps);
+    parsed.dependency_ids = Arc::new(parsed.paths.intern_dependencies(&parsed.dependencies));
 
     parsed.sorted_evaluations = Arc::new(topo_sort::parsed::topological_sort_parsed(parsed)?);
 
@@ -109,14 +122,21 @@ pub fn parse_schema_into(parsed: &mut ParsedSchema) -> Result<(), String> {
 // ============================================================================
 
 /// Build subforms from collected data for ParsedSchema
+///
+/// Subforms are independent, so they are parsed on worker threads and merged in
+/// schema order; the first failing subform (in schema order) is reported.
 fn build_subforms_from_data_parsed(
     subforms_data: Vec<(String, serde_json::Map<String, Value>, Value)>,
     parsed: &ParsedSchema,
 ) -> Result<IndexMap<String, Arc<ParsedSchema>>, String> {
-    let mut subforms = IndexMap::new();
+    let built = parallel::map_ordered(subforms_data, 1, |(path, field_map, items)| {
+        create_subform_parsed(&path, &field_map, &items, parsed).map(|subform| (path, subform))
+    });
 
-    for (path, field_map, items) in subforms_data {
-        create_subform_parsed(&path, &field_map, &items, &mut subforms, parsed)?;
+    let mut subforms = IndexMap::new();
+    for result in built {
+        let (path, subform) = result?;
+        subforms.insert(path, subform);
     }
 
     Ok(subforms)
@@ -130,9 +150,8 @@ fn create_subform_parsed(
     path: &str,
     field_map: &serde_json::Map<String, Value>,
     items: &Value,
-    subforms: &mut IndexMap<String, Arc<ParsedSchema>>,
     parsed: &ParsedSchema,
-) -> Result<(), String> {
+) -> Result<Arc<ParsedSchema>, String> {
     // Extract field key from path (e.g., "#/properties/riders" -> "riders")
     let field_key = path.split('/').last().unwrap_or(path);
 
@@ -175,12 +194,11 @@ fn create_subform_parsed(
     // Parse into ParsedSchema (more efficient than JSONEval)
     // This allows the subform to be shared via Arc across multiple evaluations
     let subform_schema_value = Value::Object(subform_schema);
-    let subform_parsed = ParsedSchema::parse_value(subform_schema_value)
-        .map_err(|e| format!("Failed to parse subform schema for {}: {}", field_key, e))?;
-
-    subforms.insert(path.to_string(), Arc::new(subform_parsed));
+    let subform_parsed =
+        ParsedSchema::parse_value_in(subform_schema_value, Arc::clone(&parsed.paths))
+            .map_err(|e| format!("Failed to parse subform schema for {}: {}", field_key, e))?;
 
-    Ok(())
+    Ok(Arc::new(subform_parsed))
 }
 
 /// Build pre-compiled table metadata (ParsedSchema version)
@@ -1,14 +1,14 @@
 use crate::jsoneval::path_utils;
 use rapidhash::RapidHashMap;
-use serde::Serialize;
+use serde::{Deserialize, Serialize};
 use serde_json::Value;
 
 /// Unique identifier for compiled logic expressions
-#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Serialize)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Serialize, Deserialize)]
 pub struct LogicId(pub(crate) u64);
 
 /// Compiled JSON Logic expression optimized for fast evaluation
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub enum CompiledLogic {
     // Literal values
     Null,
@@ -1687,6 +1687,28 @@ impl CompiledLogicStore {
     pub fn get_dependencies(&self, id: &LogicId) -> Option<&[String]> {
         self.dependencies.get(id).map(|v| v.as_slice())
     }
+
+    /// All entries as (id, logic, dependencies), in id order
+    pub(crate) fn entries(&self) -> Vec<(LogicId, &CompiledLogic, &[String])> {
+        let mut entries: Vec<_> = self
+            .store
+            .iter()
+            .map(|(id, logic)| (*id, logic, self.get_dependencies(id).unwrap_or(&[])))
+            .collect();
+        entries.sort_unstable_by_key(|(id, _, _)| id.0);
+        entries
+    }
+
+    /// Rebuild a store from [`entries`](Self::entries), keeping the ids
+    pub(crate) fn from_entries(entries: Vec<(LogicId, CompiledLogic, Vec<String>)>) -> Self {
+        let mut store = Self::new();
+        for (id, logic, deps) in entries {
+            store.next_id = store.next_id.max(id.0 + 1);
+            store.store.insert(id, logic);
+            store.dependencies.insert(id, deps);
+        }
+        store
+    }
 }
 
 impl Default for CompiledLogicStore {
@@ -38,7 +38,7 @@ static COMPILED_LOGIC_STORE: Lazy<CompiledLogicStore> = Lazy::new(|| {
 /// Recursively hash a serde_json::Value without serializing to string.
 /// Uses type discriminants to avoid hash collisions between different JSON types.
 #[inline]
-fn hash_value(value: &serde_json::Value, hasher: &mut RapidHasher) {
+pub(crate) fn hash_value(value: &serde_json::Value, hasher: &mut RapidHasher) {
     match value {
         serde_json::Value::Null => 0u8.hash(hasher),
         serde_json::Value::Bool(b) => {
@@ -1,9 +1,227 @@
 use super::super::compiled::CompiledLogic;
+use super::columnar::ColumnarTable;
 use super::helpers;
+use super::index::TableIndex;
 use super::{types::*, Evaluator};
+use crate::jsoneval::path_utils;
 use serde_json::Value;
+use std::sync::Arc;
+
+/// Static arrays shorter than this are scanned row by row — building a
+/// projection does not pay off for small tables.
+const COLUMNAR_MIN_ROWS: usize = 32;
+
+/// Static arrays with at least this many rows get sorted / interval range
+/// indexes on first use by a ranged INDEXAT or a single-band MATCHRANGE.
+const RANGE_INDEX_MIN_ROWS: usize = 64;
 
 impl Evaluator {
+    /// Key of the static array named by `table_expr`, directly or through a
+    /// `$static_array` marker in `user_data`. Self-table references never qualify.
+    fn static_array_key<'a>(
+        &'a self,
+        table_expr: &'a CompiledLogic,
+        user_data: &'a Value,
+    ) -> Option<&'a str> {
+        let arrays = self.static_arrays.as_ref()?;
+        let name = match table_expr {
+            CompiledLogic::Var(name, _) | CompiledLogic::Ref(name, _) => name.as_str(),
+            _ => return None,
+        };
+        if name.is_empty() || self.table_scope_rows(name).is_some() {
+            return None;
+        }
+
+        if arrays.contains_key(name) {
+            return Some(name);
+        }
+        match path_utils::get_value_by_pointer_without_properties(user_data, name)?
+            .get("$static_array")?
+        {
+            Value::String(path) if arrays.contains_key(path.as_str()) => Some(path.as_str()),
+            _ => None,
+        }
+    }
+
+    /// Columnar projection of the static array named by `table_expr`.
+    ///
+    /// Only `Var`/`Ref` tables that resolve to an extracted static array (directly or
+    /// through a `$static_array` marker) qualify: their contents are immutable for the
+    /// lifetime of the evaluator, so the projection is built once and cached.
+    pub(super) fn columnar_table(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+    ) -> Option<Arc<ColumnarTable>> {
+        let arrays = self.static_arrays.as_ref()?;
+        let key = self.static_array_key(table_expr, user_data)?;
+
+        if let Ok(cache) = self.columnar.read() {
+            if let Some(entry) = cache.get(key) {
+                return entry.clone();
+            }
+        }
+
+        let rows = arrays.get(key)?.as_array()?;
+        let built = if rows.len() >= COLUMNAR_MIN_ROWS {
+            ColumnarTable::from_rows(rows).map(Arc::new)
+        } else {
+            None
+        };
+        if let Ok(mut cache) = self.columnar.write() {
+            cache.insert(key.to_string(), built.clone());
+        }
+        built
+    }
+
+    /// First row matching the `(value, field)` equality conditions — all of them,
+    /// or any of them when `any` is set — using the columnar projection.
+    ///
+    /// Returns `None` when the projection cannot answer (not a static array, or a
+    /// mixed-type column) and the caller must scan rows.
+    pub(super) fn columnar_match(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        conditions: &[(Value, String)],
+        any: bool,
+    ) -> Option<Option<usize>> {
+        let table = self.columnar_table(table_expr, user_data)?;
+        let filters = conditions
+            .iter()
+            .map(|(value, field)| table.eq_filter(field, value))
+            .collect::<Option<Vec<_>>>()?;
+        Some(if any {
+            table.first_match_any(&filters)
+        } else {
+            table.first_match_all(&filters)
+        })
+    }
+
+    /// First row whose `field` cell loosely equals `lookup` (INDEXAT exact mode),
+    /// using the columnar projection. `None` when the caller must scan rows.
+    pub(super) fn columnar_first_equal(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        field: &str,
+        lookup: &Value,
+    ) -> Option<Option<usize>> {
+        let table = self.columnar_table(table_expr, user_data)?;
+        let filter = table.eq_filter(field, lookup)?;
+        Some(table.first_match_all(std::slice::from_ref(&filter)))
+    }
+
+    /// First row where every `(min_col, max_col, check)` range holds, using the
+    /// columnar projection. `None` when the caller must scan rows.
+    pub(super) fn columnar_matchrange(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        conditions: &[(String, String, f64)],
+    ) -> Option<Option<usize>> {
+        let table = self.columnar_table(table_expr, user_data)?;
+        let ranges = conditions
+            .iter()
+            .map(|(min_col, max_col, check)| {
+                Some((table.numeric(min_col)?, table.numeric(max_col)?, *check))
+            })
+            .collect::<Option<Vec<_>>>()?;
+        Some(table.first_in_ranges(&ranges))
+    }
+
+    /// First row whose `field` cell is `<= lookup` (INDEXAT range mode), using the
+    /// columnar projection. `None` when the caller must scan rows.
+    pub(super) fn columnar_first_at_most(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        field: &str,
+        lookup: f64,
+    ) -> Option<Option<usize>> {
+        let table = self.columnar_table(table_expr, user_data)?;
+        let view = table.numeric(field)?;
+        Some(table.first_at_most(&view, lookup))
+    }
+
+    /// Answer `query` from the range index of the static array named by `table_expr`,
+    /// running `ensure` under the write lock to build the structure on first use.
+    /// `None` when the table does not qualify and the caller must fall back.
+    fn with_range_index(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        ensure: impl FnOnce(&mut TableIndex, &[Value]),
+        query: impl Fn(&TableIndex) -> Option<Option<usize>>,
+    ) -> Option<Option<usize>> {
+        let arrays = self.static_arrays.as_ref()?;
+        let key = self.static_array_key(table_expr, user_data)?;
+
+        if let Ok(indices) = self.indices.read() {
+            if let Some(found) = indices.get(key).and_then(&query) {
+                return Some(found);
+            }
+        }
+
+        let rows = arrays.get(key)?.as_array()?;
+        if rows.len() < RANGE_INDEX_MIN_ROWS {
+            return None;
+        }
+        let mut indices = self.indices.write().ok()?;
+        let index = indices
+            .entry(key.to_string())
+            .or_insert_with(|| TableIndex::range_only(rows.len()));
+        ensure(index, rows);
+        query(index)
+    }
+
+    /// First row whose `field` cell is `<= lookup` (INDEXAT range mode): binary
+    /// search on the sorted column for large static arrays, else a columnar scan.
+    pub(super) fn indexed_first_at_most(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        field: &str,
+        lookup: f64,
+    ) -> Option<Option<usize>> {
+        self.with_range_index(
+            table_expr,
+            user_data,
+            |index, rows| index.ensure_sorted(rows, field),
+            |index| index.first_at_most(field, lookup),
+        )
+        .or_else(|| self.columnar_first_at_most(table_expr, user_data, field, lookup))
+    }
+
+    /// First row where every `(min_col, max_col, check)` range holds (MATCHRANGE):
+    /// an interval-index stabbing query for a single band over a large static
+    /// array, else a columnar scan.
+    pub(super) fn indexed_matchrange(
+        &self,
+        table_expr: &CompiledLogic,
+        user_data: &Value,
+        conditions: &[(String, String, f64)],
+    ) -> Option<Option<usize>> {
+        if let [(min_col, max_col, check)] = conditions {
+            let found = self.with_range_index(
+                table_expr,
+                user_data,
+                |index, rows| index.ensure_band(rows, min_col, max_col),
+                |index| index.first_in_band(min_col, max_col, *check),
+            );
+            if found.is_some() {
+                return found;
+            }
+        }
+        self.columnar_matchrange(table_expr, user_data, conditions)
+    }
+
+    /// Convert a columnar lookup result into the `-1`-for-missing index value
+    #[inline]
+    fn row_index_to_json(&self, row: Option<usize>) -> Value {
+        self.f64_to_json(row.map_or(-1.0, |idx| idx as f64))
+    }
+
     /// Resolve table reference directly - ZERO-COPY with optimized lookup
     #[inline]
     pub(super) fn resolve_table_ref<'a>(
@@ -20,14 +238,8 @@ impl Evaluator {
         };
 
         if let Some(name) = var_name {
-            // SAFETY: single-threaded (eval_lock), UnsafeCell access
-            let scope = unsafe { &*self.table_scope.get() };
-            if let Some(ts) = scope.as_ref() {
-                if name == ts.path {
-                    // SAFETY: local_rows outlives this call (table_evaluate_inner scope)
-                    let rows = unsafe { &*ts.rows };
-                    return Ok(TableRef::LocalRows(rows));
-                }
+            if let Some(rows) = self.table_scope_rows(name) {
+                return Ok(TableRef::LocalRows(rows));
             }
         }
 
@@ -273,16 +485,11 @@ impl Evaluator {
 
             if let Some(name) = table_name {
                 if let Ok(indices) = self.indices.read() {
-                    if let Some(index) = indices.get(name) {
-                        if index.has_column(&field_name) {
-                            if let Some(rows) = index.lookup(&field_name, &lookup_val) {
-                                if let Some(min_idx) = rows.iter().min() {
-                                    return Ok(self.f64_to_json(*min_idx as f64));
-                                }
-                            } else {
-                                return Ok(self.f64_to_json(-1.0));
-                            }
-                        }
+                    if let Some(rows) = indices
+                        .get(name)
+                        .and_then(|index| index.lookup(&field_name, &lookup_val))
+                    {
+                        return Ok(self.row_index_to_json(rows.first()));
                     }
                 }
             }
@@ -300,6 +507,15 @@ impl Evaluator {
             0.0
         };
 
+        let columnar_row = if is_range {
+            self.indexed_first_at_most(table_expr, user_data, &field_name, lookup_num)
+        } else {
+            self.columnar_first_equal(table_expr, user_data, &field_name, &lookup_val)
+        };
+        if let Some(row) = columnar_row {
+            return Ok(self.row_index_to_json(row));
+        }
+
         if is_range {
             for (idx, row) in arr.iter().enumerate() {
                 if let Value::Object(obj) = row {
@@ -358,67 +574,22 @@ impl Evaluator {
 
         if let Some(name) = table_name {
             if let Ok(indices) = self.indices.read() {
-                if let Some(index) = indices.get(name) {
-                    // We have an index for this table!
-
-                    // 1. Check if all columns in conditions are indexed
-                    let all_columns_indexed = evaluated_conditions
-                        .iter()
-                        .all(|(_, field)| index.has_column(field));
-
-                    if all_columns_indexed {
-                        // 2. Perform intersection of matching row indices
-                        let mut candidate_rows: Option<std::collections::HashSet<usize>> = None;
-
-                        for (val, field) in &evaluated_conditions {
-                            if let Some(rows) = index.lookup(field, val) {
-                                if let Some(candidates) = &mut candidate_rows {
-                                    // Intersect with existing candidates
-                                    candidates.retain(|r| rows.contains(r));
-                                    if candidates.is_empty() {
-                                        return Ok(self.f64_to_json(-1.0));
-                                    }
-                                } else {
-                                    // Initialize candidates
-                                    // We clone here because we need to mutate the set for intersection
-                                    // but AHashSet clone is relatively cheap compared to iteration
-                                    candidate_rows = Some(rows.iter().cloned().collect());
-                                }
-                            } else {
-                                // Value not found in this column -> no match possible
-                                return Ok(self.f64_to_json(-1.0));
-                            }
-                        }
-
-                        // 3. Return the first matching row index (min)
-                        if let Some(candidates) = candidate_rows {
-                            if let Some(min_idx) = candidates.iter().min() {
-                                return Ok(self.f64_to_json(*min_idx as f64));
-                            }
-                        } else {
-                            // No conditions provided? Technically logic allows it, but usually conditions exist.
-                            // If no conditions, match returns first row?
-                            // Logic usually implies "match based on conditions".
-                            // If conditions empty, existing logic returns -1 (or loops 0 times).
-                            // Let's stick to existing behavior if processed conditions is empty
-                            if conditions.is_empty() {
-                                // Fall through to standard logic (which returns -1)
-                            } else if index.len() > 0 {
-                                // If we had conditions but they were all filtered out (e.g. invalid format)
-                                // fall through.
-                                // But here evaluated_conditions is populated.
-                                // If evaluated_conditions is empty but conditions wasn't, it means format error.
-                                // If evaluated_conditions is not empty, candidate_rows would be Some.
-                                // So this block is reached only if evaluated_conditions is empty.
-                            }
-                        }
-                    }
+                if let Some(found) = indices
+                    .get(name)
+                    .and_then(|index| index.first_match_all(&evaluated_conditions))
+                {
+                    return Ok(self.row_index_to_json(found));
                 }
             }
         }
 
         let table_ref = self.get_table_array(table_expr, user_data, internal_context, depth)?;
 
+        if let Some(row) = self.columnar_match(table_expr, user_data, &evaluated_conditions, false)
+        {
+            return Ok(self.row_index_to_json(row));
+        }
+
         if let Some(arr) = table_ref.as_array() {
             for (idx, row) in arr.iter().enumerate() {
                 if let Value::Object(obj) = row {
@@ -468,6 +639,10 @@ impl Evaluator {
             }
         }
 
+        if let Some(row) = self.indexed_matchrange(table_expr, user_data, &evaluated_conditions) {
+            return Ok(self.row_index_to_json(row));
+        }
+
         if let Some(arr) = table_ref.as_array() {
             for (idx, row) in arr.iter().enumerate() {
                 if let Value::Object(obj) = row {
@@ -520,6 +695,10 @@ impl Evaluator {
             }
         }
 
+        if let Some(row) = self.columnar_match(table_expr, user_data, &evaluated_conditions, true) {
+            return Ok(self.row_index_to_json(row));
+        }
+
         if let Some(arr) = table_ref.as_array() {
             for (idx, row) in arr.iter().enumerate() {
                 if let Value::Object(obj) = row {
@@ -639,37 +818,23 @@ impl Evaluator {
 
             if let Some(name) = table_name {
                 if let Ok(indices) = self.indices.read() {
-                    if let Some(index) = indices.get(name) {
-                        let all_columns_indexed = evaluated_match_conditions
-                            .iter()
-                            .all(|(_, field)| index.has_column(field));
-                        if all_columns_indexed {
-                            let mut candidate_rows: Option<std::collections::HashSet<usize>> = None;
-                            for (val, field) in &evaluated_match_conditions {
-                                if let Some(rows) = index.lookup(field, val) {
-                                    if let Some(candidates) = &mut candidate_rows {
-                                        candidates.retain(|r| rows.contains(r));
-                                        if candidates.is_empty() {
-                                            return Ok(self.f64_to_json(-1.0));
-                                        }
-                                    } else {
-                                        candidate_rows = Some(rows.iter().cloned().collect());
-                                    }
-                                } else {
-                                    return Ok(self.f64_to_json(-1.0));
-                                }
-                            }
-                            if let Some(candidates) = candidate_rows {
-                                if let Some(min_idx) = candidates.iter().min() {
-                                    return Ok(self.f64_to_json(*min_idx as f64));
-                                }
-                            }
-                        }
+                    if let Some(found) = indices
+                        .get(name)
+                        .and_then(|index| index.first_match_all(&evaluated_match_conditions))
+                    {
+                        return Ok(self.row_index_to_json(found));
                     }
                 }
             }
 
-            // 2. Fallback to `O(N)` loop using direct column GET instead of eval_condition_with_row
+            // 2. Columnar scan for static arrays
+            if let Some(row) =
+                self.columnar_match(table_expr, user_data, &evaluated_match_conditions, false)
+            {
+                return Ok(self.row_index_to_json(row));
+            }
+
+            // 3. Fallback to `O(N)` loop using direct column GET instead of eval_condition_with_row
             for (idx, row) in arr.iter().enumerate() {
                 if let Value::Object(obj) = row {
                     let all_match = evaluated_match_conditions.iter().all(|(value_val, field)| {
@@ -0,0 +1,470 @@
+use super::helpers;
+use super::simd::{self, BLOCK};
+use rapidhash::{HashMapExt, RapidHashMap};
+use serde_json::Value;
+use std::sync::Arc;
+
+/// Sentinel dictionary code for a missing or null text cell
+const NO_CODE: u32 = u32::MAX;
+
+/// Fixed-size bitmap with one bit per table row
+#[derive(Debug, Clone, Default)]
+pub struct Bitmap {
+    words: Vec<u64>,
+}
+
+impl Bitmap {
+    pub fn new(len: usize) -> Self {
+        Self {
+            words: vec![0; len.div_ceil(64)],
+        }
+    }
+
+    #[inline(always)]
+    pub fn set(&mut self, idx: usize) {
+        self.words[idx / 64] |= 1u64 << (idx % 64);
+    }
+
+    #[inline(always)]
+    pub fn get(&self, idx: usize) -> bool {
+        self.words[idx / 64] & (1u64 << (idx % 64)) != 0
+    }
+
+    /// Bits for rows `block * 64 .. block * 64 + 64`
+    #[inline(always)]
+    pub fn word(&self, block: usize) -> u64 {
+        self.words[block]
+    }
+}
+
+/// Type-specialized storage for one column of a table
+#[derive(Debug, Clone)]
+pub enum Column {
+    /// Every present, non-null cell is a JSON number.
+    /// Missing and null cells hold `0.0` — the value `to_number` gives them.
+    Number {
+        values: Vec<f64>,
+        valid: Bitmap,
+        nulls: Bitmap,
+    },
+    /// Every present, non-null cell is a string, dictionary-encoded.
+    /// Missing and null cells hold `NO_CODE`.
+    Text {
+        codes: Vec<u32>,
+        dict: Vec<Arc<str>>,
+        dict_index: RapidHashMap<Arc<str>, u32>,
+        /// `to_number` of each dictionary entry, for range scans
+        dict_numbers: Vec<f64>,
+        nulls: Bitmap,
+    },
+    /// Booleans, nested values or mixed cell types — callers fall back to row scans
+    Mixed,
+}
+
+/// Columnar projection of a static table (array of objects).
+///
+/// Column names are interned once, numeric columns are dense `Vec<f64>` and
+/// string columns are dictionary-encoded, so lookups scan contiguous memory
+/// instead of hashing the column name in every row object.
+#[derive(Debug, Clone)]
+pub struct ColumnarTable {
+    names: RapidHashMap<Arc<str>, usize>,
+    columns: Vec<Column>,
+    row_count: usize,
+}
+
+/// Equality condition against one column, pre-resolved for the lookup value
+/// with `loose_equal` semantics.
+pub enum EqFilter<'a> {
+    /// No row can match (missing column or incomparable lookup)
+    Never,
+    /// Rows whose cell is an explicit null (lookup is null)
+    Null(&'a Bitmap),
+    Number {
+        values: &'a [f64],
+        valid: &'a Bitmap,
+        target: f64,
+    },
+    Text {
+        codes: &'a [u32],
+        /// Dictionary codes that compare loosely equal to the lookup value
+        accepted: Vec<bool>,
+    },
+}
+
+impl EqFilter<'_> {
+    /// Match bitmask for rows `start..end` of mask block `block`
+    #[inline]
+    pub fn block_mask(&self, block: usize, start: usize, end: usize) -> u64 {
+        match self {
+            EqFilter::Never => 0,
+            EqFilter::Null(nulls) => nulls.word(block),
+            EqFilter::Number {
+                values,
+                valid,
+                target,
+            } => simd::eq_mask(&values[start..end], *target) & valid.word(block),
+            EqFilter::Text { codes, accepted } => {
+                let mut mask = 0u64;
+                for (i, &code) in codes[start..end].iter().enumerate() {
+                    let hit = code != NO_CODE && accepted[code as usize];
+                    mask |= (hit as u64) << i;
+                }
+                mask
+            }
+        }
+    }
+}
+
+/// Numeric view of one column: `to_number(cell)`, with `0.0` for missing cells
+pub enum NumericView<'a> {
+    /// Column absent from every row
+    Absent,
+    Number {
+        values: &'a [f64],
+        valid: &'a Bitmap,
+        nulls: &'a Bitmap,
+    },
+    Text {
+        codes: &'a [u32],
+        dict_numbers: &'a [f64],
+        nulls: &'a Bitmap,
+    },
+}
+
+impl NumericView<'_> {
+    /// Contiguous `to_number` values for rows `start..end`. Number columns are
+    /// borrowed in place; text and absent columns are materialized into `buf`.
+    #[inline]
+    pub fn block_values<'s>(
+        &'s self,
+        start: usize,
+        end: usize,
+        buf: &'s mut [f64; BLOCK],
+    ) -> &'s [f64] {
+        match self {
+            NumericView::Number { values, .. } => &values[start..end],
+            NumericView::Absent => {
+                buf.fill(0.0);
+                &buf[..end - start]
+            }
+            NumericView::Text {
+                codes,
+                dict_numbers,
+                ..
+            } => {
+                for (slot, &code) in buf.iter_mut().zip(&codes[start..end]) {
+                    *slot = match code {
+                        NO_CODE => 0.0,
+                        code => dict_numbers[code as usize],
+                    };
+                }
+                &buf[..end - start]
+            }
+        }
+    }
+
+    /// `has_cell` bitmask for rows `start..end` of mask block `block`
+    #[inline]
+    pub fn cell_mask(&self, block: usize, start: usize, end: usize) -> u64 {
+        match self {
+            NumericView::Absent => 0,
+            NumericView::Number { valid, nulls, .. } => valid.word(block) | nulls.word(block),
+            NumericView::Text { codes, nulls, .. } => {
+                let mut mask = nulls.word(block);
+                for (i, &code) in codes[start..end].iter().enumerate() {
+                    mask |= ((code != NO_CODE) as u64) << i;
+                }
+                mask
+            }
+        }
+    }
+}
+
+/// Cell type seen while classifying a column
+#[derive(Clone, Copy, PartialEq)]
+enum CellKind {
+    Unknown,
+    Number,
+    Text,
+    Mixed,
+}
+
+impl ColumnarTable {
+    /// Build a columnar projection. Returns `None` unless every row is an object.
+    pub fn from_rows(rows: &[Value]) -> Option<Self> {
+        let row_count = rows.len();
+        let mut names: RapidHashMap<Arc<str>, usize> = RapidHashMap::new();
+        let mut kinds: Vec<CellKind> = Vec::new();
+
+        // Pass 1: intern column names and classify cell types
+        for row in rows {
+            let obj = row.as_object()?;
+            for (key, cell) in obj {
+                let idx = match names.get(key.as_str()) {
+                    Some(&idx) => idx,
+                    None => {
+                        names.insert(Arc::from(key.as_str()), kinds.len());
+                        kinds.push(CellKind::Unknown);
+                        kinds.len() - 1
+                    }
+                };
+                let seen = match cell {
+                    Value::Null => continue,
+                    Value::Number(_) => CellKind::Number,
+                    Value::String(_) => CellKind::Text,
+                    _ => CellKind::Mixed,
+                };
+                kinds[idx] = match kinds[idx] {
+                    CellKind::Unknown => seen,
+                    kind if kind == seen => kind,
+                    _ => CellKind::Mixed,
+                };
+            }
+        }
+
+        // Pass 2: fill type-specialized storage
+        let mut columns: Vec<Column> = kinds
+            .iter()
+            .map(|kind| match kind {
+                CellKind::Number | CellKind::Unknown => Column::Number {
+                    values: vec![0.0; row_count],
+                    valid: Bitmap::new(row_count),
+                    nulls: Bitmap::new(row_count),
+                },
+                CellKind::Text => Column::Text {
+                    codes: vec![NO_CODE; row_count],
+                    dict: Vec::new(),
+                    dict_index: RapidHashMap::new(),
+                    dict_numbers: Vec::new(),
+                    nulls: Bitmap::new(row_count),
+                },
+                CellKind::Mixed => Column::Mixed,
+            })
+            .collect();
+
+        for (row_idx, row) in rows.iter().enumerate() {
+            let Value::Object(obj) = row else { continue };
+            for (key, cell) in obj {
+                let col_idx = names[key.as_str()];
+                match (&mut columns[col_idx], cell) {
+                    (Column::Number { nulls, .. }, Value::Null)
+                    | (Column::Text { nulls, .. }, Value::Null) => nulls.set(row_idx),
+                    (Column::Number { values, valid, .. }, Value::Number(n)) => {
+                        values[row_idx] = n.as_f64().unwrap_or(0.0);
+                        valid.set(row_idx);
+                    }
+                    (
+                        Column::Text {
+                            codes,
+                            dict,
+                            dict_index,
+                            dict_numbers,
+                            ..
+                        },
+                        Value::String(s),
+                    ) => {
+                        let code = match dict_index.get(s.as_str()) {
+                            Some(&code) => code,
+                            None => {
+                                let code = dict.len() as u32;
+                                let entry: Arc<str> = Arc::from(s.as_str());
+                                dict.push(Arc::clone(&entry));
+                                dict_index.insert(entry, code);
+                                dict_numbers.push(s.parse::<f64>().unwrap_or(0.0));
+                                code
+                            }
+                        };
+                        codes[row_idx] = code;
+                    }
+                    _ => {}
+                }
+            }
+        }
+
+        Some(Self {
+            names,
+            columns,
+            row_count,
+        })
+    }
+
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.row_count
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.row_count == 0
+    }
+
+    /// Equality filter for `lookup == cell` (`loose_equal`).
+    /// Returns `None` for mixed-type columns, which must be scanned row by row.
+    pub fn eq_filter(&self, col_name: &str, lookup: &Value) -> Option<EqFilter<'_>> {
+        let Some(&col_idx) = self.names.get(col_name) else {
+            return Some(EqFilter::Never);
+        };
+        let column = &self.columns[col_idx];
+        if matches!(column, Column::Mixed) {
+            return None;
+        }
+        if let (Value::Null, Column::Number { nulls, .. } | Column::Text { nulls, .. }) =
+            (lookup, column)
+        {
+            return Some(EqFilter::Null(nulls));
+        }
+
+        Some(match column {
+            Column::Number { values, valid, .. } => {
+                // loose_equal(lookup, Number(x)) reduces to x == to-number(lookup)
+                let target = match lookup {
+                    Value::Number(n) => Some(n.as_f64().unwrap_or(0.0)),
+                    Value::String(s) => helpers::parse_string_to_f64(s),
+                    Value::Bool(b) => Some(if *b { 1.0 } else { 0.0 }),
+                    _ => None,
+                };
+                match target {
+                    Some(target) => EqFilter::Number {
+                        values,
+                        valid,
+                        target,
+                    },
+                    None => EqFilter::Never,
+                }
+            }
+            Column::Text {
+                codes,
+                dict,
+                dict_index,
+                ..
+            } => {
+                let mut accepted = vec![false; dict.len()];
+                match lookup {
+                    Value::String(s) => {
+                        if let Some(&code) = dict_index.get(s.as_str()) {
+                            accepted[code as usize] = true;
+                        }
+                    }
+                    Value::Number(_) | Value::Bool(_) => {
+                        for (code, entry) in dict.iter().enumerate() {
+                            accepted[code] =
+                                helpers::loose_equal(lookup, &Value::String(entry.to_string()));
+                        }
+                    }
+                    _ => return Some(EqFilter::Never),
+                }
+                EqFilter::Text { codes, accepted }
+            }
+            Column::Mixed => unreachable!(),
+        })
+    }
+
+    /// Numeric view of a column (`to_number` semantics). `None` for mixed columns.
+    pub fn numeric(&self, col_name: &str) -> Option<NumericView<'_>> {
+        let Some(&col_idx) = self.names.get(col_name) else {
+            return Some(NumericView::Absent);
+        };
+        match &self.columns[col_idx] {
+            Column::Number {
+                values,
+                valid,
+                nulls,
+            } => Some(NumericView::Number {
+                values,
+                valid,
+                nulls,
+            }),
+            Column::Text {
+                codes,
+                dict_numbers,
+                nulls,
+                ..
+            } => Some(NumericView::Text {
+                codes,
+                dict_numbers,
+                nulls,
+            }),
+            Column::Mixed => None,
+        }
+    }
+
+    /// Row range and valid-row mask of each 64-row mask block
+    #[inline]
+    fn blocks(&self) -> impl Iterator<Item = (usize, usize, usize, u64)> {
+        let row_count = self.row_count;
+        (0..row_count.div_ceil(BLOCK)).map(move |block| {
+            let start = block * BLOCK;
+            let end = (start + BLOCK).min(row_count);
+            (block, start, end, simd::tail_mask(end - start))
+        })
+    }
+
+    /// First row matching ALL filters (MATCH / FINDINDEX semantics).
+    /// Per-filter block masks are AND-combined; a block is abandoned as soon
+    /// as its combined mask is empty.
+    pub fn first_match_all(&self, filters: &[EqFilter]) -> Option<usize> {
+        for (block, start, end, mut mask) in self.blocks() {
+            for filter in filters {
+                mask &= filter.block_mask(block, start, end);
+                if mask == 0 {
+                    break;
+                }
+            }
+            if mask != 0 {
+                return Some(start + mask.trailing_zeros() as usize);
+            }
+        }
+        None
+    }
+
+    /// First row matching ANY filter (CHOOSE semantics)
+    pub fn first_match_any(&self, filters: &[EqFilter]) -> Option<usize> {
+        for (block, start, end, valid) in self.blocks() {
+            let mut mask = 0u64;
+            for filter in filters {
+                mask |= filter.block_mask(block, start, end);
+            }
+            mask &= valid;
+            if mask != 0 {
+                return Some(start + mask.trailing_zeros() as usize);
+            }
+        }
+        None
+    }
+
+    /// First row where every `min <= check <= max` holds (MATCHRANGE semantics)
+    pub fn first_in_ranges(&self, ranges: &[(NumericView, NumericView, f64)]) -> Option<usize> {
+        let mut min_buf = [0.0; BLOCK];
+        let mut max_buf = [0.0; BLOCK];
+        for (_, start, end, mut mask) in self.blocks() {
+            for (min, max, check) in ranges {
+                let lo = min.block_values(start, end, &mut min_buf);
+                let hi = max.block_values(start, end, &mut max_buf);
+                mask &= simd::range_mask(lo, hi, *check);
+                if mask == 0 {
+                    break;
+                }
+            }
+            if mask != 0 {
+                return Some(start + mask.trailing_zeros() as usize);
+            }
+        }
+        None
+    }
+
+    /// First row whose cell is present and `<= lookup` (INDEXAT range semantics)
+    pub fn first_at_most(&self, view: &NumericView, lookup: f64) -> Option<usize> {
+        let mut buf = [0.0; BLOCK];
+        for (block, start, end, valid) in self.blocks() {
+            let mut mask = valid & view.cell_mask(block, start, end);
+            if mask != 0 {
+                mask &= simd::le_mask(view.block_values(start, end, &mut buf), lookup);
+            }
+            if mask != 0 {
+                return Some(start + mask.trailing_zeros() as usize);
+            }
+        }
+        None
+    }
+}
@@ -104,20 +104,10 @@ impl Evaluator {
 
         // Fast intercept for self-table current row reference
         if name.starts_with("/$") {
-            // SAFETY: single-threaded (eval_lock held during this scope), UnsafeCell
-            let scope = unsafe { &*self.table_scope.get() };
-            if let Some(ts) = scope.as_ref() {
-                if let Some(row_idx) = ts.current_row {
-                    let field = &name[2..]; // e.g., "POL_YEAR"
-                                            // SAFETY: local_rows outlives this evaluation frame
-                    let rows = unsafe { &*ts.rows };
-                    if let Some(row) = rows.get(row_idx) {
-                        if let Value::Object(obj) = row {
-                            if let Some(cell) = obj.get(field) {
-                                return Some(cell);
-                            }
-                        }
-                    }
+            if let Some(Value::Object(obj)) = self.table_scope_current_row() {
+                let field = &name[2..]; // e.g., "POL_YEAR"
+                if let Some(cell) = obj.get(field) {
+                    return Some(cell);
                 }
             }
         }
@@ -1,13 +1,312 @@
 use super::helpers;
-use rapidhash::{HashMapExt, RapidHashMap, RapidHashSet};
+use rapidhash::{HashMapExt, HashSetExt, RapidHashMap, RapidHashSet};
 use serde_json::Value;
+use smallvec::SmallVec;
+use std::sync::Arc;
+
+/// Row indices holding one key, ascending
+type RowList = Vec<u32>;
+
+/// Hash key for a number under `loose_equal`: `-0.0` folds into `0.0`,
+/// NaN never equals anything and gets no key
+#[inline(always)]
+fn number_key(num: f64) -> Option<u64> {
+    (!num.is_nan()).then(|| (num + 0.0).to_bits())
+}
+
+/// Exact-match index of one column.
+///
+/// Cells are bucketed by type with typed keys, so neither building nor
+/// probing formats values into strings. Probes combine the buckets that
+/// `loose_equal` can match (e.g. `1` matches `1`, `"1"` and `true`).
+#[derive(Debug, Clone, Default)]
+struct ColumnIndex {
+    /// Number cells, by `number_key`
+    numbers: RapidHashMap<u64, RowList>,
+    /// String cells, by interned text
+    strings: RapidHashMap<Arc<str>, RowList>,
+    /// String cells that parse as numbers, by `number_key` of the parsed value
+    numeric_strings: RapidHashMap<u64, RowList>,
+    trues: RowList,
+    falses: RowList,
+    nulls: RowList,
+}
+
+impl ColumnIndex {
+    fn insert(&mut self, row_idx: u32, cell: &Value, interner: &mut RapidHashSet<Arc<str>>) {
+        match cell {
+            Value::Null => self.nulls.push(row_idx),
+            Value::Bool(true) => self.trues.push(row_idx),
+            Value::Bool(false) => self.falses.push(row_idx),
+            Value::Number(n) => {
+                if let Some(key) = number_key(n.as_f64().unwrap_or(0.0)) {
+                    self.numbers.entry(key).or_default().push(row_idx);
+                }
+            }
+            Value::String(s) => {
+                if let Some(rows) = self.strings.get_mut(s.as_str()) {
+                    rows.push(row_idx);
+                } else {
+                    let text = match interner.get(s.as_str()) {
+                        Some(text) => Arc::clone(text),
+                        None => {
+                            let text: Arc<str> = Arc::from(s.as_str());
+                            interner.insert(Arc::clone(&text));
+                            text
+                        }
+                    };
+                    self.strings.insert(text, vec![row_idx]);
+                }
+                if let Some(key) = helpers::parse_string_to_f64(s).and_then(number_key) {
+                    self.numeric_strings.entry(key).or_default().push(row_idx);
+                }
+            }
+            // Arrays and objects only equal themselves strictly; probes for them fall back
+            _ => {}
+        }
+    }
+
+    /// Bool bucket for a number that loosely equals `true` (1) or `false` (0)
+    #[inline]
+    fn bool_rows(&self, num: f64) -> &[u32] {
+        if num == 1.0 {
+            &self.trues
+        } else if num == 0.0 {
+            &self.falses
+        } else {
+            &[]
+        }
+    }
+
+    /// Rows whose cell loosely equals `value`. `None` for array/object probes.
+    fn lookup(&self, value: &Value) -> Option<RowMatch<'_>> {
+        let lists: [&[u32]; 3] = match value {
+            Value::Null => [self.nulls.as_slice(), &[], &[]],
+            Value::Bool(b) => {
+                let num = if *b { 1.0 } else { 0.0 };
+                [
+                    self.bool_rows(num),
+                    rows_by_number(&self.numbers, num),
+                    rows_by_number(&self.numeric_strings, num),
+                ]
+            }
+            Value::Number(n) => {
+                let num = n.as_f64().unwrap_or(0.0);
+                [
+                    rows_by_number(&self.numbers, num),
+                    rows_by_number(&self.numeric_strings, num),
+                    self.bool_rows(num),
+                ]
+            }
+            Value::String(s) => {
+                let exact = self.strings.get(s.as_str()).map_or(&[][..], Vec::as_slice);
+                match helpers::parse_string_to_f64(s) {
+                    Some(num) => [
+                        exact,
+                        rows_by_number(&self.numbers, num),
+                        self.bool_rows(num),
+                    ],
+                    None => [exact, &[], &[]],
+                }
+            }
+            _ => return None,
+        };
+        Some(RowMatch { lists })
+    }
+}
+
+#[inline]
+fn rows_by_number(map: &RapidHashMap<u64, RowList>, num: f64) -> &[u32] {
+    number_key(num)
+        .and_then(|key| map.get(&key))
+        .map_or(&[][..], Vec::as_slice)
+}
+
+/// Rows matching one probe: the union of up to three ascending row lists
+#[derive(Debug, Clone, Copy)]
+pub struct RowMatch<'a> {
+    lists: [&'a [u32]; 3],
+}
+
+impl RowMatch<'_> {
+    /// Lowest matching row
+    #[inline]
+    pub fn first(&self) -> Option<usize> {
+        self.lists
+            .iter()
+            .filter_map(|rows| rows.first())
+            .min()
+            .map(|&row| row as usize)
+    }
+
+    #[inline]
+    pub fn contains(&self, row: u32) -> bool {
+        self.lists
+            .iter()
+            .any(|rows| rows.binary_search(&row).is_ok())
+    }
+
+    /// Upper bound on the number of matching rows
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.lists.iter().map(|rows| rows.len()).sum()
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+}
+
+/// Numeric value of a row's cell as the range scans see it: `to_number(cell)`,
+/// `0.0` when the key is missing, `None` for non-object rows (never matched)
+#[inline]
+fn range_cell(row: &Value, col_name: &str) -> Option<f64> {
+    let obj = row.as_object()?;
+    Some(obj.get(col_name).map(helpers::to_number).unwrap_or(0.0))
+}
+
+/// Column sorted by value for `cell <= lookup` queries (INDEXAT range mode)
+#[derive(Debug, Clone, Default)]
+pub struct SortedColumn {
+    /// Cell values in ascending order
+    values: Vec<f64>,
+    /// `prefix_min_row[k]` = smallest row index among `values[..=k]`
+    prefix_min_row: Vec<usize>,
+}
+
+impl SortedColumn {
+    /// Sort the rows that have the column (null included); NaN cells never match
+    pub fn new(rows: &[Value], col_name: &str) -> Self {
+        let mut entries: Vec<(f64, usize)> = rows
+            .iter()
+            .enumerate()
+            .filter_map(|(row_idx, row)| {
+                let cell = row.as_object()?.get(col_name)?;
+                let num = helpers::to_number(cell);
+                (!num.is_nan()).then_some((num, row_idx))
+            })
+            .collect();
+        entries.sort_unstable_by(|a, b| a.0.total_cmp(&b.0));
+
+        let mut prefix_min_row = Vec::with_capacity(entries.len());
+        let mut min_row = usize::MAX;
+        for &(_, row_idx) in &entries {
+            min_row = min_row.min(row_idx);
+            prefix_min_row.push(min_row);
+        }
+        Self {
+            values: entries.into_iter().map(|(num, _)| num).collect(),
+            prefix_min_row,
+        }
+    }
+
+    /// First row (lowest index) whose cell is `<= lookup`, in O(log n)
+    pub fn first_at_most(&self, lookup: f64) -> Option<usize> {
+        let count = self.values.partition_point(|&num| num <= lookup);
+        count.checked_sub(1).map(|last| self.prefix_min_row[last])
+    }
+}
+
+/// Interval index over a `(min_col, max_col)` band pair (MATCHRANGE).
+///
+/// Band endpoints are compressed into elementary slots (each distinct endpoint,
+/// then the open gap after it) and every band is inserted into the canonical
+/// nodes of a segment tree keeping the lowest row index. A stabbing query walks
+/// one leaf-to-root path, so finding the first row whose band contains a value
+/// is O(log n) regardless of how bands overlap.
+#[derive(Debug, Clone, Default)]
+pub struct IntervalIndex {
+    /// Distinct band endpoints in ascending order
+    points: Vec<f64>,
+    /// Bottom-up segment tree of minimum row indices (`usize::MAX` = none)
+    tree: Vec<usize>,
+    /// Number of leaves (power of two)
+    size: usize,
+}
+
+impl IntervalIndex {
+    pub fn new(rows: &[Value], min_col: &str, max_col: &str) -> Self {
+        let bands: Vec<(f64, f64, usize)> = rows
+            .iter()
+            .enumerate()
+            .filter_map(|(row_idx, row)| {
+                let lo = range_cell(row, min_col)?;
+                let hi = range_cell(row, max_col)?;
+                // Empty or NaN bands can never contain a value; `+ 0.0` folds -0.0 into 0.0
+                (lo <= hi).then_some((lo + 0.0, hi + 0.0, row_idx))
+            })
+            .collect();
+
+        let mut points: Vec<f64> = bands.iter().flat_map(|&(lo, hi, _)| [lo, hi]).collect();
+        points.sort_unstable_by(f64::total_cmp);
+        points.dedup();
+
+        let slots = (points.len() * 2).saturating_sub(1);
+        let size = slots.next_power_of_two();
+        let mut tree = vec![usize::MAX; size * 2];
+
+        for (lo, hi, row_idx) in bands {
+            let mut l = Self::point_slot(&points, lo) + size;
+            let mut r = Self::point_slot(&points, hi) + size + 1;
+            while l < r {
+                if l & 1 == 1 {
+                    tree[l] = tree[l].min(row_idx);
+                    l += 1;
+                }
+                if r & 1 == 1 {
+                    r -= 1;
+                    tree[r] = tree[r].min(row_idx);
+                }
+                l >>= 1;
+                r >>= 1;
+            }
+        }
+
+        Self { points, tree, size }
+    }
+
+    /// Slot of an endpoint known to be in `points`
+    #[inline]
+    fn point_slot(points: &[f64], value: f64) -> usize {
+        points.partition_point(|&p| p < value) * 2
+    }
+
+    /// First row (lowest index) whose band satisfies `min <= check <= max`
+    pub fn first_containing(&self, check: f64) -> Option<usize> {
+        if check.is_nan() {
+            return None;
+        }
+        // Points strictly below `check`; `check` sits on point `below` or in the gap after `below - 1`
+        let below = self.points.partition_point(|&p| p < check);
+        let slot = if self.points.get(below) == Some(&check) {
+            below * 2
+        } else if below == 0 || below == self.points.len() {
+            return None;
+        } else {
+            below * 2 - 1
+        };
+
+        let mut node = slot + self.size;
+        let mut best = usize::MAX;
+        while node > 0 {
+            best = best.min(self.tree[node]);
+            node >>= 1;
+        }
+        (best != usize::MAX).then_some(best)
+    }
+}
 
 /// Index for a table (array of objects)
 /// Maps column names to value-to-row-indices lookup
 #[derive(Debug, Clone, Default)]
 pub struct TableIndex {
-    /// Map of column name -> (Map of value hash -> Set of row indices)
-    columns: RapidHashMap<String, RapidHashMap<String, RapidHashSet<usize>>>,
+    /// Exact-match index per column
+    columns: RapidHashMap<String, ColumnIndex>,
+    /// Sorted columns for `<=` range lookups, built on demand
+    sorted: RapidHashMap<String, SortedColumn>,
+    /// Interval indexes keyed by min column, then max column, built on demand
+    bands: RapidHashMap<String, RapidHashMap<String, IntervalIndex>>,
     /// Total number of rows in the table
     row_count: usize,
 }
@@ -16,7 +315,7 @@ impl TableIndex {
     /// Create a new index from a table (array of objects)
     pub fn new(data: &Value) -> Option<Self> {
         let arr = data.as_array()?;
-        if arr.is_empty() {
+        if arr.is_empty() || arr.len() > u32::MAX as usize {
             return None;
         }
 
@@ -26,32 +325,112 @@ impl TableIndex {
         }
 
         let row_count = arr.len();
-        let mut columns: RapidHashMap<String, RapidHashMap<String, RapidHashSet<usize>>> =
-            RapidHashMap::new();
+        let mut columns: RapidHashMap<String, ColumnIndex> = RapidHashMap::new();
+        // Text shared across columns is stored once
+        let mut interner: RapidHashSet<Arc<str>> = RapidHashSet::new();
 
         for (row_idx, row) in arr.iter().enumerate() {
             if let Value::Object(obj) = row {
                 for (col_name, val) in obj {
-                    // Generate hash key for the value
-                    if let Some(key) = helpers::scalar_hash_key(val) {
-                        // Get or create column index
-                        let col_index = columns.entry(col_name.clone()).or_default();
-
-                        // Get or create value entry and add row index
-                        col_index.entry(key).or_default().insert(row_idx);
+                    if !columns.contains_key(col_name.as_str()) {
+                        columns.insert(col_name.clone(), ColumnIndex::default());
+                    }
+                    if let Some(col_index) = columns.get_mut(col_name.as_str()) {
+                        col_index.insert(row_idx as u32, val, &mut interner);
                     }
                 }
             }
         }
 
-        Some(Self { columns, row_count })
+        Some(Self {
+            columns,
+            row_count,
+            ..Default::default()
+        })
+    }
+
+    /// Create an index without exact-match columns; range structures are added
+    /// on demand with `ensure_sorted` / `ensure_band`
+    pub fn range_only(row_count: usize) -> Self {
+        Self {
+            row_count,
+            ..Default::default()
+        }
+    }
+
+    /// Build the sorted column for `col_name` if missing
+    pub fn ensure_sorted(&mut self, rows: &[Value], col_name: &str) {
+        if !self.sorted.contains_key(col_name) {
+            self.sorted
+                .insert(col_name.to_string(), SortedColumn::new(rows, col_name));
+        }
+    }
+
+    /// Build the interval index for the `(min_col, max_col)` band if missing
+    pub fn ensure_band(&mut self, rows: &[Value], min_col: &str, max_col: &str) {
+        if !self.has_band(min_col, max_col) {
+            self.bands.entry(min_col.to_string()).or_default().insert(
+                max_col.to_string(),
+                IntervalIndex::new(rows, min_col, max_col),
+            );
+        }
+    }
+
+    /// First row whose `col_name` cell is `<= lookup`.
+    /// Outer `None` when the column has no sorted index.
+    pub fn first_at_most(&self, col_name: &str, lookup: f64) -> Option<Option<usize>> {
+        Some(self.sorted.get(col_name)?.first_at_most(lookup))
+    }
+
+    /// First row with `min_col <= check <= max_col`.
+    /// Outer `None` when the band has no interval index.
+    pub fn first_in_band(&self, min_col: &str, max_col: &str, check: f64) -> Option<Option<usize>> {
+        let band = self.bands.get(min_col)?.get(max_col)?;
+        Some(band.first_containing(check))
+    }
+
+    pub fn has_sorted(&self, col_name: &str) -> bool {
+        self.sorted.contains_key(col_name)
+    }
+
+    pub fn has_band(&self, min_col: &str, max_col: &str) -> bool {
+        self.bands
+            .get(min_col)
+            .is_some_and(|by_max| by_max.contains_key(max_col))
+    }
+
+    /// Look up the rows whose `col_name` cell loosely equals `value`.
+    /// `None` when the column is not indexed or the value is not a scalar.
+    pub fn lookup(&self, col_name: &str, value: &Value) -> Option<RowMatch<'_>> {
+        self.columns.get(col_name)?.lookup(value)
     }
 
-    /// Look up row indices matching a specific column value
-    pub fn lookup(&self, col_name: &str, value: &Value) -> Option<&RapidHashSet<usize>> {
-        let col_index = self.columns.get(col_name)?;
-        let key = helpers::scalar_hash_key(value)?;
-        col_index.get(&key)
+    /// First row matching every `(value, column)` condition (MATCH semantics).
+    /// `None` when some condition cannot be answered from the index.
+    pub fn first_match_all<S: AsRef<str>>(
+        &self,
+        conditions: &[(Value, S)],
+    ) -> Option<Option<usize>> {
+        if conditions.is_empty() {
+            return None;
+        }
+        let mut matches = conditions
+            .iter()
+            .map(|(value, col_name)| self.lookup(col_name.as_ref(), value))
+            .collect::<Option<SmallVec<[RowMatch; 4]>>>()?;
+
+        // Drive from the most selective condition, probe the others
+        matches.sort_unstable_by_key(RowMatch::len);
+        let (driver, rest) = matches.split_first()?;
+        let first = driver
+            .lists
+            .iter()
+            .filter_map(|rows| {
+                rows.iter()
+                    .find(|&&row| rest.iter().all(|other| other.contains(row)))
+            })
+            .min();
+        Some(first.map(|&row| row as usize))
     }
 
     /// Check if a column is indexed
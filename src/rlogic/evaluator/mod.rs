@@ -1,14 +1,18 @@
 use super::compiled::CompiledLogic;
 use super::config::RLogicConfig;
+use crate::jsoneval::path_utils;
+use columnar::ColumnarTable;
 use index::TableIndex;
 use serde_json::Value;
 use std::cell::UnsafeCell;
 use std::collections::HashMap;
+use std::marker::PhantomData;
 use std::sync::RwLock;
 
 pub mod arithmetic;
 pub mod array_lookup;
 pub mod array_ops;
+pub mod columnar;
 pub mod comparison;
 pub mod date_ops;
 pub mod helpers;
@@ -16,6 +20,7 @@ pub mod index;
 pub mod logical;
 pub mod math_ops;
 pub mod optimizations;
+pub mod simd;
 pub mod string_ops;
 pub mod types;
 
@@ -25,9 +30,11 @@ pub use types::*;
 /// Active self-table scope set during `evaluate_table_inner`.
 ///
 /// # Safety
-/// `rows` is a raw pointer to `local_rows` on the stack of `evaluate_table_inner`.
+/// `rows` is a raw pointer to a rows `Vec` owned by the table evaluation frame
+/// (`local_rows`, or a worker's chunk in the parallel row pass).
 /// Valid lifetime: from `enter_table_scope()` to `TableScopeGuard::drop()`.
-/// Evaluation is single-threaded (protected by `eval_lock` in `evaluate_internal`).
+/// Scopes live in thread-local storage, so every worker thread sees only the
+/// scope it entered itself.
 pub(crate) struct TableScope {
     /// Normalized JSON pointer path to the table being evaluated
     pub path: String,
@@ -37,24 +44,31 @@ pub(crate) struct TableScope {
     pub current_row: Option<usize>,
 }
 
-// SAFETY: table evaluation is protected by eval_lock (single-threaded access).
-// UnsafeCell provides interior mutability without adding Sync constraints.
-// The raw *const pointer in TableScope is only accessed under eval_lock.
-unsafe impl Send for TableScope {}
-unsafe impl Send for Evaluator {}
-unsafe impl Sync for Evaluator {}
+thread_local! {
+    /// Per-thread self-table scopes, tagged with the address of the owning evaluator
+    /// so that scopes of unrelated evaluators on the same thread never alias.
+    static TABLE_SCOPES: UnsafeCell<Vec<(usize, TableScope)>> = const { UnsafeCell::new(Vec::new()) };
+}
 
-/// RAII guard that clears the active TableScope on drop
+/// RAII guard that clears the active TableScope on drop.
+///
+/// The guard is `!Send`: the scope lives in the entering thread's local storage
+/// and must be released on that same thread.
 pub struct TableScopeGuard<'a> {
     evaluator: &'a Evaluator,
+    _not_send: PhantomData<*const ()>,
 }
 
 impl<'a> Drop for TableScopeGuard<'a> {
     fn drop(&mut self) {
-        // SAFETY: single-threaded (eval_lock), no concurrent access
-        unsafe {
-            *self.evaluator.table_scope.get() = None;
-        }
+        let owner = self.evaluator.scope_owner();
+        // SAFETY: thread-local storage, no reference into the Vec outlives this call
+        TABLE_SCOPES.with(|scopes| unsafe {
+            let scopes = &mut *scopes.get();
+            if let Some(pos) = scopes.iter().rposition(|(o, _)| *o == owner) {
+                scopes.remove(pos);
+            }
+        });
     }
 }
 
@@ -74,8 +88,9 @@ pub struct Evaluator {
     indices: RwLock<HashMap<String, TableIndex>>,
     /// Extracted large static arrays for zero-copy resolution
     static_arrays: Option<std::sync::Arc<indexmap::IndexMap<String, std::sync::Arc<Value>>>>,
-    /// Active self-table scope during table evaluation (None outside table eval)
-    pub(crate) table_scope: UnsafeCell<Option<TableScope>>,
+    /// Columnar projections of static arrays, built on first lookup
+    /// (static path -> projection; `None` when the array is too small or not tabular)
+    columnar: RwLock<HashMap<String, Option<std::sync::Arc<ColumnarTable>>>>,
 }
 
 impl Evaluator {
@@ -84,13 +99,52 @@ impl Evaluator {
             config: RLogicConfig::default(),
             indices: RwLock::new(HashMap::new()),
             static_arrays: None,
-            table_scope: UnsafeCell::new(None),
+            columnar: RwLock::new(HashMap::new()),
         }
     }
 
+    /// Address used to tag this evaluator's entries in `TABLE_SCOPES`
+    #[inline(always)]
+    fn scope_owner(&self) -> usize {
+        self as *const Self as usize
+    }
+
+    /// Run `f` against this evaluator's innermost table scope on the current thread.
+    #[inline]
+    fn with_table_scope<R>(&self, f: impl FnOnce(&mut TableScope) -> R) -> Option<R> {
+        let owner = self.scope_owner();
+        // SAFETY: thread-local storage; `f` never re-enters scope registration
+        TABLE_SCOPES.with(|scopes| unsafe {
+            let scopes = &mut *scopes.get();
+            scopes
+                .iter_mut()
+                .rev()
+                .find(|(o, _)| *o == owner)
+                .map(|(_, ts)| f(ts))
+        })
+    }
+
+    /// Rows of the active table scope when `name` refers to the table being evaluated.
+    #[inline]
+    pub(crate) fn table_scope_rows(&self, name: &str) -> Option<&Vec<Value>> {
+        let rows = self.with_table_scope(|ts| (name == ts.path).then_some(ts.rows))??;
+        // SAFETY: rows outlive the scope guard, which outlives this evaluation frame
+        Some(unsafe { &*rows })
+    }
+
+    /// Current row of the active table scope (set by `set_table_scope_row`).
+    #[inline]
+    pub(crate) fn table_scope_current_row(&self) -> Option<&Value> {
+        let (rows, row_idx) =
+            self.with_table_scope(|ts| ts.current_row.map(|r| (ts.rows, r)))??;
+        // SAFETY: rows outlive the scope guard, which outlives this evaluation frame
+        unsafe { &*rows }.get(row_idx)
+    }
+
     /// Register a table scope for self-reference interception.
     ///
-    /// Returns a guard that clears the scope on drop.
+    /// Returns a guard that clears the scope on drop. The scope is only visible
+    /// to the calling thread.
     ///
     /// # Safety
     /// `rows` must outlive the returned guard. The guard MUST be dropped before
@@ -100,35 +154,32 @@ impl Evaluator {
         path: String,
         rows: &Vec<Value>,
     ) -> TableScopeGuard<'a> {
-        // SAFETY: single-threaded (eval_lock held by caller)
-        unsafe {
-            *self.table_scope.get() = Some(TableScope {
-                path,
-                rows: rows as *const Vec<Value>,
-                current_row: None,
-            });
+        let owner = self.scope_owner();
+        // SAFETY: thread-local storage, no outstanding references into the Vec
+        TABLE_SCOPES.with(|scopes| unsafe {
+            (*scopes.get()).push((
+                owner,
+                TableScope {
+                    path,
+                    rows: rows as *const Vec<Value>,
+                    current_row: None,
+                },
+            ));
+        });
+        TableScopeGuard {
+            evaluator: self,
+            _not_send: PhantomData,
         }
-        TableScopeGuard { evaluator: self }
     }
 
     /// Update the rows pointer in the active table scope.
     pub(crate) fn update_table_scope_rows(&self, rows: &Vec<Value>) {
-        // SAFETY: single-threaded (eval_lock held by caller)
-        unsafe {
-            if let Some(ts) = (*self.table_scope.get()).as_mut() {
-                ts.rows = rows as *const Vec<Value>;
-            }
-        }
+        self.with_table_scope(|ts| ts.rows = rows as *const Vec<Value>);
     }
 
     /// Set the row cursor for the active table scope
     pub(crate) fn set_table_scope_row(&self, row_idx: Option<usize>) {
-        // SAFETY: single-threaded (eval_lock held by caller)
-        unsafe {
-            if let Some(ts) = (*self.table_scope.get()).as_mut() {
-                ts.current_row = row_idx;
-            }
-        }
+        self.with_table_scope(|ts| ts.current_row = row_idx);
     }
 
     pub fn with_config(mut self, config: RLogicConfig) -> Self {
@@ -141,14 +192,25 @@ impl Evaluator {
         &mut self,
         static_arrays: std::sync::Arc<indexmap::IndexMap<String, std::sync::Arc<Value>>>,
     ) {
+        // Range indexes built for the previous static arrays are keyed by their paths
+        if let (Some(previous), Ok(indices)) = (&self.static_arrays, self.indices.get_mut()) {
+            indices.retain(|name, _| !previous.contains_key(name));
+        }
         self.static_arrays = Some(static_arrays);
+        if let Ok(columnar) = self.columnar.get_mut() {
+            columnar.clear();
+        }
     }
 
-    /// Build and store index for a table
+    /// Build and store index for a table.
+    ///
+    /// `name` may be given as a dotted path or a JSON pointer; it is stored in the
+    /// pointer form that compiled `var`/`$ref` table names use.
     pub fn index_table(&self, name: &str, data: &Value) {
         if let Some(index) = TableIndex::new(data) {
             if let Ok(mut indices) = self.indices.write() {
-                indices.insert(name.to_string(), index);
+                let key = path_utils::normalize_to_json_pointer(name);
+                indices.insert(key.into_owned(), index);
             }
         }
     }
@@ -846,14 +908,8 @@ impl Evaluator {
         // that resolve to the table's own path (e.g. used in MAP/FILTER/REDUCE over self)
         // must see local_rows, not stale data in scope_data.
         if !name.is_empty() {
-            // SAFETY: single-threaded (eval_lock), UnsafeCell
-            let scope = unsafe { &*self.table_scope.get() };
-            if let Some(ts) = scope.as_ref() {
-                if name == ts.path {
-                    // SAFETY: local_rows outlives this evaluation frame
-                    let rows = unsafe { &*ts.rows };
-                    return Ok(Value::Array(rows.clone()));
-                }
+            if let Some(rows) = self.table_scope_rows(name) {
+                return Ok(Value::Array(rows.clone()));
             }
         }
 
@@ -196,6 +196,27 @@ impl Evaluator {
         }
     }
 
+    /// Extract the VALUEAT result for a row found by a columnar lookup
+    #[inline]
+    fn value_at_found_row(
+        &self,
+        arr: Option<&[Value]>,
+        row: Option<usize>,
+        col_val: &Option<Value>,
+    ) -> Value {
+        let Some(row) = row.and_then(|idx| arr?.get(idx)) else {
+            return Value::Null;
+        };
+        if let Some(Value::String(col_name)) = col_val {
+            row.as_object()
+                .and_then(|obj| obj.get(col_name))
+                .cloned()
+                .unwrap_or(Value::Null)
+        } else {
+            row.clone()
+        }
+    }
+
     /// Combined VALUEAT + INDEXAT (single loop)
     pub(super) fn eval_valueat_indexat_combined(
         &self,
@@ -231,6 +252,15 @@ impl Evaluator {
         if let (Some(arr), Value::String(field)) = (table_ref.as_array(), &field_val) {
             let lookup_num = to_number(&lookup_val);
 
+            let columnar_row = if is_range {
+                self.indexed_first_at_most(table_expr, user_data, field, lookup_num)
+            } else {
+                self.columnar_first_equal(table_expr, user_data, field, &lookup_val)
+            };
+            if let Some(row) = columnar_row {
+                return Ok(self.value_at_found_row(Some(arr), row, &col_val));
+            }
+
             if is_range {
                 // Range mode: find FIRST row where cell_val <= lookup_val
                 for row in arr.iter() {
@@ -352,6 +382,11 @@ impl Evaluator {
             }
         }
 
+        if let Some(row) = self.columnar_match(table_expr, user_data, &evaluated_conditions, false)
+        {
+            return Ok(self.value_at_found_row(table_ref.as_array(), row, &col_val));
+        }
+
         // Single loop: find row and extract value
         if let Some(arr) = table_ref.as_array() {
             for row in arr.iter() {
@@ -413,6 +448,10 @@ impl Evaluator {
             }
         }
 
+        if let Some(row) = self.indexed_matchrange(table_expr, user_data, &evaluated_conditions) {
+            return Ok(self.value_at_found_row(table_ref.as_array(), row, &col_val));
+        }
+
         // Single loop: find row and extract value
         if let Some(arr) = table_ref.as_array() {
             for row in arr.iter() {
@@ -471,6 +510,10 @@ impl Evaluator {
             }
         }
 
+        if let Some(row) = self.columnar_match(table_expr, user_data, &evaluated_conditions, true) {
+            return Ok(self.value_at_found_row(table_ref.as_array(), row, &col_val));
+        }
+
         // Single loop: find row and extract value (ANY match)
         if let Some(arr) = table_ref.as_array() {
             for row in arr.iter() {
@@ -0,0 +1,236 @@
+//! Vectorized comparison kernels over contiguous `f64` columns.
+//!
+//! Each kernel compares a block of at most 64 values against a scalar and
+//! returns a match bitmask (bit `i` set when row `i` of the block matches), so
+//! multiple conditions combine with a plain `&` before the first set bit is
+//! taken. AVX2 (x86_64, detected at runtime) and NEON (aarch64) paths are
+//! used when available; the portable fallback is written so LLVM can
+//! auto-vectorize it.
+//!
+//! Comparisons are ordered (`NaN` never matches), matching scalar `==`/`<=`.
+
+/// Rows per mask block
+pub const BLOCK: usize = 64;
+
+/// Mask with the low `len` bits set (the valid rows of a tail block)
+#[inline(always)]
+pub fn tail_mask(len: usize) -> u64 {
+    if len >= BLOCK {
+        u64::MAX
+    } else {
+        (1u64 << len) - 1
+    }
+}
+
+/// Bitmask of `values[i] == target`
+#[inline]
+pub fn eq_mask(values: &[f64], target: f64) -> u64 {
+    debug_assert!(values.len() <= BLOCK);
+    #[cfg(target_arch = "x86_64")]
+    {
+        if std::arch::is_x86_feature_detected!("avx2") {
+            // SAFETY: AVX2 availability checked above
+            return unsafe { avx2::eq_mask(values, target) };
+        }
+    }
+    #[cfg(target_arch = "aarch64")]
+    {
+        // SAFETY: NEON is mandatory on aarch64
+        return unsafe { neon::eq_mask(values, target) };
+    }
+    #[allow(unreachable_code)]
+    scalar_mask(values, |v| v == target)
+}
+
+/// Bitmask of `values[i] <= bound`
+#[inline]
+pub fn le_mask(values: &[f64], bound: f64) -> u64 {
+    debug_assert!(values.len() <= BLOCK);
+    #[cfg(target_arch = "x86_64")]
+    {
+        if std::arch::is_x86_feature_detected!("avx2") {
+            // SAFETY: AVX2 availability checked above
+            return unsafe { avx2::le_mask(values, bound) };
+        }
+    }
+    #[cfg(target_arch = "aarch64")]
+    {
+        // SAFETY: NEON is mandatory on aarch64
+        return unsafe { neon::le_mask(values, bound) };
+    }
+    #[allow(unreachable_code)]
+    scalar_mask(values, |v| v <= bound)
+}
+
+/// Bitmask of `min[i] <= check && check <= max[i]`
+#[inline]
+pub fn range_mask(min: &[f64], max: &[f64], check: f64) -> u64 {
+    debug_assert!(min.len() <= BLOCK && min.len() == max.len());
+    #[cfg(target_arch = "x86_64")]
+    {
+        if std::arch::is_x86_feature_detected!("avx2") {
+            // SAFETY: AVX2 availability checked above
+            return unsafe { avx2::range_mask(min, max, check) };
+        }
+    }
+    #[cfg(target_arch = "aarch64")]
+    {
+        // SAFETY: NEON is mandatory on aarch64
+        return unsafe { neon::range_mask(min, max, check) };
+    }
+    #[allow(unreachable_code)]
+    {
+        let mut mask = 0u64;
+        for (i, (lo, hi)) in min.iter().zip(max).enumerate() {
+            mask |= ((*lo <= check && check <= *hi) as u64) << i;
+        }
+        mask
+    }
+}
+
+#[inline(always)]
+fn scalar_mask(values: &[f64], pred: impl Fn(f64) -> bool) -> u64 {
+    let mut mask = 0u64;
+    for (i, v) in values.iter().enumerate() {
+        mask |= (pred(*v) as u64) << i;
+    }
+    mask
+}
+
+#[cfg(target_arch = "x86_64")]
+mod avx2 {
+    use std::arch::x86_64::*;
+
+    #[target_feature(enable = "avx2")]
+    pub unsafe fn eq_mask(values: &[f64], target: f64) -> u64 {
+        let t = _mm256_set1_pd(target);
+        let mut mask = 0u64;
+        let chunks = values.len() / 4;
+        for c in 0..chunks {
+            let v = _mm256_loadu_pd(values.as_ptr().add(c * 4));
+            let bits = _mm256_movemask_pd(_mm256_cmp_pd::<_CMP_EQ_OQ>(v, t)) as u64;
+            mask |= bits << (c * 4);
+        }
+        for i in chunks * 4..values.len() {
+            mask |= ((values[i] == target) as u64) << i;
+        }
+        mask
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub unsafe fn le_mask(values: &[f64], bound: f64) -> u64 {
+        let b = _mm256_set1_pd(bound);
+        let mut mask = 0u64;
+        let chunks = values.len() / 4;
+        for c in 0..chunks {
+            let v = _mm256_loadu_pd(values.as_ptr().add(c * 4));
+            let bits = _mm256_movemask_pd(_mm256_cmp_pd::<_CMP_LE_OQ>(v, b)) as u64;
+            mask |= bits << (c * 4);
+        }
+        for i in chunks * 4..values.len() {
+            mask |= ((values[i] <= bound) as u64) << i;
+        }
+        mask
+    }
+
+    #[target_feature(enable = "avx2")]
+    pub unsafe fn range_mask(min: &[f64], max: &[f64], check: f64) -> u64 {
+        let chk = _mm256_set1_pd(check);
+        let mut mask = 0u64;
+        let chunks = min.len() / 4;
+        for c in 0..chunks {
+            let lo = _mm256_loadu_pd(min.as_ptr().add(c * 4));
+            let hi = _mm256_loadu_pd(max.as_ptr().add(c * 4));
+            let in_range = _mm256_and_pd(
+                _mm256_cmp_pd::<_CMP_LE_OQ>(lo, chk),
+                _mm256_cmp_pd::<_CMP_GE_OQ>(hi, chk),
+            );
+            mask |= (_mm256_movemask_pd(in_range) as u64) << (c * 4);
+        }
+        for i in chunks * 4..min.len() {
+            mask |= ((min[i] <= check && check <= max[i]) as u64) << i;
+        }
+        mask
+    }
+}
+
+#[cfg(target_arch = "aarch64")]
+mod neon {
+    use std::arch::aarch64::*;
+
+    #[inline(always)]
+    unsafe fn lanes(cmp: uint64x2_t) -> u64 {
+        (vgetq_lane_u64::<0>(cmp) & 1) | ((vgetq_lane_u64::<1>(cmp) & 1) << 1)
+    }
+
+    #[target_feature(enable = "neon")]
+    pub unsafe fn eq_mask(values: &[f64], target: f64) -> u64 {
+        let t = vdupq_n_f64(target);
+        let mut mask = 0u64;
+        let chunks = values.len() / 2;
+        for c in 0..chunks {
+            let v = vld1q_f64(values.as_ptr().add(c * 2));
+            mask |= lanes(vceqq_f64(v, t)) << (c * 2);
+        }
+        for i in chunks * 2..values.len() {
+            mask |= ((values[i] == target) as u64) << i;
+        }
+        mask
+    }
+
+    #[target_feature(enable = "neon")]
+    pub unsafe fn le_mask(values: &[f64], bound: f64) -> u64 {
+        let b = vdupq_n_f64(bound);
+        let mut mask = 0u64;
+        let chunks = values.len() / 2;
+        for c in 0..chunks {
+            let v = vld1q_f64(values.as_ptr().add(c * 2));
+            mask |= lanes(vcleq_f64(v, b)) << (c * 2);
+        }
+        for i in chunks * 2..values.len() {
+            mask |= ((values[i] <= bound) as u64) << i;
+        }
+        mask
+    }
+
+    #[target_feature(enable = "neon")]
+    pub unsafe fn range_mask(min: &[f64], max: &[f64], check: f64) -> u64 {
+        let chk = vdupq_n_f64(check);
+        let mut mask = 0u64;
+        let chunks = min.len() / 2;
+        for c in 0..chunks {
+            let lo = vld1q_f64(min.as_ptr().add(c * 2));
+            let hi = vld1q_f64(max.as_ptr().add(c * 2));
+            let in_range = vandq_u64(vcleq_f64(lo, chk), vcgeq_f64(hi, chk));
+            mask |= lanes(in_range) << (c * 2);
+        }
+        for i in chunks * 2..min.len() {
+            mask |= ((min[i] <= check && check <= max[i]) as u64) << i;
+        }
+        mask
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn kernels_agree_with_scalar() {
+        let values: Vec<f64> = (0..61).map(|i| (i % 7) as f64).collect();
+        let max: Vec<f64> = values.iter().map(|v| v + 2.0).collect();
+
+        assert_eq!(eq_mask(&values, 3.0), scalar_mask(&values, |v| v == 3.0));
+        assert_eq!(le_mask(&values, 2.0), scalar_mask(&values, |v| v <= 2.0));
+        let expected = values
+            .iter()
+            .zip(&max)
+            .enumerate()
+            .fold(0u64, |m, (i, (lo, hi))| {
+                m | ((*lo <= 4.0 && 4.0 <= *hi) as u64) << i
+            });
+        assert_eq!(range_mask(&values, &max, 4.0), expected);
+        assert_eq!(eq_mask(&values, f64::NAN), 0);
+        assert_eq!(tail_mask(61).count_ones(), 61);
+    }
+}
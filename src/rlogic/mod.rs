@@ -40,6 +40,19 @@ impl RLogic {
         }
     }
 
+    /// Create an engine over an already populated store
+    pub(crate) fn with_store(store: CompiledLogicStore, config: RLogicConfig) -> Self {
+        Self {
+            store,
+            evaluator: Evaluator::new().with_config(config),
+        }
+    }
+
+    /// The compiled logic of this engine
+    pub(crate) fn store(&self) -> &CompiledLogicStore {
+        &self.store
+    }
+
     /// Set static arrays for evaluation context
     pub fn set_static_arrays(
         &mut self,
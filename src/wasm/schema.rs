@@ -11,8 +11,8 @@ impl JSONEvalWasm {
     /// @returns Evaluated schema as JSON string
     #[wasm_bindgen(js_name = getEvaluatedSchema)]
     pub fn get_evaluated_schema(&mut self) -> String {
-        let result = self.inner.get_evaluated_schema();
-        serde_json::to_string(&result).unwrap_or_else(|_| "{}".to_string())
+        serde_json::to_string(&self.inner.evaluated_schema_view(false))
+            .unwrap_or_else(|_| "{}".to_string())
     }
 
     /// Get the evaluated schema as JavaScript object
@@ -20,8 +20,8 @@ impl JSONEvalWasm {
     /// @returns Evaluated schema as JavaScript object
     #[wasm_bindgen(js_name = getEvaluatedSchemaJS)]
     pub fn get_evaluated_schema_js(&mut self) -> Result<JsValue, JsValue> {
-        let result = self.inner.get_evaluated_schema();
-        super::to_value(&result).map_err(|e| JsValue::from_str(&e.to_string()))
+        super::to_value(&self.inner.evaluated_schema_view(false))
+            .map_err(|e| JsValue::from_str(&e.to_string()))
     }
 
     /// Get the evaluated schema in MessagePack format
@@ -89,8 +89,8 @@ impl JSONEvalWasm {
     /// @returns Evaluated schema as JSON string
     #[wasm_bindgen(js_name = getEvaluatedSchemaWithoutParams)]
     pub fn get_evaluated_schema_without_params(&mut self) -> String {
-        let result = self.inner.get_evaluated_schema_without_params();
-        serde_json::to_string(&result).unwrap_or_else(|_| "{}".to_string())
+        serde_json::to_string(&self.inner.evaluated_schema_view(true))
+            .unwrap_or_else(|_| "{}".to_string())
     }
 
     /// Get the evaluated schema without $params as JavaScript object
@@ -98,8 +98,8 @@ impl JSONEvalWasm {
     /// @returns Evaluated schema as JavaScript object
     #[wasm_bindgen(js_name = getEvaluatedSchemaWithoutParamsJS)]
     pub fn get_evaluated_schema_without_params_js(&mut self) -> Result<JsValue, JsValue> {
-        let result = self.inner.get_evaluated_schema_without_params();
-        super::to_value(&result).map_err(|e| JsValue::from_str(&e.to_string()))
+        super::to_value(&self.inner.evaluated_schema_view(true))
+            .map_err(|e| JsValue::from_str(&e.to_string()))
     }
 
     /// Get a value from the evaluated schema using dotted path notation
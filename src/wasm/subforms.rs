@@ -36,6 +36,31 @@ impl JSONEvalWasm {
             })
     }
 
+    /// Evaluate every item of a subform array. Items run one after another on
+    /// wasm, which has no worker threads.
+    ///
+    /// @param subformPath - Path to the subform array (e.g., "#/riders")
+    /// @param data - Full parent JSON data string holding the array
+    /// @param context - Optional context data JSON string
+    /// @throws Error if evaluation fails
+    #[wasm_bindgen(js_name = evaluateSubformItems)]
+    pub fn evaluate_subform_items(
+        &mut self,
+        subform_path: &str,
+        data: &str,
+        context: Option<String>,
+    ) -> Result<(), JsValue> {
+        let ctx = context.as_deref();
+
+        self.inner
+            .evaluate_subform_items(subform_path, data, ctx, None)
+            .map_err(|e| {
+                let error_msg = format!("Subform items evaluation failed: {}", e);
+                console_log(&format!("[WASM ERROR] {}", error_msg));
+                JsValue::from_str(&error_msg)
+            })
+    }
+
     /// Validate subform data against its schema rules
     ///
     /// @param subformPath - Path to the subform
@@ -169,4 +169,60 @@ impl JSONEvalWasm {
             }
         }
     }
+
+    /// Validate and return only the changes since the previous validation (Worker-safe)
+    ///
+    /// @param data - JSON data string
+    /// @param context - Optional context data JSON string
+    /// @param paths - Optional array of paths to validate (null for all)
+    /// @returns Plain JavaScript object `{ hasError, changed, cleared }`
+    #[wasm_bindgen(js_name = validateDeltaJS)]
+    pub fn validate_delta_js(
+        &mut self,
+        data: &str,
+        context: Option<String>,
+        paths: Option<Vec<String>>,
+    ) -> Result<JsValue, JsValue> {
+        let ctx = context.as_deref();
+        let paths_ref = paths.as_ref().map(|v| v.as_slice());
+
+        let token = self.reset_token();
+        match self
+            .inner
+            .validate_delta(data, ctx, paths_ref, token.as_ref())
+        {
+            Ok(delta) => {
+                let mut changed = serde_json::Map::new();
+                for (path, error) in delta.changed {
+                    changed.insert(
+                        path.clone(),
+                        serde_json::json!({
+                            "path": path,
+                            "type": error.rule_type,
+                            "message": error.message,
+                            "code": error.code,
+                            "pattern": error.pattern,
+                            "fieldValue": error.field_value,
+                            "data": error.data,
+                        }),
+                    );
+                }
+                let result = serde_json::json!({
+                    "hasError": delta.has_error,
+                    "changed": changed,
+                    "cleared": delta.cleared,
+                });
+                super::to_value(&result).map_err(|e| {
+                    let error_msg = format!("Failed to serialize validation delta: {}", e);
+                    console_log(&format!("[WASM ERROR] {}", error_msg));
+                    JsValue::from_str(&error_msg)
+                })
+            }
+            Err(e) => {
+                let error_msg = format!("Validation failed: {}", e);
+                console_log(&format!("[WASM ERROR] {}", error_msg));
+                Err(JsValue::from_str(&error_msg))
+            }
+        }
+    }
 }
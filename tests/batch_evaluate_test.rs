@@ -0,0 +1,121 @@
+use json_eval_rs::{evaluate_batch, BatchWorker, JSONEval, ParsedSchema, ReturnFormat};
+use serde_json::{json, Value};
+use std::sync::Arc;
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "base": { "type": "number" },
+            "flag": { "type": "boolean" },
+            "doubled": {
+                "type": "number",
+                "value": { "$evaluation": { "*": [{ "$ref": "#/properties/base" }, 2] } }
+            },
+            "label": {
+                "type": "string",
+                "value": {
+                    "$evaluation": {
+                        "if": [{ "$ref": "#/properties/flag" }, "on", "off"]
+                    }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn paths() -> Vec<String> {
+    vec![
+        "#/properties/doubled/value".to_string(),
+        "#/properties/label/value".to_string(),
+    ]
+}
+
+fn records(n: i64) -> Vec<Value> {
+    (0..n)
+        .map(|i| json!({ "base": i, "flag": i % 3 == 0 }))
+        .collect()
+}
+
+fn fresh(parsed: &Arc<ParsedSchema>, record: &Value, paths: &[String]) -> Value {
+    let mut eval = JSONEval::with_parsed_schema(Arc::clone(parsed), None, None).unwrap();
+    eval.evaluate(&record.to_string(), None, None, None)
+        .unwrap();
+    if paths.is_empty() {
+        eval.get_evaluated_schema()
+    } else {
+        eval.get_evaluated_schema_by_paths(paths, Some(ReturnFormat::Flat))
+    }
+}
+
+#[test]
+fn batch_matches_per_record_evaluation_in_order() {
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    let records = records(64);
+
+    let results = evaluate_batch(Arc::clone(&parsed), records.clone(), &paths());
+    assert_eq!(results.len(), records.len());
+    for (i, (result, record)) in results.into_iter().zip(&records).enumerate() {
+        let value = result.unwrap();
+        assert_eq!(value, fresh(&parsed, record, &paths()));
+        assert_eq!(
+            value
+                .get("#/properties/doubled/value")
+                .and_then(Value::as_f64),
+            Some(i as f64 * 2.0)
+        );
+    }
+}
+
+#[test]
+fn empty_paths_return_whole_schema() {
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    let records = records(4);
+
+    let results = evaluate_batch(Arc::clone(&parsed), records.clone(), &[]);
+    for (result, record) in results.into_iter().zip(&records) {
+        assert_eq!(result.unwrap(), fresh(&parsed, record, &[]));
+    }
+}
+
+#[test]
+fn reused_worker_matches_fresh_evaluator() {
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    let mut worker = BatchWorker::new(Arc::clone(&parsed), &paths()).unwrap();
+
+    // Repeat and revisit records so the worker sees both changed and unchanged data
+    let sequence = [3, 3, 7, 0, 7, 12];
+    for i in sequence {
+        let record = json!({ "base": i, "flag": i % 3 == 0 });
+        assert_eq!(
+            worker.evaluate(record.clone()).unwrap(),
+            fresh(&parsed, &record, &paths())
+        );
+    }
+}
+
+#[test]
+fn worker_does_not_carry_keys_between_records() {
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    let mut worker = BatchWorker::new(Arc::clone(&parsed), &paths()).unwrap();
+
+    // The second record has no "flag", so its label must fall back to "off"
+    let sequence = [
+        json!({ "base": 1, "flag": true }),
+        json!({ "base": 2 }),
+        json!({ "flag": true }),
+        json!({}),
+    ];
+    for record in &sequence {
+        assert_eq!(
+            worker.evaluate(record.clone()).unwrap(),
+            fresh(&parsed, record, &paths())
+        );
+    }
+
+    let results = evaluate_batch(Arc::clone(&parsed), sequence.to_vec(), &paths());
+    for (result, record) in results.into_iter().zip(&sequence) {
+        assert_eq!(result.unwrap(), fresh(&parsed, record, &paths()));
+    }
+}
@@ -0,0 +1,173 @@
+use serde_json::{json, Value};
+use std::io::Write;
+use std::path::PathBuf;
+use std::process::{Command, Output, Stdio};
+
+const DOUBLED: &str = "#/properties/doubled/value";
+
+/// Write the test schema to a file of its own and return the path
+fn schema_file(name: &str) -> PathBuf {
+    let schema = json!({
+        "type": "object",
+        "properties": {
+            "base": { "type": "number" },
+            "doubled": {
+                "type": "number",
+                "value": { "$evaluation": { "*": [{ "$ref": "#/properties/base" }, 2] } }
+            }
+        }
+    });
+    let path = std::env::temp_dir().join(format!(
+        "json_eval_cli_batch_{}_{}.json",
+        name,
+        std::process::id()
+    ));
+    std::fs::write(&path, schema.to_string()).unwrap();
+    path
+}
+
+/// Run the CLI in batch mode over `input` on stdin
+fn run_batch(name: &str, input: &[u8], extra: &[&str]) -> Output {
+    let schema = schema_file(name);
+    let mut child = Command::new(env!("CARGO_BIN_EXE_json-eval-cli"))
+        .arg(&schema)
+        .args(["--batch", "--paths", DOUBLED])
+        .args(extra)
+        .stdin(Stdio::piped())
+        .stdout(Stdio::piped())
+        .stderr(Stdio::piped())
+        .spawn()
+        .unwrap();
+    child.stdin.take().unwrap().write_all(input).unwrap();
+    let output = child.wait_with_output().unwrap();
+    let _ = std::fs::remove_file(schema);
+    output
+}
+
+fn result_lines(output: &Output) -> Vec<Value> {
+    String::from_utf8(output.stdout.clone())
+        .unwrap()
+        .lines()
+        .map(|line| serde_json::from_str(line).unwrap())
+        .collect()
+}
+
+fn doubled(line: &Value) -> Option<f64> {
+    line.pointer("/value")
+        .and_then(|v| v.get(DOUBLED))
+        .and_then(Value::as_f64)
+}
+
+fn ndjson(n: usize) -> String {
+    (0..n)
+        .map(|i| format!("{}\n", json!({ "base": i })))
+        .collect()
+}
+
+#[test]
+fn ndjson_results_keep_record_order() {
+    let output = run_batch("ordered", ndjson(200).as_bytes(), &["--threads", "4"]);
+    assert!(output.status.success());
+
+    let lines = result_lines(&output);
+    assert_eq!(lines.len(), 200);
+    for (i, line) in lines.iter().enumerate() {
+        assert!(line.get("id").is_none());
+        assert_eq!(doubled(line), Some(i as f64 * 2.0));
+    }
+}
+
+#[test]
+fn unordered_results_carry_record_ids() {
+    let output = run_batch(
+        "unordered",
+        ndjson(200).as_bytes(),
+        &["--threads", "4", "--unordered"],
+    );
+    assert!(output.status.success());
+
+    let mut seen: Vec<u64> = result_lines(&output)
+        .iter()
+        .map(|line| {
+            let id = line["id"].as_u64().unwrap();
+            assert_eq!(doubled(line), Some(id as f64 * 2.0));
+            id
+        })
+        .collect();
+    seen.sort_unstable();
+    assert_eq!(seen, (0..200).collect::<Vec<_>>());
+}
+
+#[test]
+fn ndjson_reader_skips_blank_lines_and_reports_bad_records() {
+    let input = "{\"base\": 1}\n\n   \nnot json\n{\"base\": 3}";
+    let output = run_batch("reader", input.as_bytes(), &["--threads", "2"]);
+    assert!(output.status.success());
+
+    let lines = result_lines(&output);
+    assert_eq!(lines.len(), 3);
+    assert_eq!(doubled(&lines[0]), Some(2.0));
+    assert!(lines[1]["error"].is_string());
+    assert_eq!(doubled(&lines[2]), Some(6.0));
+}
+
+#[test]
+fn msgpack_records_are_length_prefixed() {
+    let mut input = Vec::new();
+    for i in 0..50 {
+        let record = rmp_serde::to_vec_named(&json!({ "base": i })).unwrap();
+        input.extend_from_slice(&(record.len() as u32).to_be_bytes());
+        input.extend_from_slice(&record);
+    }
+    let output = run_batch(
+        "msgpack",
+        &input,
+        &["--batch-format", "msgpack", "--threads", "3"],
+    );
+    assert!(output.status.success());
+
+    let lines = result_lines(&output);
+    assert_eq!(lines.len(), 50);
+    for (i, line) in lines.iter().enumerate() {
+        assert_eq!(doubled(line), Some(i as f64 * 2.0));
+    }
+}
+
+#[test]
+fn msgpack_oversized_length_prefix_is_an_error() {
+    let record = rmp_serde::to_vec_named(&json!({ "base": 1 })).unwrap();
+    let mut input = (record.len() as u32).to_be_bytes().to_vec();
+    input.extend_from_slice(&record);
+    input.extend_from_slice(&u32::MAX.to_be_bytes());
+
+    let output = run_batch("oversized", &input, &["--batch-format", "msgpack"]);
+    assert!(!output.status.success());
+    assert!(String::from_utf8_lossy(&output.stderr).contains("failed to read record 2"));
+
+    // The record before the bad prefix is still written
+    let lines = result_lines(&output);
+    assert_eq!(lines.len(), 1);
+    assert_eq!(doubled(&lines[0]), Some(2.0));
+}
+
+#[test]
+fn msgpack_truncated_record_is_an_error() {
+    let record = rmp_serde::to_vec_named(&json!({ "base": 1 })).unwrap();
+    let mut input = (record.len() as u32 + 8).to_be_bytes().to_vec();
+    input.extend_from_slice(&record);
+
+    let output = run_batch("truncated", &input, &["--batch-format", "msgpack"]);
+    assert!(!output.status.success());
+    assert!(result_lines(&output).is_empty());
+}
+
+#[test]
+fn records_do_not_see_keys_from_earlier_records() {
+    let alone = run_batch("alone", b"{}\n", &["--threads", "1"]);
+    let after = run_batch("after", b"{\"base\": 5}\n{}\n", &["--threads", "1"]);
+    assert!(alone.status.success() && after.status.success());
+
+    let after = result_lines(&after);
+    assert_eq!(doubled(&after[0]), Some(10.0));
+    assert_eq!(after[1], result_lines(&alone)[0]);
+}
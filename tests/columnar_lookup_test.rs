@@ -0,0 +1,147 @@
+use indexmap::IndexMap;
+use json_eval_rs::rlogic::RLogic;
+use serde_json::{json, Value};
+use std::sync::Arc;
+
+/// Rate table large enough to get a columnar projection: age bands with
+/// numeric bounds, a dictionary-encoded gender column and numeric-looking strings.
+fn rate_rows() -> Value {
+    let rows: Vec<Value> = (0..60)
+        .map(|i| {
+            json!({
+                "MIN_AGE": i * 2,
+                "MAX_AGE": i * 2 + 1,
+                "GENDER": if i % 2 == 0 { "M" } else { "F" },
+                "CODE": format!("{}", 100 + i),
+                "RATE": i as f64 * 0.5,
+            })
+        })
+        .collect();
+    Value::Array(rows)
+}
+
+fn engine_with_rates() -> RLogic {
+    let mut engine = RLogic::new();
+    let mut arrays = IndexMap::new();
+    arrays.insert("/$params/rates".to_string(), Arc::new(rate_rows()));
+    engine.set_static_arrays(Arc::new(arrays));
+    engine
+}
+
+/// Columnar lookups over a static array must agree with the row scan over the
+/// same rows passed as plain data.
+#[test]
+fn test_columnar_lookups_match_row_scan() {
+    let engine = engine_with_rates();
+    let plain = json!({ "rates": rate_rows() });
+    let static_data = json!({});
+
+    let cases = [
+        (
+            json!({"MATCH": [{"var": "$params.rates"}, "F", "GENDER", 30, "MIN_AGE"]}),
+            json!(15),
+        ),
+        (
+            json!({"MATCH": [{"var": "$params.rates"}, 103, "CODE"]}),
+            json!(3),
+        ),
+        (
+            json!({"MATCH": [{"var": "$params.rates"}, "X", "GENDER"]}),
+            json!(-1),
+        ),
+        (
+            json!({"MATCHRANGE": [{"var": "$params.rates"}, "MIN_AGE", "MAX_AGE", 41]}),
+            json!(20),
+        ),
+        (
+            json!({"INDEXAT": ["44", {"var": "$params.rates"}, "MIN_AGE"]}),
+            json!(22),
+        ),
+        (
+            json!({"INDEXAT": [10, {"var": "$params.rates"}, "MIN_AGE", true]}),
+            json!(0),
+        ),
+        (
+            json!({"CHOOSE": [{"var": "$params.rates"}, "Z", "GENDER", "105", "CODE"]}),
+            json!(5),
+        ),
+        (
+            json!({"VALUEAT": [
+                {"var": "$params.rates"},
+                {"MATCHRANGE": [{"var": "$params.rates"}, "MIN_AGE", "MAX_AGE", 41]},
+                "RATE"
+            ]}),
+            json!(10.0),
+        ),
+    ];
+
+    for (logic, expected) in cases {
+        let static_result = engine.evaluate(&logic, &static_data).unwrap();
+        let plain_logic: Value =
+            serde_json::from_str(&logic.to_string().replace("$params.rates", "rates")).unwrap();
+        let plain_result = engine.evaluate(&plain_logic, &plain).unwrap();
+        assert_eq!(
+            static_result.as_f64(),
+            expected.as_f64(),
+            "columnar result for {}",
+            logic
+        );
+        assert_eq!(
+            plain_result.as_f64(),
+            expected.as_f64(),
+            "row scan result for {}",
+            logic
+        );
+    }
+}
+
+/// Multi-condition lookups whose only hit lies past the first 64-row mask
+/// block must AND the per-condition masks correctly, including the tail block.
+#[test]
+fn test_columnar_masks_span_blocks() {
+    let rows: Vec<Value> = (0..200)
+        .map(|i| {
+            json!({
+                "A": i % 10,
+                "B": i % 7,
+                "HALF": if i >= 100 { "hi" } else { "lo" },
+                "UPPER": if i >= 100 { 1 } else { 0 },
+                "BAND_LO": i * 5,
+                "BAND_HI": i * 5 + 4,
+            })
+        })
+        .collect();
+    let mut engine = RLogic::new();
+    let mut arrays = IndexMap::new();
+    arrays.insert("/$params/grid".to_string(), Arc::new(Value::Array(rows)));
+    engine.set_static_arrays(Arc::new(arrays));
+    let data = json!({});
+
+    let cases = [
+        (
+            json!({"MATCH": [{"var": "$params.grid"}, 3, "A", 5, "B", "hi", "HALF"]}),
+            json!(103),
+        ),
+        (
+            json!({"MATCH": [{"var": "$params.grid"}, 3, "A", 5, "B", "lo", "HALF"]}),
+            json!(33),
+        ),
+        (
+            json!({"MATCHRANGE": [{"var": "$params.grid"}, "BAND_LO", "BAND_HI", 987, "A", "A", 7]}),
+            json!(197),
+        ),
+        (
+            json!({"MATCHRANGE": [{"var": "$params.grid"}, "BAND_LO", "BAND_HI", 987, "A", "A", 6]}),
+            json!(-1),
+        ),
+        (
+            json!({"FINDINDEX": [{"var": "$params.grid"}, {"==": [{"var": "A"}, 4]}, {"==": [{"var": "B"}, 6]}, {"==": [{"var": "UPPER"}, 1]}]}),
+            json!(104),
+        ),
+    ];
+
+    for (logic, expected) in cases {
+        let result = engine.evaluate(&logic, &data).unwrap();
+        assert_eq!(result.as_f64(), expected.as_f64(), "result for {}", logic);
+    }
+}
@@ -21,3 +21,26 @@ fn replace_data_ignores_non_object_root_without_panicking() {
     assert!(result.is_ok(), "array root must not panic");
     assert_eq!(data.get("existing"), Some(&json!(true)));
 }
+
+#[test]
+fn replace_data_leaves_shared_snapshot_untouched() {
+    let mut data = EvalData::new(json!({
+        "$params": {"rate": 2},
+        "user": {"name": "John"},
+        "$context": {"role": "agent"}
+    }));
+    let snapshot = data.snapshot_data();
+
+    data.replace_data_and_context(json!({"user": {"name": "Jane"}, "extra": 1}), json!({}));
+
+    assert_eq!(
+        *snapshot,
+        json!({"$params": {"rate": 2}, "user": {"name": "John"}, "$context": {"role": "agent"}})
+    );
+    assert_eq!(
+        data.data(),
+        &json!({"$params": {"rate": 2}, "user": {"name": "Jane"}, "$context": {}, "extra": 1})
+    );
+    let keys: Vec<&String> = data.data().as_object().unwrap().keys().collect();
+    assert_eq!(keys, ["$params", "user", "$context", "extra"]);
+}
@@ -0,0 +1,90 @@
+use json_eval_rs::JSONEval;
+use serde_json::json;
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "name": {
+                "type": "string",
+                "rules": {
+                    "required": { "value": true, "message": "Name is required" }
+                }
+            },
+            "limit": { "type": "number" },
+            "score": {
+                "type": "number",
+                "rules": {
+                    "underLimit": {
+                        "value": {
+                            "$evaluation": {
+                                "<=": [{ "$ref": "#/score" }, { "$ref": "#/limit" }]
+                            }
+                        },
+                        "message": "Score exceeds the limit",
+                        "code": "score.over_limit"
+                    }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+/// A rule whose formula reads another field must be re-checked when only that
+/// field changes, even though the validated field's own value did not.
+#[test]
+fn test_cached_outcome_follows_rule_dependencies() {
+    let mut eval = JSONEval::new(&schema(), None, None).unwrap();
+
+    let over = json!({ "name": "a", "limit": 10, "score": 20 }).to_string();
+    eval.evaluate(&over, None, None, None).unwrap();
+    let result = eval.validate(&over, None, None, None).unwrap();
+    assert!(result.errors.contains_key("score"));
+
+    // Same payload again: served from the cache, same answer
+    let again = eval.validate(&over, None, None, None).unwrap();
+    assert_eq!(again, result);
+
+    let raised = json!({ "name": "a", "limit": 30, "score": 20 }).to_string();
+    eval.evaluate(&raised, None, None, None).unwrap();
+    let result = eval.validate(&raised, None, None, None).unwrap();
+    assert!(!result.has_error, "{:?}", result.errors);
+}
+
+#[test]
+fn test_validate_delta_reports_changes_only() {
+    let mut eval = JSONEval::new(&schema(), None, None).unwrap();
+
+    let data = json!({ "name": "", "limit": 10, "score": 20 }).to_string();
+    eval.evaluate(&data, None, None, None).unwrap();
+    let delta = eval.validate_delta(&data, None, None, None).unwrap();
+    assert!(delta.has_error);
+    assert_eq!(
+        delta.changed.keys().collect::<Vec<_>>(),
+        vec!["name", "score"]
+    );
+    assert!(delta.cleared.is_empty());
+
+    // Nothing changed since the previous validation
+    let delta = eval.validate_delta(&data, None, None, None).unwrap();
+    assert!(delta.has_error);
+    assert!(delta.changed.is_empty());
+    assert!(delta.cleared.is_empty());
+
+    // Fixing the name clears its error and leaves the score error unreported
+    let data = json!({ "name": "a", "limit": 10, "score": 20 }).to_string();
+    eval.evaluate(&data, None, None, None).unwrap();
+    let delta = eval.validate_delta(&data, None, None, None).unwrap();
+    assert!(delta.has_error);
+    assert!(delta.changed.is_empty());
+    assert_eq!(delta.cleared, vec!["name".to_string()]);
+
+    // validate() and validate_delta() share the previous state
+    let data = json!({ "name": "a", "limit": 10, "score": 5 }).to_string();
+    eval.evaluate(&data, None, None, None).unwrap();
+    assert!(!eval.validate(&data, None, None, None).unwrap().has_error);
+    let delta = eval.validate_delta(&data, None, None, None).unwrap();
+    assert!(!delta.has_error);
+    assert!(delta.changed.is_empty() && delta.cleared.is_empty());
+}
@@ -1,5 +1,7 @@
+use indexmap::IndexMap;
 use json_eval_rs::rlogic::RLogic;
-use serde_json::json;
+use serde_json::{json, Value};
+use std::sync::Arc;
 
 #[test]
 fn test_match_with_index() {
@@ -105,3 +107,87 @@ fn test_index_performance_proxy() {
     let result = rlogic.evaluate(&logic, &data).unwrap();
     assert_eq!(result, json!((target_id)));
 }
+
+#[test]
+fn test_range_index_matches_row_scan() {
+    // Overlapping, descending-ordered bands with a gap, an empty band and a
+    // missing max cell, so the first containing row is not the sorted one
+    let rows: Vec<Value> = (0..300)
+        .map(|i| match i {
+            7 => json!({"LO": 50, "HI": 40, "AGE": 999}),
+            11 => json!({"LO": 0, "AGE": 0}),
+            _ => {
+                let lo = (300 - i) * 3;
+                json!({"LO": lo, "HI": lo + 10 + (i % 4) * 5, "AGE": lo})
+            }
+        })
+        .collect();
+
+    let mut rlogic = RLogic::new();
+    let mut arrays = IndexMap::new();
+    arrays.insert(
+        "/$params/bands".to_string(),
+        Arc::new(Value::Array(rows.clone())),
+    );
+    rlogic.set_static_arrays(Arc::new(arrays));
+    let static_data = json!({});
+    let plain_data = json!({ "bands": rows });
+
+    for check in [-5, 0, 3, 44, 45, 46, 150, 451, 899, 903, 925, 2000] {
+        let matchrange = json!({"MATCHRANGE": [{"var": "$params.bands"}, "LO", "HI", check]});
+        let indexat = json!({"INDEXAT": [check, {"var": "$params.bands"}, "AGE", true]});
+        for logic in [matchrange, indexat] {
+            let indexed = rlogic.evaluate(&logic, &static_data).unwrap();
+            let plain_logic: Value =
+                serde_json::from_str(&logic.to_string().replace("$params.bands", "bands")).unwrap();
+            let scanned = rlogic.evaluate(&plain_logic, &plain_data).unwrap();
+            assert_eq!(indexed.as_f64(), scanned.as_f64(), "mismatch for {}", logic);
+        }
+    }
+}
+
+#[test]
+fn test_typed_index_keys_follow_loose_equality() {
+    let data = json!({
+        "mixed": [
+            {"code": "1.0", "flag": true},
+            {"code": 1, "flag": 1},
+            {"code": "1", "flag": "0"},
+            {"code": true, "flag": null},
+            {"code": -0.0, "flag": false},
+            {"code": "abc", "flag": "1"},
+            {"code": null, "flag": 0}
+        ]
+    });
+    let indexed = RLogic::new();
+    indexed.index_table("mixed", &data["mixed"]);
+    let scanned = RLogic::new();
+
+    let lookups = [
+        json!(1),
+        json!(1.0),
+        json!("1"),
+        json!("1.0"),
+        json!(true),
+        json!(false),
+        json!(0),
+        json!(""),
+        json!("abc"),
+        json!(null),
+        json!(7),
+    ];
+    for lookup in lookups {
+        for column in ["code", "flag"] {
+            let indexat = json!({"INDEXAT": [lookup, {"var": "mixed"}, column]});
+            let matched = json!({"MATCH": [{"var": "mixed"}, lookup, column, 1, "code"]});
+            for logic in [indexat, matched] {
+                assert_eq!(
+                    indexed.evaluate(&logic, &data).unwrap(),
+                    scanned.evaluate(&logic, &data).unwrap(),
+                    "index disagrees with row scan for {}",
+                    logic
+                );
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+use json_eval_rs::{JSONEval, ParsedSchema, JSON_EVAL_POOL, PARSED_SCHEMA_CACHE};
+use serde_json::{json, Value};
+use std::sync::Arc;
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "base": { "type": "number" },
+            "doubled": {
+                "type": "number",
+                "value": { "$evaluation": { "*": [{ "$ref": "#/properties/base" }, 2] } }
+            },
+            "note": {
+                "type": "string",
+                "condition": {
+                    "hidden": { "$evaluation": { ">": [{ "$ref": "#/properties/base" }, 5] } }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn evaluated(eval: &mut JSONEval, data: &str) -> Value {
+    eval.evaluate(data, None, None, None).unwrap();
+    eval.get_evaluated_schema()
+}
+
+#[test]
+fn reset_matches_fresh_instance() {
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    let fresh = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap();
+
+    let mut eval = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, None).unwrap();
+    evaluated(&mut eval, r#"{"base":9}"#);
+    eval.reset(None, None).unwrap();
+    assert_eq!(eval.evaluated_schema, fresh.evaluated_schema);
+    assert_eq!(eval.data, fresh.data);
+
+    let data = r#"{"base":2}"#;
+    let mut fresh = JSONEval::with_parsed_schema(Arc::clone(&parsed), None, Some(data)).unwrap();
+    eval.reset(Some(data), None).unwrap();
+    assert_eq!(evaluated(&mut eval, data), evaluated(&mut fresh, data));
+}
+
+#[test]
+fn pool_reuses_released_instances() {
+    let key = "instance-pool-test";
+    PARSED_SCHEMA_CACHE.insert(
+        key.to_string(),
+        Arc::new(ParsedSchema::parse(&schema()).unwrap()),
+    );
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 0);
+
+    let mut eval = JSON_EVAL_POOL.acquire(key, None, None).unwrap();
+    evaluated(&mut eval, r#"{"base":9}"#);
+    JSON_EVAL_POOL.release(key, eval);
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 1);
+
+    let data = r#"{"base":3}"#;
+    let mut pooled = JSON_EVAL_POOL.acquire(key, None, Some(data)).unwrap();
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 0);
+    let mut fresh =
+        JSONEval::with_parsed_schema(PARSED_SCHEMA_CACHE.get(key).unwrap(), None, Some(data))
+            .unwrap();
+    assert_eq!(evaluated(&mut pooled, data), evaluated(&mut fresh, data));
+
+    // A different schema under the same key retires pooled instances
+    JSON_EVAL_POOL.release(key, pooled);
+    PARSED_SCHEMA_CACHE.insert(
+        key.to_string(),
+        Arc::new(ParsedSchema::parse(&schema()).unwrap()),
+    );
+    let next = JSON_EVAL_POOL.acquire(key, None, None).unwrap();
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 0);
+    JSON_EVAL_POOL.release(key, fresh);
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 0);
+    JSON_EVAL_POOL.release(key, next);
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 1);
+}
+
+#[test]
+fn pool_drops_instances_of_removed_schemas() {
+    let key = "instance-pool-removed-test";
+    let parsed = Arc::new(ParsedSchema::parse(&schema()).unwrap());
+    PARSED_SCHEMA_CACHE.insert(key.to_string(), Arc::clone(&parsed));
+    let eval = JSON_EVAL_POOL.acquire(key, None, None).unwrap();
+    JSON_EVAL_POOL.release(key, eval);
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 1);
+
+    // Removing the key releases the pooled instance and its schema with it
+    PARSED_SCHEMA_CACHE.remove(key);
+    assert_eq!(JSON_EVAL_POOL.idle_count(key), 0);
+    assert_eq!(Arc::strong_count(&parsed), 1);
+    assert!(JSON_EVAL_POOL.acquire(key, None, None).is_err());
+}
@@ -0,0 +1,96 @@
+use json_eval_rs::jsoneval::JSONEval;
+use serde_json::{json, Value};
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "toggle": { "type": "boolean" },
+            "note": { "type": "string" },
+            "section": {
+                "type": "object",
+                "condition": {
+                    "hidden": { "$evaluation": { "$ref": "#/properties/toggle" } }
+                },
+                "$layout": {
+                    "elements": [
+                        {
+                            "type": "VerticalLayout",
+                            "elements": [{ "$ref": "#/properties/target" }]
+                        }
+                    ]
+                }
+            },
+            "target": { "type": "string" },
+            "summary": {
+                "type": "object",
+                "$layout": {
+                    "elements": [{ "$ref": "#/properties/note" }]
+                }
+            }
+        },
+        "$layout": {
+            "elements": [{ "$ref": "#/properties/section" }]
+        }
+    })
+    .to_string()
+}
+
+fn layout(eval: &mut JSONEval) -> Value {
+    serde_json::to_value(eval.resolve_layout(false).unwrap()).unwrap()
+}
+
+fn fresh_layout(data: &str) -> Value {
+    let mut eval = JSONEval::new(&schema(), None, Some(data)).unwrap();
+    eval.evaluate(data, None, None, None).unwrap();
+    layout(&mut eval)
+}
+
+#[test]
+fn dependencies_cover_root_layouts_only() {
+    let eval = JSONEval::new(&schema(), None, None).unwrap();
+    let deps = &eval.layout_dependencies;
+
+    // The section layout is attached under the root layout, so it is not a root
+    assert_eq!(deps.len(), 2);
+    assert_eq!(
+        deps.get("#/$layout/elements").unwrap(),
+        &vec![
+            "/properties/section".to_string(),
+            "/properties/target".to_string()
+        ]
+    );
+    assert_eq!(
+        deps.get("#/properties/summary/$layout/elements").unwrap(),
+        &vec!["/properties/note".to_string()]
+    );
+}
+
+#[test]
+fn incremental_layout_matches_fresh_resolve() {
+    let shown = r#"{"toggle":false,"target":"a"}"#;
+    let hidden = r#"{"toggle":true,"target":"a"}"#;
+    let mut eval = JSONEval::new(&schema(), None, Some(shown)).unwrap();
+
+    eval.evaluate(shown, None, None, None).unwrap();
+    assert_eq!(layout(&mut eval), fresh_layout(shown));
+
+    eval.evaluate(hidden, None, None, None).unwrap();
+    let resolved = layout(&mut eval);
+    assert_eq!(resolved, fresh_layout(hidden));
+    assert!(resolved.as_array().unwrap().iter().any(|entry| {
+        entry.pointer("/overlay/$path") == Some(&json!("target"))
+            && entry.pointer("/overlay/condition/hidden") == Some(&json!(true))
+    }));
+
+    eval.evaluate(shown, None, None, None).unwrap();
+    assert_eq!(layout(&mut eval), fresh_layout(shown));
+}
+
+#[test]
+fn resolve_layout_with_evaluate_uses_current_data() {
+    let data = r#"{"toggle":true,"target":"a"}"#;
+    let mut eval = JSONEval::new(&schema(), None, Some(data)).unwrap();
+    let resolved = serde_json::to_value(eval.resolve_layout(true).unwrap()).unwrap();
+    assert_eq!(resolved, fresh_layout(data));
+}
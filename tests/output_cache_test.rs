@@ -0,0 +1,123 @@
+use json_eval_rs::jsoneval::output_cache::OutputKind;
+use json_eval_rs::JSONEval;
+use serde_json::{json, Value};
+use std::sync::Arc;
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "base": { "type": "number" },
+            "doubled": {
+                "type": "number",
+                "value": { "$evaluation": { "*": [{ "$ref": "#/properties/base" }, 2] } }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn doubled(bytes: &[u8]) -> Option<f64> {
+    serde_json::from_slice::<Value>(bytes)
+        .unwrap()
+        .pointer("/properties/doubled/value")
+        .and_then(Value::as_f64)
+}
+
+#[test]
+fn outputs_are_shared_until_state_changes() {
+    let mut eval = JSONEval::new(&schema(), None, None).unwrap();
+    eval.evaluate(&json!({ "base": 2 }).to_string(), None, None, None)
+        .unwrap();
+
+    let generation = eval.output_generation();
+    let first = eval.get_output_bytes(OutputKind::EvaluatedSchema).unwrap();
+    let second = eval.get_output_bytes(OutputKind::EvaluatedSchema).unwrap();
+    assert!(Arc::ptr_eq(&first, &second));
+    assert_eq!(eval.output_generation(), generation);
+    assert_eq!(
+        &*first,
+        serde_json::to_vec(&eval.get_evaluated_schema())
+            .unwrap()
+            .as_slice()
+    );
+    assert_eq!(doubled(&first), Some(4.0));
+
+    // Each getter caches separately, and reading never moves the generation
+    let values = eval.get_output_bytes(OutputKind::SchemaValue).unwrap();
+    assert_eq!(
+        serde_json::from_slice::<Value>(&values).unwrap(),
+        eval.get_schema_value()
+    );
+    assert_eq!(eval.output_generation(), generation);
+
+    eval.evaluate(&json!({ "base": 5 }).to_string(), None, None, None)
+        .unwrap();
+    assert_ne!(eval.output_generation(), generation);
+    let third = eval.get_output_bytes(OutputKind::EvaluatedSchema).unwrap();
+    assert!(!Arc::ptr_eq(&first, &third));
+    assert_eq!(doubled(&third), Some(10.0));
+}
+
+#[test]
+fn msgpack_output_matches_getter() {
+    let mut eval = JSONEval::new(&schema(), None, None).unwrap();
+    eval.evaluate(&json!({ "base": 3 }).to_string(), None, None, None)
+        .unwrap();
+
+    let cached = eval
+        .get_output_bytes(OutputKind::EvaluatedSchemaMsgpack)
+        .unwrap();
+    assert_eq!(
+        &*cached,
+        eval.get_evaluated_schema_msgpack().unwrap().as_slice()
+    );
+}
+
+fn riders_schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "riders": {
+                "type": "array",
+                "items": {
+                    "type": "object",
+                    "properties": { "sa": { "type": "number" } }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn rider_sa(bytes: &[u8], idx: usize) -> Option<f64> {
+    serde_json::from_slice::<Value>(bytes)
+        .unwrap()
+        .pointer(&format!("/riders/{}/sa", idx))
+        .and_then(Value::as_f64)
+}
+
+#[test]
+fn subform_payload_writes_invalidate_parent_outputs() {
+    let mut eval = JSONEval::new(&riders_schema(), None, None).unwrap();
+    let payload = |sa: i64| json!({ "riders": [{ "sa": 1 }, { "sa": sa }] }).to_string();
+    eval.evaluate(&payload(2), None, None, None).unwrap();
+    let before = eval.get_output_bytes(OutputKind::SchemaValue).unwrap();
+    assert_eq!(rider_sa(&before, 1), Some(2.0));
+
+    // An indexed evaluate_subform with the full payload writes the parent data
+    eval.evaluate_subform("riders.1", &payload(5), None, None, None)
+        .unwrap();
+    let after = eval.get_output_bytes(OutputKind::SchemaValue).unwrap();
+    assert_eq!(rider_sa(&after, 1), Some(5.0));
+    assert_eq!(
+        serde_json::from_slice::<Value>(&after).unwrap(),
+        eval.get_schema_value()
+    );
+
+    // So does evaluating every item at once
+    eval.evaluate_subform_items("riders", &payload(7), None, None)
+        .unwrap();
+    let items = eval.get_output_bytes(OutputKind::SchemaValue).unwrap();
+    assert_eq!(rider_sa(&items, 1), Some(7.0));
+}
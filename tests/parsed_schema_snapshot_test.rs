@@ -0,0 +1,133 @@
+use json_eval_rs::jsoneval::parsed_schema::ParsedSchema;
+use json_eval_rs::JSONEval;
+use serde_json::{json, Value};
+use std::sync::Arc;
+
+fn form_schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "code": {
+                "type": "string",
+                "rules": {
+                    "pattern": { "value": "^[A-Z]+$", "message": "Upper case only" }
+                }
+            },
+            "base": { "type": "number" },
+            "doubled": {
+                "type": "number",
+                "value": { "$evaluation": { "*": [{ "$ref": "#/properties/base" }, 2] } }
+            },
+            "total": {
+                "type": "number",
+                "value": { "$evaluation": { "+": [{ "$ref": "#/properties/doubled" }, 1] } }
+            }
+        }
+    })
+    .to_string()
+}
+
+/// Subform reading an extracted static array of the root schema
+fn rider_schema() -> String {
+    json!({
+        "$params": { "rates": [10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110] },
+        "riders": {
+            "type": "array",
+            "items": {
+                "properties": {
+                    "rate_index": { "type": "number" },
+                    "first_prem": {
+                        "type": "number",
+                        "value": {
+                            "$evaluation": {
+                                "VALUEAT": [
+                                    { "$ref": "#/$params/rates" },
+                                    { "$ref": "#/riders/properties/rate_index" }
+                                ]
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn round_trip(schema: &str) -> (Arc<ParsedSchema>, Arc<ParsedSchema>) {
+    let parsed = ParsedSchema::parse(schema).unwrap();
+    let snapshot = parsed.to_snapshot().unwrap();
+    let restored = ParsedSchema::from_snapshot(&snapshot).unwrap();
+
+    assert_eq!(*restored.evaluations, *parsed.evaluations);
+    assert_eq!(*restored.sorted_evaluations, *parsed.sorted_evaluations);
+    assert_eq!(
+        restored.subforms.keys().collect::<Vec<_>>(),
+        parsed.subforms.keys().collect::<Vec<_>>()
+    );
+    // Writing the restored schema again gives identical bytes
+    assert_eq!(restored.to_snapshot().unwrap(), snapshot);
+
+    (Arc::new(parsed), Arc::new(restored))
+}
+
+#[test]
+fn snapshot_evaluates_and_validates_like_parsed_schema() {
+    let (parsed, restored) = round_trip(&form_schema());
+
+    let run = |schema: &Arc<ParsedSchema>, data: &str| {
+        let mut eval = JSONEval::with_parsed_schema(schema.clone(), None, Some(data)).unwrap();
+        eval.evaluate(data, None, None, None).unwrap();
+        let validation = eval.validate(data, None, None, None).unwrap();
+        (eval.get_evaluated_schema(), validation)
+    };
+
+    for data in [
+        json!({ "code": "ABC", "base": 4 }),
+        json!({ "code": "abc", "base": 7 }),
+    ] {
+        let data = data.to_string();
+        assert_eq!(run(&restored, &data), run(&parsed, &data));
+    }
+
+    let (evaluated, validation) = run(&restored, &json!({ "code": "abc", "base": 4 }).to_string());
+    assert_eq!(
+        evaluated
+            .pointer("/properties/total/value")
+            .and_then(Value::as_f64),
+        Some(9.0)
+    );
+    assert!(validation.errors.contains_key("code"));
+}
+
+#[test]
+fn snapshot_subform_resolves_root_static_array() {
+    let (parsed, restored) = round_trip(&rider_schema());
+    let data = json!({ "riders": [{ "rate_index": 3 }] }).to_string();
+
+    let run = |schema: &Arc<ParsedSchema>| {
+        let mut eval = JSONEval::with_parsed_schema(schema.clone(), None, Some(&data)).unwrap();
+        eval.evaluate_subform("riders.0", &data, None, None, None)
+            .unwrap();
+        eval.get_evaluated_schema_subform("riders.0")
+    };
+
+    let rider = run(&restored);
+    assert_eq!(rider, run(&parsed));
+    assert_eq!(
+        rider
+            .pointer("/riders/properties/first_prem/value")
+            .and_then(Value::as_i64),
+        Some(40)
+    );
+}
+
+#[test]
+fn snapshot_rejects_corrupt_input() {
+    let snapshot = ParsedSchema::parse(&form_schema())
+        .unwrap()
+        .to_snapshot()
+        .unwrap();
+    assert!(ParsedSchema::from_snapshot(&snapshot[..snapshot.len() / 2]).is_err());
+    assert!(ParsedSchema::from_snapshot(&snapshot[..4]).is_err());
+}
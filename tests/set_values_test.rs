@@ -0,0 +1,162 @@
+use json_eval_rs::JSONEval;
+use serde_json::{json, Value};
+
+fn schema() -> String {
+    json!({
+        "type": "object",
+        "properties": {
+            "qty": { "type": "number" },
+            "price": { "type": "number" },
+            "total": {
+                "type": "number",
+                "value": {
+                    "$evaluation": {
+                        "*": [{ "$ref": "#/properties/qty" }, { "$ref": "#/properties/price" }]
+                    }
+                }
+            },
+            "note": {
+                "type": "string",
+                "condition": {
+                    "hidden": {
+                        "$evaluation": { "<": [{ "$ref": "#/properties/qty" }, 10] }
+                    }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn evaluated(data: &Value) -> Value {
+    let data = data.to_string();
+    let mut eval = JSONEval::new(&schema(), None, Some(&data)).unwrap();
+    eval.evaluate(&data, None, None, None).unwrap();
+    eval.get_evaluated_schema()
+}
+
+/// Patching fields must produce the same evaluated schema as a full
+/// `evaluate()` with the patched data.
+#[test]
+fn test_set_values_matches_full_evaluate() {
+    let initial = json!({ "qty": 2, "price": 5 });
+    let mut eval = JSONEval::new(&schema(), None, Some(&initial.to_string())).unwrap();
+    eval.evaluate(&initial.to_string(), None, None, None)
+        .unwrap();
+
+    eval.set_values(vec![("qty".to_string(), json!(12))], None)
+        .unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        evaluated(&json!({ "qty": 12, "price": 5 }))
+    );
+
+    eval.set_values_json(r#"[["/price", 3], ["qty", 4]]"#, None)
+        .unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        evaluated(&json!({ "qty": 4, "price": 3 }))
+    );
+
+    let patches = rmp_serde::to_vec(&json!({ "price": 10 })).unwrap();
+    eval.set_values_msgpack(&patches, None).unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        evaluated(&json!({ "qty": 4, "price": 10 }))
+    );
+
+    // A later full evaluate diffs against the patched state
+    let data = json!({ "qty": 20, "price": 10 }).to_string();
+    eval.evaluate(&data, None, None, None).unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        evaluated(&json!({ "qty": 20, "price": 10 }))
+    );
+}
+
+#[test]
+fn test_set_values_unchanged_and_invalid_patches() {
+    let initial = json!({ "qty": 2, "price": 5 });
+    let mut eval = JSONEval::new(&schema(), None, Some(&initial.to_string())).unwrap();
+    eval.evaluate(&initial.to_string(), None, None, None)
+        .unwrap();
+    let before = eval.get_evaluated_schema();
+
+    eval.set_values(vec![("/qty".to_string(), json!(2))], None)
+        .unwrap();
+    assert_eq!(eval.get_evaluated_schema(), before);
+
+    assert!(eval
+        .set_values(vec![("$params.rate".to_string(), json!(1))], None)
+        .is_err());
+    assert!(eval.set_values_json(r#"[["qty"]]"#, None).is_err());
+    assert!(eval.set_values_json("42", None).is_err());
+}
+
+/// Patches only re-run the formulas downstream of the changed field; chained
+/// formulas must still pick up results computed earlier in the same pass.
+#[test]
+fn test_set_values_chained_formulas_match_full_evaluate() {
+    let schema = json!({
+        "type": "object",
+        "properties": {
+            "qty": { "type": "number" },
+            "price": { "type": "number" },
+            "discount": { "type": "number" },
+            "subtotal": {
+                "type": "number",
+                "value": {
+                    "$evaluation": {
+                        "*": [{ "$ref": "#/properties/qty" }, { "$ref": "#/properties/price" }]
+                    }
+                }
+            },
+            "total": {
+                "type": "number",
+                "value": {
+                    "$evaluation": {
+                        "-": [{ "$ref": "#/properties/subtotal" }, { "$ref": "#/properties/discount" }]
+                    }
+                }
+            },
+            "label": {
+                "type": "string",
+                "value": { "$evaluation": { "cat": ["Total: ", { "$ref": "#/properties/total" }] } }
+            }
+        }
+    })
+    .to_string();
+    let full = |data: Value| {
+        let data = data.to_string();
+        let mut eval = JSONEval::new(&schema, None, Some(&data)).unwrap();
+        eval.evaluate(&data, None, None, None).unwrap();
+        eval.get_evaluated_schema()
+    };
+
+    let initial = json!({ "qty": 2, "price": 5, "discount": 1 });
+    let mut eval = JSONEval::new(&schema, None, Some(&initial.to_string())).unwrap();
+    eval.evaluate(&initial.to_string(), None, None, None)
+        .unwrap();
+
+    eval.set_values(vec![("qty".to_string(), json!(3))], None)
+        .unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        full(json!({ "qty": 3, "price": 5, "discount": 1 }))
+    );
+
+    eval.set_values(vec![("discount".to_string(), json!(4))], None)
+        .unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        full(json!({ "qty": 3, "price": 5, "discount": 4 }))
+    );
+
+    // Same data again: nothing is dirty, results stay put
+    let data = json!({ "qty": 3, "price": 5, "discount": 4 }).to_string();
+    eval.evaluate(&data, None, None, None).unwrap();
+    assert_eq!(
+        eval.get_evaluated_schema(),
+        full(json!({ "qty": 3, "price": 5, "discount": 4 }))
+    );
+}
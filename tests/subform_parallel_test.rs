@@ -0,0 +1,161 @@
+use json_eval_rs::jsoneval::subform_parallel::with_subform_workers;
+use json_eval_rs::JSONEval;
+use serde_json::{json, Value};
+
+fn schema() -> String {
+    json!({
+        "$params": { "rate": 3 },
+        "riders": {
+            "type": "array",
+            "items": {
+                "properties": {
+                    "sa": { "type": "number" },
+                    "premium": {
+                        "type": "number",
+                        "value": {
+                            "$evaluation": {
+                                "*": [
+                                    { "$ref": "#/riders/properties/sa" },
+                                    { "$ref": "#/$params/rate" }
+                                ]
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn data(riders: usize, offset: i64) -> String {
+    let riders: Vec<Value> = (0..riders as i64)
+        .map(|i| json!({ "sa": i * 10 + offset }))
+        .collect();
+    json!({ "riders": riders }).to_string()
+}
+
+fn premium(eval: &mut JSONEval, idx: usize) -> Option<f64> {
+    eval.get_evaluated_schema_subform(&format!("riders.{}", idx))
+        .pointer("/riders/properties/premium/value")
+        .and_then(Value::as_f64)
+}
+
+#[test]
+fn parallel_items_match_serial_items() {
+    let riders = 12;
+    let mut serial = JSONEval::new(&schema(), None, None).unwrap();
+    let mut parallel = JSONEval::new(&schema(), None, None).unwrap();
+
+    for offset in [1, 2] {
+        let payload = data(riders, offset);
+        serial.evaluate(&payload, None, None, None).unwrap();
+        parallel.evaluate(&payload, None, None, None).unwrap();
+
+        for idx in 0..riders {
+            serial
+                .evaluate_subform(&format!("riders.{}", idx), &payload, None, None, None)
+                .unwrap();
+        }
+        parallel
+            .evaluate_subform_items("riders", &payload, None, None)
+            .unwrap();
+
+        for idx in 0..riders {
+            let expected = ((idx as i64 * 10 + offset) * 3) as f64;
+            assert_eq!(premium(&mut parallel, idx), Some(expected));
+            assert_eq!(premium(&mut parallel, idx), premium(&mut serial, idx));
+        }
+    }
+}
+
+#[test]
+fn unknown_subform_is_an_error() {
+    let mut eval = JSONEval::new(&schema(), None, None).unwrap();
+    assert!(eval
+        .evaluate_subform_items("missing", &data(2, 0), None, None)
+        .is_err());
+}
+
+/// Riders whose `$params` table and value depend on the item being evaluated
+fn params_schema() -> String {
+    json!({
+        "$params": {
+            "references": {
+                "RIDER_TABLE": {
+                    "$table": [
+                        { "$repeat": [1, 3, {
+                            "YEAR": { "$evaluation": { "var": "$iteration" } },
+                            "RATE": { "$evaluation": { "*": [
+                                { "$ref": "#/riders/properties/sa" },
+                                { "var": "$iteration" }
+                            ] } }
+                        }] }
+                    ]
+                }
+            },
+            "rider_double": { "$evaluation": { "*": [{ "$ref": "#/riders/properties/sa" }, 2] } }
+        },
+        "riders": {
+            "type": "array",
+            "items": {
+                "properties": {
+                    "sa": { "type": "number" },
+                    "year2": { "type": "number", "value": { "$evaluation": {
+                        "VALUEAT": [{ "$ref": "#/$params/references/RIDER_TABLE" }, 1, "RATE"]
+                    } } },
+                    "doubled": { "type": "number", "value": { "$evaluation": {
+                        "$ref": "#/$params/rider_double"
+                    } } }
+                }
+            }
+        }
+    })
+    .to_string()
+}
+
+fn params_values(eval: &mut JSONEval, idx: usize) -> Value {
+    let schema = eval.get_evaluated_schema_subform(&format!("riders.{}", idx));
+    json!([
+        schema.pointer("/riders/properties/year2/value"),
+        schema.pointer("/riders/properties/doubled/value"),
+    ])
+}
+
+#[test]
+fn forked_items_match_serial_items_for_params_tables() {
+    let rounds: [&[i64]; 5] = [
+        &[1, 2, 3, 4],
+        &[1, 5, 3, 4],
+        &[7, 5, 3, 4],
+        &[7, 5, 3, 4],
+        &[1, 2, 3, 4],
+    ];
+    let mut serial = JSONEval::new(&params_schema(), None, None).unwrap();
+    let mut parallel = JSONEval::new(&params_schema(), None, None).unwrap();
+
+    for sas in rounds {
+        let riders: Vec<Value> = sas.iter().map(|sa| json!({ "sa": sa })).collect();
+        let payload = json!({ "riders": riders }).to_string();
+        serial.evaluate(&payload, None, None, None).unwrap();
+        parallel.evaluate(&payload, None, None, None).unwrap();
+
+        for idx in 0..sas.len() {
+            serial
+                .evaluate_subform(&format!("riders.{}", idx), &payload, None, None, None)
+                .unwrap();
+        }
+        with_subform_workers(4, || {
+            parallel.evaluate_subform_items("riders", &payload, None, None)
+        })
+        .unwrap();
+
+        for (idx, sa) in sas.iter().enumerate() {
+            assert_eq!(params_values(&mut parallel, idx), json!([sa * 2, sa * 2]));
+            assert_eq!(
+                params_values(&mut parallel, idx),
+                params_values(&mut serial, idx)
+            );
+        }
+    }
+}
@@ -678,4 +678,95 @@ mod table_tests {
         // Let's see what it returns
         assert_eq!(result, json!([])); // Or whatever it actually returns!
     }
+
+    /// Evaluate `schema` with the parallel row pass limited to `workers` threads
+    /// and return the rows of the `rates` table
+    fn evaluate_rates(schema: &serde_json::Value, workers: usize) -> Vec<serde_json::Value> {
+        json_eval_rs::jsoneval::table_evaluate::with_table_workers(workers, || {
+            let mut eval = JSONEval::new(&schema.to_string(), None, None).unwrap();
+            eval.evaluate("{}", None, None, None).unwrap();
+            eval.get_evaluated_schema()
+                .pointer("/properties/rates")
+                .and_then(|v| v.as_array())
+                .cloned()
+                .expect("table rows")
+        })
+    }
+
+    #[test]
+    fn test_repeat_table_row_independent_large() {
+        // 600 row-independent rows — enough for the parallel row pass when more
+        // than one worker is allowed; results must match the sequential pass.
+        let schema = json!({
+            "type": "object",
+            "properties": {
+                "rates": {
+                    "type": "array",
+                    "$table": [
+                        {
+                            "$repeat": [
+                                1,
+                                600,
+                                {
+                                    "POL_YEAR": {"$evaluation": {"var": "$iteration"}},
+                                    "DOUBLE": {"$evaluation": {"*": [{"var": "$POL_YEAR"}, 2]}}
+                                }
+                            ]
+                        }
+                    ]
+                }
+            }
+        });
+
+        let parallel = evaluate_rates(&schema, 4);
+        let sequential = evaluate_rates(&schema, 1);
+        assert_eq!(parallel, sequential);
+
+        assert_eq!(parallel.len(), 600);
+        for (idx, row) in parallel.iter().enumerate() {
+            let year = (idx + 1) as f64;
+            assert_eq!(row["POL_YEAR"].as_f64(), Some(year));
+            assert_eq!(row["DOUBLE"].as_f64(), Some(year * 2.0));
+        }
+    }
+
+    #[test]
+    fn test_repeat_table_self_reference_stays_sequential() {
+        // PREV reads the previous row of its own table, so rows are not
+        // independent and must see the rows evaluated before them.
+        let schema = json!({
+            "type": "object",
+            "properties": {
+                "rates": {
+                    "type": "array",
+                    "$table": [
+                        {
+                            "$repeat": [
+                                1,
+                                600,
+                                {
+                                    "POL_YEAR": {"$evaluation": {"var": "$iteration"}},
+                                    "PREV": {"$evaluation": {"VALUEAT": [
+                                        {"$ref": "#/properties/rates"},
+                                        {"-": [{"var": "$iteration"}, 2]},
+                                        "POL_YEAR"
+                                    ]}}
+                                }
+                            ]
+                        }
+                    ]
+                }
+            }
+        });
+
+        let parallel = evaluate_rates(&schema, 4);
+        let sequential = evaluate_rates(&schema, 1);
+        assert_eq!(parallel, sequential);
+
+        assert_eq!(parallel.len(), 600);
+        assert_eq!(parallel[0]["PREV"], json!(null));
+        for (idx, row) in parallel.iter().enumerate().skip(1) {
+            assert_eq!(row["PREV"].as_f64(), Some(idx as f64));
+        }
+    }
 }
@@ -144,6 +144,27 @@ fn test_ffi_methods_parity() {
         );
         json_eval_free_result(result);
 
+        // 7c. json_eval_evaluate_subform_items
+        let items_path = CString::new("#/riders").unwrap();
+        let result = json_eval_evaluate_subform_items(
+            handle,
+            items_path.as_ptr(),
+            data_str.as_ptr(),
+            std::ptr::null(),
+        );
+        assert!(result.success, "Evaluate subform items should succeed");
+        json_eval_free_result(result);
+
+        let missing_path = CString::new("#/missing").unwrap();
+        let result = json_eval_evaluate_subform_items(
+            handle,
+            missing_path.as_ptr(),
+            data_str.as_ptr(),
+            std::ptr::null(),
+        );
+        assert!(!result.success, "Unknown subform should be an error");
+        json_eval_free_result(result);
+
         // 8. Cleanup
         json_eval_free(handle);
     }